@@ -0,0 +1,181 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "cpu_load.h"
+
+/* The idle hook is calibrated for one second before any other task is
+ * created. */
+#define mainCALIBRATION_TICKS     pdMS_TO_TICKS( 1000UL )
+
+/* The load generator task steps its duty cycle up by this many percent every
+ * mainLOAD_STEP_PERIOD, wrapping back to zero after 90%. */
+#define mainLOAD_STEP_PERCENT     30UL
+#define mainLOAD_STEP_PERIOD      pdMS_TO_TICKS( 15000UL )
+
+/* The worker task skips its optional work while the 1 second load average is
+ * above this level (in tenths of a percent). */
+#define mainSHED_LOAD_THRESHOLD   700UL
+
+/* The tasks to be created. */
+static void vStartupTask( void * pvParameters );
+static void vLoadGeneratorTask( void * pvParameters );
+static void vWorkerTask( void * pvParameters );
+static void vReporterTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    /* Only the start up task is created here.  The other tasks are created by
+     * the start up task once the idle hook has been calibrated, because
+     * calibration measures how fast the idle hook runs when there is nothing
+     * else to run.  The start up task is created at the highest priority so it
+     * is never delayed while creating the other tasks. */
+    xTaskCreate( vStartupTask, "Startup", 1000, NULL, configMAX_PRIORITIES - 1, NULL );
+
+    /* Start the scheduler to start the tasks executing. */
+    vTaskStartScheduler();
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vStartupTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    /* Block while the idle hook is calibrated. */
+    vCpuLoadCalibrate( mainCALIBRATION_TICKS );
+    vPrintStringAndNumber( "Idle hook iterations per tick:", ulCpuLoadGetIdleIterationsPerTick() );
+
+    /* Now the application tasks can be created. */
+    xTaskCreate( vLoadGeneratorTask, "Load", 1000, NULL, 1, NULL );
+    xTaskCreate( vWorkerTask, "Worker", 1000, NULL, 2, NULL );
+    xTaskCreate( vReporterTask, "Reporter", 1000, NULL, 3, NULL );
+
+    /* This task has nothing more to do. */
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void vLoadGeneratorTask( void * pvParameters )
+{
+    const TickType_t xCyclePeriod = pdMS_TO_TICKS( 100UL );
+    TickType_t xLastWakeTime, xBusyStart, xBusyTicks, xStepStart;
+    uint32_t ulDutyCyclePercent = 0;
+
+    ( void ) pvParameters;
+
+    xLastWakeTime = xTaskGetTickCount();
+    xStepStart = xLastWakeTime;
+
+    for( ; ; )
+    {
+        /* Periodically step the percentage of each cycle spent busy. */
+        if( ( xTaskGetTickCount() - xStepStart ) >= mainLOAD_STEP_PERIOD )
+        {
+            xStepStart = xTaskGetTickCount();
+            ulDutyCyclePercent += mainLOAD_STEP_PERCENT;
+
+            if( ulDutyCyclePercent > 90UL )
+            {
+                ulDutyCyclePercent = 0;
+            }
+
+            vPrintStringAndNumber( "Load generator duty cycle now (%):", ulDutyCyclePercent );
+        }
+
+        /* Burn CPU time for the busy part of the cycle... */
+        xBusyTicks = ( xCyclePeriod * ulDutyCyclePercent ) / 100UL;
+        xBusyStart = xTaskGetTickCount();
+
+        while( ( xTaskGetTickCount() - xBusyStart ) < xBusyTicks )
+        {
+        }
+
+        /* ...then leave the rest of the cycle to the idle task. */
+        vTaskDelayUntil( &xLastWakeTime, xCyclePeriod );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vWorkerTask( void * pvParameters )
+{
+    const TickType_t xDelay500ms = pdMS_TO_TICKS( 500UL );
+    uint32_t ulLoad;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        vTaskDelay( xDelay500ms );
+
+        /* Reading the load is cheap and does not disable interrupts, so it can
+         * be checked every time the task has work to do. */
+        ulLoad = ulCpuLoadGet( eCpuLoad1Second );
+
+        if( ulLoad > mainSHED_LOAD_THRESHOLD )
+        {
+            vPrintStringAndNumber( "Worker - load too high, shedding optional work. Load:", ulLoad );
+        }
+        else
+        {
+            vPrintStringAndNumber( "Worker - performing optional work. Load:", ulLoad );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vReporterTask( void * pvParameters )
+{
+    const TickType_t xDelay2s = pdMS_TO_TICKS( 2000UL );
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        vTaskDelay( xDelay2s );
+
+        /* The load values are in tenths of a percent. */
+        vPrintString( "-----------------------------------\r\n" );
+        vPrintStringAndNumber( "Load average  1s (0.1%):", ulCpuLoadGet( eCpuLoad1Second ) );
+        vPrintStringAndNumber( "Load average 10s (0.1%):", ulCpuLoadGet( eCpuLoad10Seconds ) );
+        vPrintStringAndNumber( "Load average 60s (0.1%):", ulCpuLoadGet( eCpuLoad60Seconds ) );
+        vPrintString( "-----------------------------------\r\n" );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Idle hook functions MUST be called vApplicationIdleHook(), take no parameters,
+ * and return void. */
+void vApplicationIdleHook( void )
+{
+    /* Unlike Example007, which only incremented a counter, the count is now
+     * kept by the CPU load estimator, which also turns it into load figures. */
+    vCpuLoadIdleHook();
+}
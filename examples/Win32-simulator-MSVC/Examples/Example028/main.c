@@ -0,0 +1,289 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/*
+ * Boot time benchmark.
+ *
+ * Creates mainNUM_TASKS tasks, mainNUM_QUEUES queues and mainNUM_TIMERS
+ * software timers before the scheduler is started, using the method selected by
+ * mainCREATION_METHOD, then reports how long creation took, the time from
+ * main() being entered to vTaskStartScheduler() being called, the time from
+ * main() being entered to the first task running, and how much of the FreeRTOS
+ * heap the objects consumed.  Build and run once for each creation method to
+ * compare them.
+ *
+ * Note that in the Windows port every task is implemented by a Windows thread,
+ * and creating a Windows thread is far slower than anything the kernel itself
+ * does when creating a task.  Absolute task creation times are therefore much
+ * higher than they would be on real hardware - compare the methods with each
+ * other, not with the figures for a microcontroller.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "bulk_create.h"
+
+/* The methods that can be used to create the objects.  mainCREATE_DYNAMIC
+ * creates each object with its own calls to pvPortMalloc().  mainCREATE_STATIC
+ * uses statically allocated arrays and so does not use the heap at all.
+ * mainCREATE_BULK obtains the memory for every object with a single call to
+ * pvPortMalloc(). */
+#define mainCREATE_DYNAMIC      0
+#define mainCREATE_STATIC       1
+#define mainCREATE_BULK         2
+
+/* Set to the creation method to benchmark. */
+#define mainCREATION_METHOD     mainCREATE_BULK
+
+/* The number of each object type to create. */
+#define mainNUM_TASKS           200
+#define mainNUM_QUEUES          100
+#define mainNUM_TIMERS          100
+
+/* Parameters of the created objects. */
+#define mainTASK_STACK_DEPTH    configMINIMAL_STACK_SIZE
+#define mainTASK_PRIORITY       1
+#define mainQUEUE_LENGTH        4
+#define mainQUEUE_ITEM_SIZE     sizeof( uint32_t )
+#define mainTIMER_PERIOD        pdMS_TO_TICKS( 1000UL )
+
+/* The tasks to be created.  vWorkerTask() is used by each of the mainNUM_TASKS
+ * benchmarked tasks.  vReportTask() is created last, at the highest priority,
+ * so it is the first task to run once the scheduler has started. */
+static void vWorkerTask( void * pvParameters );
+static void vReportTask( void * pvParameters );
+
+/* The callback used by the benchmarked timers.  The timers are never started. */
+static void prvTimerCallback( TimerHandle_t xTimer );
+
+/* Create the benchmarked objects using the method set by
+ * mainCREATION_METHOD. */
+static void prvCreateObjects( void );
+
+/*-----------------------------------------------------------*/
+
+/* Handles of the benchmarked objects. */
+static TaskHandle_t xTasks[ mainNUM_TASKS ];
+static QueueHandle_t xQueues[ mainNUM_QUEUES ];
+static TimerHandle_t xTimers[ mainNUM_TIMERS ];
+
+#if ( mainCREATION_METHOD == mainCREATE_STATIC )
+
+/* The memory for each object, allocated at compile time. */
+    static StaticTask_t xTaskBuffers[ mainNUM_TASKS ];
+    static StackType_t xTaskStacks[ mainNUM_TASKS ][ mainTASK_STACK_DEPTH ];
+    static StaticQueue_t xQueueBuffers[ mainNUM_QUEUES ];
+    static uint8_t ucQueueStorage[ mainNUM_QUEUES ][ mainQUEUE_LENGTH * mainQUEUE_ITEM_SIZE ];
+    static StaticTimer_t xTimerBuffers[ mainNUM_TIMERS ];
+
+#elif ( mainCREATION_METHOD == mainCREATE_BULK )
+
+/* The descriptions of each object passed to pvBulkCreate(). */
+    static BulkTaskParameters_t xTaskParameters[ mainNUM_TASKS ];
+    static BulkQueueParameters_t xQueueParameters[ mainNUM_QUEUES ];
+    static BulkTimerParameters_t xTimerParameters[ mainNUM_TIMERS ];
+
+#endif /* mainCREATION_METHOD */
+
+/* Time stamps, in nanoseconds, taken at each stage of the boot. */
+static uint64_t ullBootTime, ullCreationStartTime, ullCreationEndTime;
+static uint64_t ullSchedulerStartTime, ullFirstTaskTime;
+
+/* The free heap space before and after the objects were created. */
+static size_t xFreeHeapBeforeCreation, xFreeHeapAfterCreation;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    /* Everything is measured relative to this point. */
+    vBenchmarkTimerInit();
+    ullBootTime = ullBenchmarkTimerGetNanoseconds();
+
+    xFreeHeapBeforeCreation = xPortGetFreeHeapSize();
+    ullCreationStartTime = ullBenchmarkTimerGetNanoseconds();
+
+    prvCreateObjects();
+
+    ullCreationEndTime = ullBenchmarkTimerGetNanoseconds();
+    xFreeHeapAfterCreation = xPortGetFreeHeapSize();
+
+    /* Create the task that reports the results.  This is not part of the
+     * measurement. */
+    xTaskCreate( vReportTask, "Report", 1000, NULL, configMAX_PRIORITIES - 1, NULL );
+
+    /* Start the scheduler so the created tasks start executing. */
+    ullSchedulerStartTime = ullBenchmarkTimerGetNanoseconds();
+    vTaskStartScheduler();
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCreateObjects( void )
+{
+    BaseType_t x;
+
+    #if ( mainCREATION_METHOD == mainCREATE_DYNAMIC )
+    {
+        for( x = 0; x < mainNUM_TASKS; x++ )
+        {
+            xTaskCreate( vWorkerTask, "Worker", mainTASK_STACK_DEPTH, NULL, mainTASK_PRIORITY, &( xTasks[ x ] ) );
+            configASSERT( xTasks[ x ] != NULL );
+        }
+
+        for( x = 0; x < mainNUM_QUEUES; x++ )
+        {
+            xQueues[ x ] = xQueueCreate( mainQUEUE_LENGTH, mainQUEUE_ITEM_SIZE );
+            configASSERT( xQueues[ x ] != NULL );
+        }
+
+        for( x = 0; x < mainNUM_TIMERS; x++ )
+        {
+            xTimers[ x ] = xTimerCreate( "Timer", mainTIMER_PERIOD, pdTRUE, NULL, prvTimerCallback );
+            configASSERT( xTimers[ x ] != NULL );
+        }
+    }
+    #elif ( mainCREATION_METHOD == mainCREATE_STATIC )
+    {
+        for( x = 0; x < mainNUM_TASKS; x++ )
+        {
+            xTasks[ x ] = xTaskCreateStatic( vWorkerTask, "Worker", mainTASK_STACK_DEPTH, NULL, mainTASK_PRIORITY, xTaskStacks[ x ], &( xTaskBuffers[ x ] ) );
+        }
+
+        for( x = 0; x < mainNUM_QUEUES; x++ )
+        {
+            xQueues[ x ] = xQueueCreateStatic( mainQUEUE_LENGTH, mainQUEUE_ITEM_SIZE, ucQueueStorage[ x ], &( xQueueBuffers[ x ] ) );
+        }
+
+        for( x = 0; x < mainNUM_TIMERS; x++ )
+        {
+            xTimers[ x ] = xTimerCreateStatic( "Timer", mainTIMER_PERIOD, pdTRUE, NULL, prvTimerCallback, &( xTimerBuffers[ x ] ) );
+        }
+    }
+    #else /* mainCREATE_BULK */
+    {
+        BulkCreateSet_t xSet;
+        void * pvBlock;
+
+        /* Describe every object... */
+        for( x = 0; x < mainNUM_TASKS; x++ )
+        {
+            xTaskParameters[ x ].pxTaskCode = vWorkerTask;
+            xTaskParameters[ x ].pcName = "Worker";
+            xTaskParameters[ x ].ulStackDepth = mainTASK_STACK_DEPTH;
+            xTaskParameters[ x ].pvParameters = NULL;
+            xTaskParameters[ x ].uxPriority = mainTASK_PRIORITY;
+            xTaskParameters[ x ].pxCreatedTask = &( xTasks[ x ] );
+        }
+
+        for( x = 0; x < mainNUM_QUEUES; x++ )
+        {
+            xQueueParameters[ x ].uxQueueLength = mainQUEUE_LENGTH;
+            xQueueParameters[ x ].uxItemSize = mainQUEUE_ITEM_SIZE;
+            xQueueParameters[ x ].pxCreatedQueue = &( xQueues[ x ] );
+        }
+
+        for( x = 0; x < mainNUM_TIMERS; x++ )
+        {
+            xTimerParameters[ x ].pcTimerName = "Timer";
+            xTimerParameters[ x ].xTimerPeriodInTicks = mainTIMER_PERIOD;
+            xTimerParameters[ x ].xAutoReload = pdTRUE;
+            xTimerParameters[ x ].pvTimerID = NULL;
+            xTimerParameters[ x ].pxCallbackFunction = prvTimerCallback;
+            xTimerParameters[ x ].pxCreatedTimer = &( xTimers[ x ] );
+        }
+
+        xSet.pxTasks = xTaskParameters;
+        xSet.xNumTasks = mainNUM_TASKS;
+        xSet.pxQueues = xQueueParameters;
+        xSet.xNumQueues = mainNUM_QUEUES;
+        xSet.pxTimers = xTimerParameters;
+        xSet.xNumTimers = mainNUM_TIMERS;
+
+        /* ...then create them all from a single block of heap memory. */
+        pvBlock = pvBulkCreate( &xSet, NULL );
+        configASSERT( pvBlock != NULL );
+    }
+    #endif /* mainCREATION_METHOD */
+}
+/*-----------------------------------------------------------*/
+
+static void vReportTask( void * pvParameters )
+{
+    const uint32_t ulObjects = mainNUM_TASKS + mainNUM_QUEUES + mainNUM_TIMERS;
+    uint32_t ulHeapUsed;
+
+    ( void ) pvParameters;
+
+    /* This is the highest priority task, so the first to run. */
+    ullFirstTaskTime = ullBenchmarkTimerGetNanoseconds();
+
+    ulHeapUsed = ( uint32_t ) ( xFreeHeapBeforeCreation - xFreeHeapAfterCreation );
+
+    #if ( mainCREATION_METHOD == mainCREATE_DYNAMIC )
+        vPrintString( "Creation method: dynamic (one or more allocations per object)\r\n" );
+    #elif ( mainCREATION_METHOD == mainCREATE_STATIC )
+        vPrintString( "Creation method: static (no heap allocations)\r\n" );
+    #else
+        vPrintString( "Creation method: bulk (one allocation for all objects)\r\n" );
+    #endif
+
+    vPrintStringAndNumber( "Tasks created:", mainNUM_TASKS );
+    vPrintStringAndNumber( "Queues created:", mainNUM_QUEUES );
+    vPrintStringAndNumber( "Timers created:", mainNUM_TIMERS );
+    vPrintStringAndNumber( "Time to create all objects (us):", ( uint32_t ) ( ( ullCreationEndTime - ullCreationStartTime ) / 1000ULL ) );
+    vPrintStringAndNumber( "Average time per object (ns):", ( uint32_t ) ( ( ullCreationEndTime - ullCreationStartTime ) / ulObjects ) );
+    vPrintStringAndNumber( "Boot to vTaskStartScheduler() (us):", ( uint32_t ) ( ( ullSchedulerStartTime - ullBootTime ) / 1000ULL ) );
+    vPrintStringAndNumber( "Boot to first task running (us):", ( uint32_t ) ( ( ullFirstTaskTime - ullBootTime ) / 1000ULL ) );
+    vPrintStringAndNumber( "Heap used by the objects (bytes):", ulHeapUsed );
+    vPrintStringAndNumber( "Average heap used per object (bytes):", ulHeapUsed / ulObjects );
+
+    /* The results only need to be printed once. */
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void vWorkerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    /* The benchmarked tasks have no work to do, so just block. */
+    for( ; ; )
+    {
+        ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+    ( void ) xTimer;
+}
+/*-----------------------------------------------------------*/
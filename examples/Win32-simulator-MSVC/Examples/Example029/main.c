@@ -0,0 +1,143 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "cpu_budget.h"
+
+/* Each continuous processing task may use 20ms of CPU time in every 100ms. */
+#define mainBUDGET_US                20000UL
+#define mainREPLENISHMENT_PERIOD_US  100000UL
+
+/* Priorities of the tasks.  The continuous processing tasks run above the
+ * periodic task, so without budgets they would starve it completely.  The
+ * supervisor must be the highest priority task, so the reporter runs below it,
+ * but above the tasks whose progress it prints. */
+#define mainSUPERVISOR_PRIORITY      ( configMAX_PRIORITIES - 1 )
+#define mainREPORTER_PRIORITY        ( configMAX_PRIORITIES - 2 )
+#define mainCONTINUOUS_PRIORITY      3
+#define mainPERIODIC_PRIORITY        2
+#define mainDEMOTED_PRIORITY         1
+
+/* The task functions. */
+static void vContinuousProcessingTask( void * pvParameters );
+static void vPeriodicTask( void * pvParameters );
+static void vReporterTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+/* The budgets of the two continuous processing tasks.  One is demoted when it
+ * exhausts its budget, the other is suspended. */
+static CpuBudget_t xDemotedTaskBudget, xSuspendedTaskBudget;
+
+/* Incremented each time the periodic task runs. */
+static volatile uint32_t ulPeriodicTaskCycles = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    TaskHandle_t xTask1, xTask2;
+
+    /* Create two instances of the continuous processing task, as in
+     * Example006, but this time at a priority above the periodic task. */
+    xTaskCreate( vContinuousProcessingTask, "Task 1", 1000, NULL, mainCONTINUOUS_PRIORITY, &xTask1 );
+    xTaskCreate( vContinuousProcessingTask, "Task 2", 1000, NULL, mainCONTINUOUS_PRIORITY, &xTask2 );
+
+    /* Create the periodic task that the continuous processing tasks would
+     * otherwise starve. */
+    xTaskCreate( vPeriodicTask, "Periodic", 1000, NULL, mainPERIODIC_PRIORITY, NULL );
+
+    /* Create the task that periodically prints out the results. */
+    xTaskCreate( vReporterTask, "Reporter", 1000, NULL, mainREPORTER_PRIORITY, NULL );
+
+    /* Limit the CPU time available to each continuous processing task.  Task 1
+     * drops below the periodic task when it has used its budget, Task 2 stops
+     * running altogether until its budget is replenished. */
+    vCpuBudgetRegister( &xDemotedTaskBudget, xTask1, mainBUDGET_US, mainREPLENISHMENT_PERIOD_US, eCpuBudgetDemote, mainDEMOTED_PRIORITY );
+    vCpuBudgetRegister( &xSuspendedTaskBudget, xTask2, mainBUDGET_US, mainREPLENISHMENT_PERIOD_US, eCpuBudgetSuspend, 0 );
+    xCpuBudgetStart( mainSUPERVISOR_PRIORITY );
+
+    /* Start the scheduler to start the tasks executing. */
+    vTaskStartScheduler();
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vContinuousProcessingTask( void * pvParameters )
+{
+    volatile uint32_t ulCount = 0;
+
+    ( void ) pvParameters;
+
+    /* As per Example006, this task never blocks or delays.  It does not print
+     * out its name either, as printing would flood the console. */
+    for( ; ; )
+    {
+        ulCount++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vPeriodicTask( void * pvParameters )
+{
+    TickType_t xLastWakeTime;
+    const TickType_t xDelay10ms = pdMS_TO_TICKS( 10UL );
+
+    ( void ) pvParameters;
+
+    xLastWakeTime = xTaskGetTickCount();
+
+    for( ; ; )
+    {
+        /* Count how many times this task manages to run.  It should run 100
+         * times a second if it is not being starved. */
+        ulPeriodicTaskCycles++;
+        vTaskDelayUntil( &xLastWakeTime, xDelay10ms );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vReporterTask( void * pvParameters )
+{
+    const TickType_t xDelay1s = pdMS_TO_TICKS( 1000UL );
+    uint32_t ulLastCycles = 0, ulCycles;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        vTaskDelay( xDelay1s );
+
+        ulCycles = ulPeriodicTaskCycles;
+        vPrintStringAndNumber( "Periodic task cycles in the last second (expect 100):", ulCycles - ulLastCycles );
+        vPrintStringAndNumber( "Task 1 budget overruns (demoted):", ulCpuBudgetGetOverrunCount( &xDemotedTaskBudget ) );
+        vPrintStringAndNumber( "Task 2 budget overruns (suspended):", ulCpuBudgetGetOverrunCount( &xSuspendedTaskBudget ) );
+        ulLastCycles = ulCycles;
+    }
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,143 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "cpu_load.h"
+#include "workload.h"
+
+/* The number of workloads defined in xWorkloadParameters[]. */
+#define mainNUM_WORKLOADS    ( sizeof( xWorkloadParameters ) / sizeof( xWorkloadParameters[ 0 ] ) )
+
+/* The tasks to be created. */
+static void vStartupTask( void * pvParameters );
+static void vReporterTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+/* The synthetic workloads.  Between them they request 70% of the CPU:  a fast
+ * control loop with a fixed execution time and no memory traffic, a telemetry
+ * task with exponentially distributed execution times that accesses a buffer
+ * at random, and a logger that usually has little to do but occasionally has a
+ * lot to do, streaming sequentially through a large buffer.  Change these to
+ * model the application being load tested. */
+static const WorkloadParameters_t xWorkloadParameters[] =
+{
+    /* Name,       Priority, Period (us), Duty %, Burst distribution,        Memory pattern,            Size,         Stride, Seed */
+    { "Control",   3,        1000UL,      20UL,   eWorkloadBurstFixed,       eWorkloadMemoryNone,       0,            0,      1UL },
+    { "Telemetry", 2,        10000UL,     30UL,   eWorkloadBurstExponential, eWorkloadMemoryRandom,     64 * 1024,    0,      2UL },
+    { "Logger",    1,        100000UL,    20UL,   eWorkloadBurstBimodal,     eWorkloadMemorySequential, 256 * 1024,   0,      3UL }
+};
+
+static WorkloadHandle_t xWorkloads[ mainNUM_WORKLOADS ];
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    /* The workloads are calibrated against the benchmark timer. */
+    vBenchmarkTimerInit();
+
+    /* The other tasks are created by the start up task once the idle hook has
+     * been calibrated, as per Example027. */
+    xTaskCreate( vStartupTask, "Startup", 1000, NULL, configMAX_PRIORITIES - 1, NULL );
+
+    /* Start the scheduler so the created tasks start executing. */
+    vTaskStartScheduler();
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vStartupTask( void * pvParameters )
+{
+    size_t x;
+
+    ( void ) pvParameters;
+
+    /* Calibrate the CPU load estimator, which is used to check the generated
+     * load matches the requested load. */
+    vCpuLoadCalibrate( pdMS_TO_TICKS( 1000UL ) );
+
+    /* Each workload is calibrated as it is created.  This task has the highest
+     * priority so nothing else runs during calibration. */
+    for( x = 0; x < mainNUM_WORKLOADS; x++ )
+    {
+        xWorkloads[ x ] = xWorkloadCreate( &( xWorkloadParameters[ x ] ) );
+        configASSERT( xWorkloads[ x ] != NULL );
+        vPrintTwoStrings( "Calibrated workload", xWorkloadParameters[ x ].pcName );
+        vPrintStringAndNumber( "Iterations per ms:", ulWorkloadGetIterationsPerMs( xWorkloads[ x ] ) );
+    }
+
+    xTaskCreate( vReporterTask, "Reporter", 1000, NULL, configMAX_PRIORITIES - 1, NULL );
+
+    /* This task has nothing more to do. */
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void vReporterTask( void * pvParameters )
+{
+    const TickType_t xDelay5s = pdMS_TO_TICKS( 5000UL );
+    WorkloadStats_t xStats;
+    char cBuffer[ 100 ];
+    size_t x;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        vTaskDelay( xDelay5s );
+
+        vPrintString( "Workload     Activations  Deadline misses  Max response (us)  Requested CPU (ms)\r\n" );
+
+        for( x = 0; x < mainNUM_WORKLOADS; x++ )
+        {
+            vWorkloadGetStats( xWorkloads[ x ], &xStats );
+            snprintf( cBuffer, sizeof( cBuffer ), "%-12s %11lu  %15lu  %17lu  %18lu\r\n",
+                      xWorkloadParameters[ x ].pcName,
+                      ( unsigned long ) xStats.ulActivations,
+                      ( unsigned long ) xStats.ulDeadlineMisses,
+                      ( unsigned long ) xStats.ulMaxResponseUs,
+                      ( unsigned long ) ( xStats.ullRequestedWorkUs / 1000ULL ) );
+            vPrintString( cBuffer );
+        }
+
+        /* The measured load should be close to the 70% requested. */
+        vPrintStringAndNumber( "Measured 10s load average (0.1%):", ulCpuLoadGet( eCpuLoad10Seconds ) );
+        vPrintString( "\r\n" );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+    vCpuLoadIdleHook();
+}
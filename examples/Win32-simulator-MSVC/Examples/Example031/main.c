@@ -0,0 +1,252 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "priority_batch.h"
+
+/* The largest number of worker tasks.  The benchmark is repeated with 1, 2, 4,
+ * 8... worker tasks, up to this number. */
+#define mainMAX_WORKERS               64
+
+/* The number of times the priorities of the worker tasks are changed at each
+ * number of worker tasks. */
+#define mainCHANGE_ROUNDS             1000
+#define mainSTORM_ROUNDS              100
+
+/* Priorities.  The benchmark task normally runs above all the worker tasks, so
+ * changing their priorities never causes a context switch and the cost of the
+ * change itself is measured.  To generate a storm of context switches it drops
+ * to mainSTORM_PRIORITY, then raises the worker tasks above itself. */
+#define mainBENCHMARK_PRIORITY        ( configMAX_PRIORITIES - 1 )
+#define mainWORKER_BASE_PRIORITY      1
+#define mainSTORM_PRIORITY            2
+#define mainWORKER_RAISED_PRIORITY    3
+
+/* The task functions. */
+static void vBenchmarkTask( void * pvParameters );
+static void vWorkerTask( void * pvParameters );
+
+/* Change the priority of the first xNumWorkers worker tasks either one at a
+ * time or as a batch, returning the elapsed time in nanoseconds and the number
+ * of context switches in *pulSwitches. */
+static uint64_t prvChangePriorities( size_t xNumWorkers,
+                                     uint32_t ulRounds,
+                                     BaseType_t xBatched,
+                                     uint32_t * pulSwitches );
+
+/*-----------------------------------------------------------*/
+
+/* The worker tasks, and the batches that raise and restore their priorities. */
+static TaskHandle_t xWorkers[ mainMAX_WORKERS ];
+static PriorityUpdate_t xRaiseUpdates[ mainMAX_WORKERS ];
+static PriorityUpdate_t xRestoreUpdates[ mainMAX_WORKERS ];
+
+/* Incremented by the traceTASK_SWITCHED_IN() macro defined in
+ * FreeRTOSConfig.h each time a different task is selected to run. */
+static volatile uint32_t ulContextSwitches = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    vBenchmarkTimerInit();
+
+    /* The worker tasks are created by the benchmark task itself, as the number
+     * of Ready state tasks grows. */
+    xTaskCreate( vBenchmarkTask, "Benchmark", 1000, NULL, mainBENCHMARK_PRIORITY, NULL );
+
+    /* Start the scheduler so the created task starts executing. */
+    vTaskStartScheduler();
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vBenchmarkTask( void * pvParameters )
+{
+    size_t xNumWorkers, xCreated = 0;
+    uint64_t ullSingleNs, ullBatchedNs;
+    uint32_t ulSingleSwitches, ulBatchedSwitches, ulChanges;
+    char cBuffer[ 150 ];
+
+    ( void ) pvParameters;
+
+    vPrintString( "Changing priorities without context switches:\r\n" );
+    vPrintString( "Ready tasks  Single (ns/change)  Batched (ns/change)\r\n" );
+
+    for( xNumWorkers = 1; xNumWorkers <= mainMAX_WORKERS; xNumWorkers *= 2 )
+    {
+        /* Add more worker tasks.  They are created below the priority of this
+         * task, so they sit in the Ready state and do not run. */
+        while( xCreated < xNumWorkers )
+        {
+            if( xTaskCreate( vWorkerTask, "Worker", configMINIMAL_STACK_SIZE, NULL, mainWORKER_BASE_PRIORITY, &( xWorkers[ xCreated ] ) ) != pdPASS )
+            {
+                vPrintString( "Could not create a worker task\r\n" );
+                vTaskDelete( NULL );
+            }
+
+            xRaiseUpdates[ xCreated ].xTask = xWorkers[ xCreated ];
+            xRaiseUpdates[ xCreated ].uxNewPriority = mainWORKER_RAISED_PRIORITY;
+            xRestoreUpdates[ xCreated ].xTask = xWorkers[ xCreated ];
+            xRestoreUpdates[ xCreated ].uxNewPriority = mainWORKER_BASE_PRIORITY;
+            xCreated++;
+        }
+
+        /* Every worker is raised then restored in each round. */
+        ulChanges = ( uint32_t ) xNumWorkers * mainCHANGE_ROUNDS * 2UL;
+
+        ullSingleNs = prvChangePriorities( xNumWorkers, mainCHANGE_ROUNDS, pdFALSE, &ulSingleSwitches );
+        ullBatchedNs = prvChangePriorities( xNumWorkers, mainCHANGE_ROUNDS, pdTRUE, &ulBatchedSwitches );
+
+        /* Neither method should have caused a context switch. */
+        configASSERT( ( ulSingleSwitches == 0 ) && ( ulBatchedSwitches == 0 ) );
+
+        snprintf( cBuffer, sizeof( cBuffer ), "%11lu  %18lu  %19lu\r\n",
+                  ( unsigned long ) xNumWorkers,
+                  ( unsigned long ) ( ullSingleNs / ulChanges ),
+                  ( unsigned long ) ( ullBatchedNs / ulChanges ) );
+        vPrintString( cBuffer );
+    }
+
+    /* Drop below the raised priority of the worker tasks, so each worker task
+     * preempts this task as soon as its priority is raised, as happens when a
+     * supervisory task rebalances the priorities of the tasks it supervises. */
+    vTaskPrioritySet( NULL, mainSTORM_PRIORITY );
+
+    vPrintString( "\r\nRaising the priorities of workers above the calling task:\r\n" );
+    vPrintString( "Workers  Single (switches/rebalance)  Batched (switches/rebalance)  Single (us/rebalance)  Batched (us/rebalance)\r\n" );
+
+    for( xNumWorkers = 1; xNumWorkers <= mainMAX_WORKERS; xNumWorkers *= 2 )
+    {
+        /* Raising each worker individually causes a switch to the worker then a
+         * switch back when the worker restores its own priority.  Raising them
+         * as a batch causes one switch to the first worker, then each worker
+         * hands over to the next when it restores its own priority. */
+        ullSingleNs = prvChangePriorities( xNumWorkers, mainSTORM_ROUNDS, pdFALSE, &ulSingleSwitches );
+        ullBatchedNs = prvChangePriorities( xNumWorkers, mainSTORM_ROUNDS, pdTRUE, &ulBatchedSwitches );
+
+        snprintf( cBuffer, sizeof( cBuffer ), "%7lu  %27lu  %28lu  %21lu  %22lu\r\n",
+                  ( unsigned long ) xNumWorkers,
+                  ( unsigned long ) ( ulSingleSwitches / mainSTORM_ROUNDS ),
+                  ( unsigned long ) ( ulBatchedSwitches / mainSTORM_ROUNDS ),
+                  ( unsigned long ) ( ullSingleNs / ( mainSTORM_ROUNDS * 1000ULL ) ),
+                  ( unsigned long ) ( ullBatchedNs / ( mainSTORM_ROUNDS * 1000ULL ) ) );
+        vPrintString( cBuffer );
+    }
+
+    vPrintString( "Benchmark complete\r\n" );
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvChangePriorities( size_t xNumWorkers,
+                                     uint32_t ulRounds,
+                                     BaseType_t xBatched,
+                                     uint32_t * pulSwitches )
+{
+    uint64_t ullStartTime;
+    uint32_t ulRound, ulStartSwitches;
+    size_t x;
+
+    ulStartSwitches = ulContextSwitches;
+    ullStartTime = ullBenchmarkTimerGetNanoseconds();
+
+    for( ulRound = 0; ulRound < ulRounds; ulRound++ )
+    {
+        if( xBatched != pdFALSE )
+        {
+            ( void ) xPriorityBatchApply( xRaiseUpdates, xNumWorkers );
+        }
+        else
+        {
+            for( x = 0; x < xNumWorkers; x++ )
+            {
+                vTaskPrioritySet( xWorkers[ x ], mainWORKER_RAISED_PRIORITY );
+            }
+        }
+
+        /* If the workers preempted this task they have already restored their
+         * own priorities, in which case these calls do nothing. */
+        if( xBatched != pdFALSE )
+        {
+            ( void ) xPriorityBatchApply( xRestoreUpdates, xNumWorkers );
+        }
+        else
+        {
+            for( x = 0; x < xNumWorkers; x++ )
+            {
+                vTaskPrioritySet( xWorkers[ x ], mainWORKER_BASE_PRIORITY );
+            }
+        }
+    }
+
+    *pulSwitches = ulContextSwitches - ulStartSwitches;
+
+    return ullBenchmarkTimerGetNanoseconds() - ullStartTime;
+}
+/*-----------------------------------------------------------*/
+
+static void vWorkerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    /* A worker only runs when its priority has been raised above that of the
+     * benchmark task.  It then puts its priority back, which lets the benchmark
+     * task, or the next raised worker, run again.  Workers that are left at
+     * their base priority spin in the Ready state whenever the benchmark task
+     * is not running, as the tasks in Example008 do. */
+    for( ; ; )
+    {
+        if( uxTaskPriorityGet( NULL ) != mainWORKER_BASE_PRIORITY )
+        {
+            vTaskPrioritySet( NULL, mainWORKER_BASE_PRIORITY );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vCountContextSwitch( void )
+{
+    static TaskHandle_t xLastTask = NULL;
+    TaskHandle_t xCurrentTask;
+
+    /* The scheduler also calls traceTASK_SWITCHED_IN() when it reselects the
+     * task that was already running, which is not counted. */
+    xCurrentTask = xTaskGetCurrentTaskHandle();
+
+    if( xCurrentTask != xLastTask )
+    {
+        ulContextSwitches++;
+        xLastTask = xCurrentTask;
+    }
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,319 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "queue_multiple.h"
+
+/* The number of the simulated interrupt used in this example.  Numbers 0 to 2
+ * are used by the FreeRTOS Windows port itself, so 3 is the first number available
+ * to the application. */
+#define mainINTERRUPT_NUMBER      3
+
+/* The item sizes benchmarked, and the largest of them. */
+#define mainNUM_ITEM_SIZES        ( sizeof( xItemSizes ) / sizeof( xItemSizes[ 0 ] ) )
+#define mainMAX_ITEM_SIZE         64
+
+/* The length of each queue, and the maximum number of items moved by each call
+ * to the multiple item API functions. */
+#define mainQUEUE_LENGTH          32
+#define mainBATCH_SIZE            16
+
+/* The number of items passed between tasks per test, and the number of times
+ * the interrupt drains a full queue per test. */
+#define mainITEMS_PER_TEST        20000UL
+#define mainINTERRUPTS_PER_TEST   1000UL
+
+/* The tasks to be created. */
+static void vBenchmarkTask( void * pvParameters );
+static void vConsumerTask( void * pvParameters );
+static void vMultipleConsumerTask( void * pvParameters );
+
+/* The service routine for the (simulated) interrupt that drains the queue. */
+static uint32_t ulExampleInterruptHandler( void );
+
+/* Time passing mainITEMS_PER_TEST items of one size to a consumer task, and
+ * time an interrupt that drains a full queue of items of the same size. */
+static uint64_t prvTimeTaskToTask( size_t xSizeIndex,
+                                   BaseType_t xUseMultiple );
+static uint64_t prvTimeInterruptDrain( size_t xSizeIndex,
+                                       BaseType_t xUseMultiple );
+
+/*-----------------------------------------------------------*/
+
+static const size_t xItemSizes[] = { 4, 8, 16, 32, 64 };
+
+/* For each item size, one queue that is read by a consumer task and one queue
+ * that is read by the interrupt.  The queues created with xQueueCreate() are
+ * used one item at a time, the queues created with xQueueMultipleCreate() a
+ * batch at a time. */
+static QueueHandle_t xTaskQueues[ mainNUM_ITEM_SIZES ];
+static QueueHandle_t xInterruptQueues[ mainNUM_ITEM_SIZES ];
+static QueueMultipleHandle_t xTaskMultipleQueues[ mainNUM_ITEM_SIZES ];
+static QueueMultipleHandle_t xInterruptMultipleQueues[ mainNUM_ITEM_SIZES ];
+
+/* Whether the interrupt uses the multiple item API functions or receives one
+ * item at a time. */
+static volatile BaseType_t xInterruptUsesMultiple = pdFALSE;
+
+/* The queue the interrupt drains, the time the interrupt spends draining it,
+ * and the number of items received by the consumer tasks. */
+static volatile QueueHandle_t xQueueToDrain = NULL;
+static volatile QueueMultipleHandle_t xMultipleQueueToDrain = NULL;
+static volatile uint64_t ullInterruptNs = 0;
+static volatile uint32_t ulInterruptCount = 0;
+static volatile uint32_t ulItemsConsumed = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    size_t x;
+
+    vBenchmarkTimerInit();
+
+    for( x = 0; x < mainNUM_ITEM_SIZES; x++ )
+    {
+        xTaskQueues[ x ] = xQueueCreate( mainQUEUE_LENGTH, xItemSizes[ x ] );
+        xInterruptQueues[ x ] = xQueueCreate( mainQUEUE_LENGTH, xItemSizes[ x ] );
+        xTaskMultipleQueues[ x ] = xQueueMultipleCreate( mainQUEUE_LENGTH, xItemSizes[ x ] );
+        xInterruptMultipleQueues[ x ] = xQueueMultipleCreate( mainQUEUE_LENGTH, xItemSizes[ x ] );
+        configASSERT( ( xTaskQueues[ x ] != NULL ) && ( xInterruptQueues[ x ] != NULL ) );
+        configASSERT( ( xTaskMultipleQueues[ x ] != NULL ) && ( xInterruptMultipleQueues[ x ] != NULL ) );
+
+        /* Each consumer runs above the benchmark task, so every item sent to it
+         * can cause a context switch, as the string printer task in Example019
+         * does. */
+        xTaskCreate( vConsumerTask, "Consumer", 1000, ( void * ) xTaskQueues[ x ], 2, NULL );
+        xTaskCreate( vMultipleConsumerTask, "MConsumer", 1000, ( void * ) xTaskMultipleQueues[ x ], 2, NULL );
+    }
+
+    xTaskCreate( vBenchmarkTask, "Benchmark", 1000, NULL, 1, NULL );
+
+    /* Install the handler for the software interrupt.  The syntax necessary
+     * to do this is dependent on the FreeRTOS port being used.  The syntax
+     * shown here can only be used with the FreeRTOS Windows port, where such
+     * interrupts are only simulated. */
+    vPortSetInterruptHandler( mainINTERRUPT_NUMBER, ulExampleInterruptHandler );
+
+    /* Start the scheduler so the created tasks start executing. */
+    vTaskStartScheduler();
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vBenchmarkTask( void * pvParameters )
+{
+    uint64_t ullSingleNs, ullMultipleNs, ullSingleIsrNs, ullMultipleIsrNs;
+    const uint32_t ulInterruptItems = mainINTERRUPTS_PER_TEST * mainQUEUE_LENGTH;
+    char cBuffer[ 120 ];
+    size_t x;
+
+    ( void ) pvParameters;
+
+    vPrintString( "                 Task to task (ns/item)   Interrupt drain (ns/item)\r\n" );
+    vPrintString( "Item size (bytes)    Single    Multiple       Single    Multiple\r\n" );
+
+    for( x = 0; x < mainNUM_ITEM_SIZES; x++ )
+    {
+        ullSingleNs = prvTimeTaskToTask( x, pdFALSE );
+        ullMultipleNs = prvTimeTaskToTask( x, pdTRUE );
+        ullSingleIsrNs = prvTimeInterruptDrain( x, pdFALSE );
+        ullMultipleIsrNs = prvTimeInterruptDrain( x, pdTRUE );
+
+        snprintf( cBuffer, sizeof( cBuffer ), "%17lu  %8lu  %10lu  %11lu  %10lu\r\n",
+                  ( unsigned long ) xItemSizes[ x ],
+                  ( unsigned long ) ( ullSingleNs / mainITEMS_PER_TEST ),
+                  ( unsigned long ) ( ullMultipleNs / mainITEMS_PER_TEST ),
+                  ( unsigned long ) ( ullSingleIsrNs / ulInterruptItems ),
+                  ( unsigned long ) ( ullMultipleIsrNs / ulInterruptItems ) );
+        vPrintString( cBuffer );
+    }
+
+    vPrintString( "Benchmark complete\r\n" );
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvTimeTaskToTask( size_t xSizeIndex,
+                                   BaseType_t xUseMultiple )
+{
+    static uint8_t ucItems[ mainBATCH_SIZE * mainMAX_ITEM_SIZE ];
+    uint64_t ullStartTime, ullElapsed;
+    uint32_t ulSent = 0, ulToSend;
+
+    ulItemsConsumed = 0;
+    ullStartTime = ullBenchmarkTimerGetNanoseconds();
+
+    while( ulSent < mainITEMS_PER_TEST )
+    {
+        if( xUseMultiple != pdFALSE )
+        {
+            ulToSend = mainITEMS_PER_TEST - ulSent;
+
+            if( ulToSend > mainBATCH_SIZE )
+            {
+                ulToSend = mainBATCH_SIZE;
+            }
+
+            ulSent += uxQueueSendMultiple( xTaskMultipleQueues[ xSizeIndex ], ucItems, ( UBaseType_t ) ulToSend, portMAX_DELAY );
+        }
+        else
+        {
+            xQueueSendToBack( xTaskQueues[ xSizeIndex ], ucItems, portMAX_DELAY );
+            ulSent++;
+        }
+    }
+
+    ullElapsed = ullBenchmarkTimerGetNanoseconds() - ullStartTime;
+
+    /* The consumer has the higher priority, so has already received every
+     * item. */
+    configASSERT( ulItemsConsumed == mainITEMS_PER_TEST );
+
+    return ullElapsed;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvTimeInterruptDrain( size_t xSizeIndex,
+                                       BaseType_t xUseMultiple )
+{
+    static uint8_t ucItems[ mainQUEUE_LENGTH * mainMAX_ITEM_SIZE ];
+    uint32_t ulInterrupt;
+    UBaseType_t uxSent;
+
+    xInterruptUsesMultiple = xUseMultiple;
+    xQueueToDrain = xInterruptQueues[ xSizeIndex ];
+    xMultipleQueueToDrain = xInterruptMultipleQueues[ xSizeIndex ];
+    ullInterruptNs = 0;
+
+    for( ulInterrupt = 0; ulInterrupt < mainINTERRUPTS_PER_TEST; ulInterrupt++ )
+    {
+        /* Fill the queue.  Nothing else reads this queue, so all the items fit
+         * without needing to specify a block time. */
+        if( xUseMultiple != pdFALSE )
+        {
+            uxSent = uxQueueSendMultiple( xMultipleQueueToDrain, ucItems, mainQUEUE_LENGTH, 0 );
+        }
+        else
+        {
+            for( uxSent = 0; uxSent < mainQUEUE_LENGTH; uxSent++ )
+            {
+                if( xQueueSendToBack( xQueueToDrain, ucItems, 0 ) != pdPASS )
+                {
+                    break;
+                }
+            }
+        }
+
+        configASSERT( uxSent == mainQUEUE_LENGTH );
+
+        /* Generate the interrupt, then wait for the handler to finish emptying
+         * the queue.  The syntax used to generate a software interrupt is
+         * dependent on the FreeRTOS port being used.  The syntax used below can
+         * only be used with the FreeRTOS Windows port, in which such interrupts
+         * are only simulated. */
+        vPortGenerateSimulatedInterrupt( mainINTERRUPT_NUMBER );
+
+        while( ulInterruptCount != ( ulInterrupt + 1 ) )
+        {
+        }
+    }
+
+    ulInterruptCount = 0;
+
+    /* Only the time spent inside the interrupt handler is returned. */
+    return ullInterruptNs;
+}
+/*-----------------------------------------------------------*/
+
+static void vConsumerTask( void * pvParameters )
+{
+    QueueHandle_t xQueue = ( QueueHandle_t ) pvParameters;
+    uint8_t ucBuffer[ mainMAX_ITEM_SIZE ];
+
+    for( ; ; )
+    {
+        xQueueReceive( xQueue, ucBuffer, portMAX_DELAY );
+        ulItemsConsumed++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vMultipleConsumerTask( void * pvParameters )
+{
+    QueueMultipleHandle_t xQueue = ( QueueMultipleHandle_t ) pvParameters;
+    uint8_t ucBuffer[ mainBATCH_SIZE * mainMAX_ITEM_SIZE ];
+    UBaseType_t uxReceived;
+
+    for( ; ; )
+    {
+        /* Block until at least one item is available, then take all the items
+         * that are available, up to the size of the buffer. */
+        uxReceived = uxQueueReceiveMultiple( xQueue, ucBuffer, mainBATCH_SIZE, portMAX_DELAY );
+        ulItemsConsumed += ( uint32_t ) uxReceived;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t ulExampleInterruptHandler( void )
+{
+    static uint8_t ucBuffer[ mainQUEUE_LENGTH * mainMAX_ITEM_SIZE ];
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint64_t ullStartTime;
+
+    ullStartTime = ullBenchmarkTimerGetNanoseconds();
+
+    if( xInterruptUsesMultiple != pdFALSE )
+    {
+        /* Empty the queue with one call. */
+        ( void ) uxQueueReceiveMultipleFromISR( xMultipleQueueToDrain, ucBuffer, mainQUEUE_LENGTH, &xHigherPriorityTaskWoken );
+    }
+    else
+    {
+        /* Empty the queue one item at a time, as Example019 does. */
+        while( xQueueReceiveFromISR( xQueueToDrain, ucBuffer, &xHigherPriorityTaskWoken ) != errQUEUE_EMPTY )
+        {
+        }
+    }
+
+    ullInterruptNs += ullBenchmarkTimerGetNanoseconds() - ullStartTime;
+    ulInterruptCount++;
+
+    /* No task blocks on the queue, so xHigherPriorityTaskWoken is always
+     * pdFALSE, but it is passed to portYIELD_FROM_ISR() for correctness.  The
+     * implementation of portYIELD_FROM_ISR() used by the Windows port includes
+     * a return statement, which is why this function does not explicitly return
+     * a value. */
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,239 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "buffer_pool.h"
+
+/* The size of each string buffer, as per Listing 5.14. */
+#define mainMAX_STRING_LENGTH    50
+
+/* The number of pointers the queue can hold, as per Listing 5.13. */
+#define mainQUEUE_LENGTH         5
+
+/* Every buffer in the queue is in use, and the sending and receiving tasks can
+ * each hold one more, so this many buffers are enough for the pool to never
+ * run out. */
+#define mainPOOL_BLOCKS          ( mainQUEUE_LENGTH + 2 )
+
+/* How long messages are counted for with each method of obtaining buffers. */
+#define mainMEASUREMENT_PERIOD_MS    2000UL
+
+/* The tasks to be created. */
+static void vStringSendingTask( void * pvParameters );
+static void vStringReceivingTask( void * pvParameters );
+static void vControllerTask( void * pvParameters );
+
+/* Obtain and release the string buffers.  Listing 5.14 and Listing 5.15 do not
+ * show these functions. */
+static void * prvGetBuffer( size_t xSize );
+static void prvReleaseBuffer( void * pvBuffer );
+
+/*-----------------------------------------------------------*/
+
+/* The queue that holds pointers to strings, as created in Listing 5.13. */
+static QueueHandle_t xPointerQueue;
+
+/* The pool the string buffers are obtained from when xUseBufferPool is
+ * pdTRUE.  When it is pdFALSE the buffers are obtained from the FreeRTOS heap
+ * instead. */
+static BufferPoolHandle_t xStringPool;
+static volatile BaseType_t xUseBufferPool = pdFALSE;
+
+/* The tasks, so the blocks each owns can be counted. */
+static TaskHandle_t xSendingTask, xReceivingTask;
+
+/* Incremented each time a string is received. */
+static volatile uint32_t ulMessagesReceived = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    /* Create a queue that can hold a maximum of 5 pointers, in this case
+     * character pointers. */
+    xPointerQueue = xQueueCreate( mainQUEUE_LENGTH, sizeof( char * ) );
+
+    /* Create the pool of buffers, each of which can hold one string. */
+    xStringPool = xBufferPoolCreate( mainMAX_STRING_LENGTH, mainPOOL_BLOCKS );
+
+    if( ( xPointerQueue != NULL ) && ( xStringPool != NULL ) )
+    {
+        /* The sending and receiving tasks have the same priority, so the
+         * sending task fills the queue before the receiving task empties it. */
+        xTaskCreate( vStringSendingTask, "Sender", 1000, NULL, 1, &xSendingTask );
+        xTaskCreate( vStringReceivingTask, "Receiver", 1000, NULL, 1, &xReceivingTask );
+
+        /* The controller periodically switches between the two methods of
+         * obtaining buffers, and reports how many messages each achieved. */
+        xTaskCreate( vControllerTask, "Controller", 1000, NULL, 2, NULL );
+
+        /* Start the scheduler so the created tasks start executing. */
+        vTaskStartScheduler();
+    }
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vStringSendingTask( void * pvParameters )
+{
+    char * pcStringToSend;
+    const size_t xMaxStringLength = mainMAX_STRING_LENGTH;
+    BaseType_t xStringNumber = 0;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* Obtain a buffer that is at least xMaxStringLength characters big,
+         * from either the pool or the heap. */
+        pcStringToSend = ( char * ) prvGetBuffer( xMaxStringLength );
+        configASSERT( pcStringToSend != NULL );
+
+        /* Write a string into the buffer. */
+        snprintf( pcStringToSend, xMaxStringLength, "String number %d\r\n", ( int ) xStringNumber );
+
+        /* Increment the counter so the string is different on each iteration
+         * of this task. */
+        xStringNumber++;
+
+        /* Send the address of the buffer to the queue.  From this point on the
+         * buffer belongs to the receiving task. */
+        xQueueSend( xPointerQueue, &pcStringToSend, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vStringReceivingTask( void * pvParameters )
+{
+    char * pcReceivedString;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* Receive the address of a buffer. */
+        xQueueReceive( xPointerQueue, &pcReceivedString, portMAX_DELAY );
+
+        /* If the buffer came from the pool, record that this task now owns
+         * it. */
+        if( xBufferPoolContains( xStringPool, pcReceivedString ) != pdFALSE )
+        {
+            vBufferPoolClaim( xStringPool, pcReceivedString );
+        }
+
+        /* Printing every string would limit the message rate to the speed of
+         * the console, so just check the string is intact. */
+        configASSERT( strncmp( pcReceivedString, "String number ", 14 ) == 0 );
+        ulMessagesReceived++;
+
+        /* The buffer is not required any more - release it so it can be freed,
+         * or re-used. */
+        prvReleaseBuffer( pcReceivedString );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vControllerTask( void * pvParameters )
+{
+    const TickType_t xMeasurementPeriod = pdMS_TO_TICKS( mainMEASUREMENT_PERIOD_MS );
+    uint32_t ulHeapRate, ulPoolRate;
+    BufferPoolStats_t xStats;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* Count the messages passed in one measurement period using buffers
+         * allocated from the heap... */
+        xUseBufferPool = pdFALSE;
+        ulMessagesReceived = 0;
+        vTaskDelay( xMeasurementPeriod );
+        ulHeapRate = ( ulMessagesReceived * 1000UL ) / mainMEASUREMENT_PERIOD_MS;
+
+        /* ...then using buffers obtained from the pool.  Buffers already in
+         * the queue when the method changes are released by the method they
+         * were obtained with, as prvReleaseBuffer() checks where each buffer
+         * came from. */
+        xUseBufferPool = pdTRUE;
+        ulMessagesReceived = 0;
+        vTaskDelay( xMeasurementPeriod );
+        ulPoolRate = ( ulMessagesReceived * 1000UL ) / mainMEASUREMENT_PERIOD_MS;
+
+        vPrintStringAndNumber( "Messages per second using pvPortMalloc() and vPortFree():", ulHeapRate );
+        vPrintStringAndNumber( "Messages per second using the buffer pool:", ulPoolRate );
+
+        vBufferPoolGetStats( xStringPool, &xStats );
+        vPrintStringAndNumber( "Pool blocks obtained:", xStats.ulSuccessfulGets );
+        vPrintStringAndNumber( "Pool exhausted count:", xStats.ulFailedGets );
+        vPrintStringAndNumber( "Pool minimum ever free blocks:", xStats.uxMinimumEverFreeBlocks );
+
+        /* Blocks in the queue are still owned by the sending task, as the
+         * receiving task has not claimed them yet. */
+        vPrintStringAndNumber( "Pool blocks owned by the sending task:", uxBufferPoolCountOwnedBlocks( xStringPool, xSendingTask ) );
+        vPrintStringAndNumber( "Pool blocks owned by the receiving task:", uxBufferPoolCountOwnedBlocks( xStringPool, xReceivingTask ) );
+        vPrintString( "\r\n" );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void * prvGetBuffer( size_t xSize )
+{
+    void * pvBuffer;
+
+    if( xUseBufferPool != pdFALSE )
+    {
+        /* Every block in the pool is mainMAX_STRING_LENGTH bytes. */
+        configASSERT( xSize <= mainMAX_STRING_LENGTH );
+        pvBuffer = pvBufferPoolGet( xStringPool );
+    }
+    else
+    {
+        pvBuffer = pvPortMalloc( xSize );
+    }
+
+    return pvBuffer;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReleaseBuffer( void * pvBuffer )
+{
+    if( xBufferPoolContains( xStringPool, pvBuffer ) != pdFALSE )
+    {
+        vBufferPoolReturn( xStringPool, pvBuffer );
+    }
+    else
+    {
+        vPortFree( pvBuffer );
+    }
+}
+/*-----------------------------------------------------------*/
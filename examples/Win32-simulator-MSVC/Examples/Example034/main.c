@@ -0,0 +1,386 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "message_queue.h"
+
+/* The number of events sent with each method. */
+#define mainEVENTS_PER_TEST    50000UL
+
+/* The number of events each queue can hold, assuming every event carries the
+ * largest payload. */
+#define mainQUEUE_LENGTH       16
+#define mainMAX_PAYLOAD        256
+
+/* A subset of the event types used by the TCP/IP stack, as per Listing 5.16. */
+typedef enum
+{
+    eNetworkDownEvent = 0, /* The network interface has been lost, or needs (re)connecting. */
+    eNetworkRxEvent,       /* A packet has been received from the network. */
+    eTCPAcceptEvent        /* FreeRTOS_accept() called to accept or wait for a new client. */
+} eIPEvent_t;
+
+/* The structure that describes events when they are sent using the pattern
+ * shown in Listing 5.16. */
+typedef struct IP_TASK_COMMANDS
+{
+    eIPEvent_t eEventType;
+    void * pvData;
+} IPStackEvent_t;
+
+/* When events are sent as IPStackEvent_t structures, the data received from
+ * the network is held in a separately allocated buffer, which is described by
+ * this structure. */
+typedef struct NetworkBuffer
+{
+    size_t xDataLength;
+    uint8_t * pucData;
+} NetworkBuffer_t;
+
+/* The tasks to be created. */
+static void vBenchmarkTask( void * pvParameters );
+static void vStructIPTask( void * pvParameters );
+static void vMessageIPTask( void * pvParameters );
+
+/* Generate the type and, for receive events, the length of the i'th event, so
+ * both methods send the same sequence of events. */
+static eIPEvent_t prvGetEvent( uint32_t ulEventNumber,
+                               size_t * pxLength );
+
+/* Time sending mainEVENTS_PER_TEST events using each method. */
+static uint64_t prvTimeStructEvents( void );
+static uint64_t prvTimeMessageEvents( void );
+
+/* Add the bytes in a buffer to ulChecksum, standing in for processing. */
+static void prvProcessData( const uint8_t * pucData,
+                            size_t xLength );
+
+/*-----------------------------------------------------------*/
+
+/* The two event queues, one for each method of sending events. */
+static QueueHandle_t xNetworkEventQueue;
+static MessageQueueHandle_t xNetworkMessageQueue;
+
+/* The data that is sent with each receive event. */
+static uint8_t ucRxData[ mainMAX_PAYLOAD ];
+
+/* The task that sends the events, which is notified when all the events have
+ * been processed. */
+static TaskHandle_t xBenchmarkTask;
+
+/* Updated by the tasks that process the events. */
+static volatile uint32_t ulEventsProcessed = 0;
+static volatile uint32_t ulChecksum = 0;
+static volatile uint32_t ulAllocations = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    size_t x;
+
+    vBenchmarkTimerInit();
+
+    for( x = 0; x < mainMAX_PAYLOAD; x++ )
+    {
+        ucRxData[ x ] = ( uint8_t ) x;
+    }
+
+    /* A queue of IPStackEvent_t structures, and a message queue that can hold
+     * the same number of events even if they all carry the largest payload. */
+    xNetworkEventQueue = xQueueCreate( mainQUEUE_LENGTH, sizeof( IPStackEvent_t ) );
+    xNetworkMessageQueue = xMessageQueueCreate( messagequeueSTORAGE_SIZE( mainQUEUE_LENGTH, mainMAX_PAYLOAD ) );
+
+    if( ( xNetworkEventQueue != NULL ) && ( xNetworkMessageQueue != NULL ) )
+    {
+        /* The tasks that process events stand in for the TCP/IP task, so run
+         * above the task that sends the events. */
+        xTaskCreate( vStructIPTask, "IPStruct", 1000, NULL, 2, NULL );
+        xTaskCreate( vMessageIPTask, "IPMessage", 1000, NULL, 2, NULL );
+        xTaskCreate( vBenchmarkTask, "Benchmark", 1000, NULL, 1, &xBenchmarkTask );
+
+        /* Start the scheduler so the created tasks start executing. */
+        vTaskStartScheduler();
+    }
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vBenchmarkTask( void * pvParameters )
+{
+    uint64_t ullStructNs, ullMessageNs;
+    uint32_t ulStructChecksum, ulStructAllocations;
+    char cBuffer[ 100 ];
+
+    ( void ) pvParameters;
+
+    ulChecksum = 0;
+    ulAllocations = 0;
+    ullStructNs = prvTimeStructEvents();
+    ulStructChecksum = ulChecksum;
+    ulStructAllocations = ulAllocations;
+
+    ulChecksum = 0;
+    ulAllocations = 0;
+    ullMessageNs = prvTimeMessageEvents();
+
+    /* Both methods must have delivered exactly the same data. */
+    configASSERT( ulChecksum == ulStructChecksum );
+
+    vPrintString( "Method                     ns/event  Events/second  Heap allocations\r\n" );
+    snprintf( cBuffer, sizeof( cBuffer ), "IPStackEvent_t + pointer  %9lu  %13lu  %16lu\r\n",
+              ( unsigned long ) ( ullStructNs / mainEVENTS_PER_TEST ),
+              ( unsigned long ) ( ( mainEVENTS_PER_TEST * 1000000000ULL ) / ullStructNs ),
+              ( unsigned long ) ulStructAllocations );
+    vPrintString( cBuffer );
+    snprintf( cBuffer, sizeof( cBuffer ), "Message queue            %9lu  %13lu  %16lu\r\n",
+              ( unsigned long ) ( ullMessageNs / mainEVENTS_PER_TEST ),
+              ( unsigned long ) ( ( mainEVENTS_PER_TEST * 1000000000ULL ) / ullMessageNs ),
+              ( unsigned long ) ulAllocations );
+    vPrintString( cBuffer );
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvTimeStructEvents( void )
+{
+    IPStackEvent_t xEventStruct;
+    NetworkBuffer_t * pxRxedData;
+    uint64_t ullStartTime;
+    uint32_t ulEvent;
+    size_t xLength;
+
+    ulEventsProcessed = 0;
+    ullStartTime = ullBenchmarkTimerGetNanoseconds();
+
+    for( ulEvent = 0; ulEvent < mainEVENTS_PER_TEST; ulEvent++ )
+    {
+        xEventStruct.eEventType = prvGetEvent( ulEvent, &xLength );
+
+        switch( xEventStruct.eEventType )
+        {
+            case eNetworkRxEvent:
+
+                /* The received data must be copied into a buffer that remains
+                 * valid until the TCP/IP task has processed it, as per
+                 * Listing 5.17. */
+                pxRxedData = ( NetworkBuffer_t * ) pvPortMalloc( sizeof( NetworkBuffer_t ) + xLength );
+                configASSERT( pxRxedData != NULL );
+                ulAllocations++;
+                pxRxedData->xDataLength = xLength;
+                pxRxedData->pucData = ( uint8_t * ) ( pxRxedData + 1 );
+                memcpy( pxRxedData->pucData, ucRxData, xLength );
+                xEventStruct.pvData = ( void * ) pxRxedData;
+                break;
+
+            case eTCPAcceptEvent:
+
+                /* The socket handle is held in pvData directly, as per
+                 * Listing 5.18. */
+                xEventStruct.pvData = ( void * ) &ucRxData[ ulEvent % mainMAX_PAYLOAD ];
+                break;
+
+            default:
+
+                /* Not used, as per Listing 5.19. */
+                xEventStruct.pvData = NULL;
+                break;
+        }
+
+        xQueueSendToBack( xNetworkEventQueue, &xEventStruct, portMAX_DELAY );
+    }
+
+    /* Wait for the last event to be processed. */
+    ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+    return ullBenchmarkTimerGetNanoseconds() - ullStartTime;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvTimeMessageEvents( void )
+{
+    uint64_t ullStartTime;
+    uint32_t ulEvent;
+    eIPEvent_t eEventType;
+    void * pvSocket;
+    size_t xLength;
+
+    ulEventsProcessed = 0;
+    ullStartTime = ullBenchmarkTimerGetNanoseconds();
+
+    for( ulEvent = 0; ulEvent < mainEVENTS_PER_TEST; ulEvent++ )
+    {
+        eEventType = prvGetEvent( ulEvent, &xLength );
+
+        switch( eEventType )
+        {
+            case eNetworkRxEvent:
+
+                /* The received data is copied straight into the message
+                 * queue. */
+                xMessageQueueSend( xNetworkMessageQueue, ( uint32_t ) eEventType, ucRxData, xLength, portMAX_DELAY );
+                break;
+
+            case eTCPAcceptEvent:
+
+                /* The payload is the socket handle itself. */
+                pvSocket = ( void * ) &ucRxData[ ulEvent % mainMAX_PAYLOAD ];
+                xMessageQueueSend( xNetworkMessageQueue, ( uint32_t ) eEventType, &pvSocket, sizeof( pvSocket ), portMAX_DELAY );
+                break;
+
+            default:
+
+                /* No payload at all. */
+                xMessageQueueSend( xNetworkMessageQueue, ( uint32_t ) eEventType, NULL, 0, portMAX_DELAY );
+                break;
+        }
+    }
+
+    ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+    return ullBenchmarkTimerGetNanoseconds() - ullStartTime;
+}
+/*-----------------------------------------------------------*/
+
+static void vStructIPTask( void * pvParameters )
+{
+    IPStackEvent_t xReceivedEvent;
+    NetworkBuffer_t * pxRxedData;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        xQueueReceive( xNetworkEventQueue, &xReceivedEvent, portMAX_DELAY );
+
+        /* The event type determines how pvData is interpreted, as per
+         * Listing 5.20. */
+        switch( xReceivedEvent.eEventType )
+        {
+            case eNetworkRxEvent:
+                pxRxedData = ( NetworkBuffer_t * ) xReceivedEvent.pvData;
+                prvProcessData( pxRxedData->pucData, pxRxedData->xDataLength );
+                vPortFree( pxRxedData );
+                break;
+
+            case eTCPAcceptEvent:
+                prvProcessData( ( const uint8_t * ) &( xReceivedEvent.pvData ), sizeof( xReceivedEvent.pvData ) );
+                break;
+
+            default:
+                break;
+        }
+
+        ulEventsProcessed++;
+
+        if( ulEventsProcessed == mainEVENTS_PER_TEST )
+        {
+            xTaskNotifyGive( xBenchmarkTask );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vMessageIPTask( void * pvParameters )
+{
+    uint8_t ucPayload[ mainMAX_PAYLOAD ];
+    uint32_t ulTag;
+    size_t xLength;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        xMessageQueueReceive( xNetworkMessageQueue, &ulTag, ucPayload, sizeof( ucPayload ), &xLength, portMAX_DELAY );
+
+        /* The tag takes the place of eEventType, and the payload is already in
+         * this task's buffer, so there is nothing to free. */
+        if( ( ulTag == ( uint32_t ) eNetworkRxEvent ) || ( ulTag == ( uint32_t ) eTCPAcceptEvent ) )
+        {
+            prvProcessData( ucPayload, xLength );
+        }
+
+        ulEventsProcessed++;
+
+        if( ulEventsProcessed == mainEVENTS_PER_TEST )
+        {
+            xTaskNotifyGive( xBenchmarkTask );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static eIPEvent_t prvGetEvent( uint32_t ulEventNumber,
+                               size_t * pxLength )
+{
+    /* Most events carry received data of varying lengths, one in four is an
+     * accept event, and one in sixteen is a network down event. */
+    static const size_t xRxLengths[] = { 32, 128, mainMAX_PAYLOAD };
+    eIPEvent_t eEventType;
+
+    *pxLength = 0;
+
+    if( ( ulEventNumber % 16 ) == 15 )
+    {
+        eEventType = eNetworkDownEvent;
+    }
+    else if( ( ulEventNumber % 4 ) == 3 )
+    {
+        eEventType = eTCPAcceptEvent;
+    }
+    else
+    {
+        eEventType = eNetworkRxEvent;
+        *pxLength = xRxLengths[ ulEventNumber % 4 ];
+    }
+
+    return eEventType;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessData( const uint8_t * pucData,
+                            size_t xLength )
+{
+    uint32_t ulSum = 0;
+    size_t x;
+
+    for( x = 0; x < xLength; x++ )
+    {
+        ulSum += pucData[ x ];
+    }
+
+    ulChecksum += ulSum;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,341 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+
+/* How long each configuration runs before, and while, messages are counted. */
+#define mainWARM_UP_MS             20UL
+#define mainRUN_DURATION_MS        200UL
+
+/* The limits of the parameters swept by the benchmark. */
+#define mainMAX_ITEM_SIZE          1024
+#define mainMAX_QUEUE_LENGTH       32
+#define mainMAX_PRODUCERS          2
+#define mainMAX_CONSUMERS          2
+
+/* When items are sent by reference each producer cycles through this many
+ * buffers, which is enough to ensure a buffer is never overwritten while a
+ * pointer to it is still in the queue or being read by a consumer. */
+#define mainREFERENCE_BUFFERS      ( mainMAX_QUEUE_LENGTH + mainMAX_CONSUMERS + 1 )
+
+/* The producers and consumers run at one of these two priorities.  The task
+ * that runs the benchmark is above both of them. */
+#define mainLOW_PRIORITY           1
+#define mainHIGH_PRIORITY          2
+#define mainCONTROLLER_PRIORITY    ( configMAX_PRIORITIES - 1 )
+
+#define mainARRAY_SIZE( x )        ( sizeof( x ) / sizeof( ( x )[ 0 ] ) )
+
+/* How items are passed.  Either the item itself is copied into and out of the
+ * queue, as in Example011, or a pointer to the item is, as in Listing 5.13. */
+typedef enum
+{
+    eByCopy = 0,
+    eByReference
+} CopyStrategy_t;
+
+/* The relative priorities of the producers and the consumers.  When the
+ * consumers have the higher priority the queue never holds more than one item,
+ * as in Example010.  When the producers have the higher priority the queue is
+ * always full, as in Example011. */
+typedef enum
+{
+    eConsumersHigher = 0,
+    eProducersHigher,
+    eEqualPriority
+} PriorityArrangement_t;
+
+/* The parameters of each producer and consumer task.  The buffers are here,
+ * rather than on the task stacks, as they can be large. */
+typedef struct TaskParameters
+{
+    QueueHandle_t xQueue;
+    size_t xItemSize;
+    CopyStrategy_t eStrategy;
+    volatile uint32_t ulMessages; /* Items sent or received. */
+    uint8_t ucBuffers[ mainREFERENCE_BUFFERS ][ mainMAX_ITEM_SIZE ];
+} TaskParameters_t;
+
+/* The tasks to be created. */
+static void vControllerTask( void * pvParameters );
+static void vProducerTask( void * pvParameters );
+static void vConsumerTask( void * pvParameters );
+
+/* Run a single configuration and print the result as a JSON object. */
+static void prvRunConfiguration( size_t xItemSize,
+                                 CopyStrategy_t eStrategy,
+                                 UBaseType_t uxQueueLength,
+                                 UBaseType_t uxProducers,
+                                 UBaseType_t uxConsumers,
+                                 PriorityArrangement_t eArrangement,
+                                 BaseType_t xFirst );
+
+/* Return the total number of messages received by the consumers. */
+static uint32_t prvCountMessages( UBaseType_t uxConsumers );
+
+/*-----------------------------------------------------------*/
+
+/* The values swept by the benchmark. */
+static const size_t xItemSizes[] = { 1, 4, 16, 64, 256, 1024 };
+static const UBaseType_t uxQueueLengths[] = { 1, 5, mainMAX_QUEUE_LENGTH };
+static const UBaseType_t uxTaskCounts[][ 2 ] =
+{
+    /* Producers, consumers. */
+    { 1, 1 },
+    { 2, 1 }, /* As Example010 and Example011. */
+    { 1, 2 },
+    { 2, 2 }
+};
+
+static const char * const pcStrategyNames[] = { "copy", "reference" };
+static const char * const pcArrangementNames[] = { "consumers_higher", "producers_higher", "equal" };
+
+static TaskParameters_t xProducers[ mainMAX_PRODUCERS ];
+static TaskParameters_t xConsumers[ mainMAX_CONSUMERS ];
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    vBenchmarkTimerInit();
+
+    /* The controller creates and deletes the producers and consumers for
+     * each configuration in turn. */
+    xTaskCreate( vControllerTask, "Controller", 1000, NULL, mainCONTROLLER_PRIORITY, NULL );
+
+    /* Start the scheduler so the created task starts executing. */
+    vTaskStartScheduler();
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vControllerTask( void * pvParameters )
+{
+    size_t xSize, xStrategy, xLength, xCounts, xArrangement;
+    BaseType_t xFirst = pdTRUE;
+
+    ( void ) pvParameters;
+
+    /* The results are printed as a JSON array with one object per
+     * configuration, so they can be captured and compared between runs. */
+    vPrintString( "[\r\n" );
+
+    for( xArrangement = 0; xArrangement < mainARRAY_SIZE( pcArrangementNames ); xArrangement++ )
+    {
+        for( xCounts = 0; xCounts < mainARRAY_SIZE( uxTaskCounts ); xCounts++ )
+        {
+            for( xLength = 0; xLength < mainARRAY_SIZE( uxQueueLengths ); xLength++ )
+            {
+                for( xStrategy = 0; xStrategy < mainARRAY_SIZE( pcStrategyNames ); xStrategy++ )
+                {
+                    for( xSize = 0; xSize < mainARRAY_SIZE( xItemSizes ); xSize++ )
+                    {
+                        prvRunConfiguration( xItemSizes[ xSize ],
+                                             ( CopyStrategy_t ) xStrategy,
+                                             uxQueueLengths[ xLength ],
+                                             uxTaskCounts[ xCounts ][ 0 ],
+                                             uxTaskCounts[ xCounts ][ 1 ],
+                                             ( PriorityArrangement_t ) xArrangement,
+                                             xFirst );
+                        xFirst = pdFALSE;
+                    }
+                }
+            }
+        }
+    }
+
+    vPrintString( "\r\n]\r\n" );
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunConfiguration( size_t xItemSize,
+                                 CopyStrategy_t eStrategy,
+                                 UBaseType_t uxQueueLength,
+                                 UBaseType_t uxProducers,
+                                 UBaseType_t uxConsumers,
+                                 PriorityArrangement_t eArrangement,
+                                 BaseType_t xFirst )
+{
+    TaskHandle_t xTasks[ mainMAX_PRODUCERS + mainMAX_CONSUMERS ];
+    UBaseType_t ux, uxNumTasks = 0, uxProducerPriority, uxConsumerPriority;
+    QueueHandle_t xQueue;
+    uint64_t ullStartTime, ullElapsedNs, ullMessagesPerSecond;
+    uint32_t ulStartMessages, ulMessages;
+    char cBuffer[ 300 ];
+
+    configASSERT( ( uxProducers <= mainMAX_PRODUCERS ) && ( uxConsumers <= mainMAX_CONSUMERS ) );
+
+    uxProducerPriority = ( eArrangement == eProducersHigher ) ? mainHIGH_PRIORITY : mainLOW_PRIORITY;
+    uxConsumerPriority = ( eArrangement == eConsumersHigher ) ? mainHIGH_PRIORITY : mainLOW_PRIORITY;
+
+    /* When sending by reference the queue only holds pointers. */
+    xQueue = xQueueCreate( uxQueueLength, ( eStrategy == eByCopy ) ? xItemSize : sizeof( uint8_t * ) );
+    configASSERT( xQueue != NULL );
+
+    /* The producers and consumers are below the priority of this task, so do
+     * not start running until this task blocks. */
+    for( ux = 0; ux < uxProducers; ux++ )
+    {
+        xProducers[ ux ].xQueue = xQueue;
+        xProducers[ ux ].xItemSize = xItemSize;
+        xProducers[ ux ].eStrategy = eStrategy;
+        xProducers[ ux ].ulMessages = 0;
+        xTaskCreate( vProducerTask, "Producer", 1000, &( xProducers[ ux ] ), uxProducerPriority, &( xTasks[ uxNumTasks ] ) );
+        configASSERT( xTasks[ uxNumTasks ] != NULL );
+        uxNumTasks++;
+    }
+
+    for( ux = 0; ux < uxConsumers; ux++ )
+    {
+        xConsumers[ ux ].xQueue = xQueue;
+        xConsumers[ ux ].xItemSize = xItemSize;
+        xConsumers[ ux ].eStrategy = eStrategy;
+        xConsumers[ ux ].ulMessages = 0;
+        xTaskCreate( vConsumerTask, "Consumer", 1000, &( xConsumers[ ux ] ), uxConsumerPriority, &( xTasks[ uxNumTasks ] ) );
+        configASSERT( xTasks[ uxNumTasks ] != NULL );
+        uxNumTasks++;
+    }
+
+    /* Let the tasks reach a steady state, then count the messages received
+     * in the measurement period. */
+    vTaskDelay( pdMS_TO_TICKS( mainWARM_UP_MS ) );
+    ulStartMessages = prvCountMessages( uxConsumers );
+    ullStartTime = ullBenchmarkTimerGetNanoseconds();
+
+    vTaskDelay( pdMS_TO_TICKS( mainRUN_DURATION_MS ) );
+    ulMessages = prvCountMessages( uxConsumers ) - ulStartMessages;
+    ullElapsedNs = ullBenchmarkTimerGetNanoseconds() - ullStartTime;
+
+    /* This task has the highest priority, so the other tasks are all in the
+     * Ready or Blocked state and can be deleted before their queue. */
+    for( ux = 0; ux < uxNumTasks; ux++ )
+    {
+        vTaskDelete( xTasks[ ux ] );
+    }
+
+    vQueueDelete( xQueue );
+
+    ullMessagesPerSecond = ( ( uint64_t ) ulMessages * 1000000000ULL ) / ullElapsedNs;
+
+    snprintf( cBuffer, sizeof( cBuffer ),
+              "%s  { \"item_size\": %lu, \"strategy\": \"%s\", \"queue_length\": %lu, "
+              "\"producers\": %lu, \"consumers\": %lu, \"priorities\": \"%s\", "
+              "\"messages_per_second\": %llu, \"bytes_per_second\": %llu }",
+              ( xFirst != pdFALSE ) ? "" : ",\r\n",
+              ( unsigned long ) xItemSize,
+              pcStrategyNames[ eStrategy ],
+              ( unsigned long ) uxQueueLength,
+              ( unsigned long ) uxProducers,
+              ( unsigned long ) uxConsumers,
+              pcArrangementNames[ eArrangement ],
+              ( unsigned long long ) ullMessagesPerSecond,
+              ( unsigned long long ) ( ullMessagesPerSecond * xItemSize ) );
+    vPrintString( cBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvCountMessages( UBaseType_t uxConsumers )
+{
+    uint32_t ulTotal = 0;
+    UBaseType_t ux;
+
+    for( ux = 0; ux < uxConsumers; ux++ )
+    {
+        ulTotal += xConsumers[ ux ].ulMessages;
+    }
+
+    return ulTotal;
+}
+/*-----------------------------------------------------------*/
+
+static void vProducerTask( void * pvParameters )
+{
+    TaskParameters_t * pxParameters = ( TaskParameters_t * ) pvParameters;
+    uint8_t * pucItem = pxParameters->ucBuffers[ 0 ];
+    size_t xNextBuffer = 0;
+
+    for( ; ; )
+    {
+        if( pxParameters->eStrategy == eByReference )
+        {
+            pucItem = pxParameters->ucBuffers[ xNextBuffer ];
+            xNextBuffer = ( xNextBuffer + 1 ) % mainREFERENCE_BUFFERS;
+        }
+
+        /* Write to the item so it is not just the same data every time. */
+        pucItem[ 0 ] = ( uint8_t ) pxParameters->ulMessages;
+
+        /* Block for as long as necessary for space to become available, as in
+         * Example011. */
+        if( pxParameters->eStrategy == eByCopy )
+        {
+            xQueueSendToBack( pxParameters->xQueue, pucItem, portMAX_DELAY );
+        }
+        else
+        {
+            xQueueSendToBack( pxParameters->xQueue, &pucItem, portMAX_DELAY );
+        }
+
+        pxParameters->ulMessages++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vConsumerTask( void * pvParameters )
+{
+    TaskParameters_t * pxParameters = ( TaskParameters_t * ) pvParameters;
+    uint8_t * pucReceived;
+    volatile uint8_t ucValue;
+
+    for( ; ; )
+    {
+        /* Block for as long as necessary for an item to arrive, as in
+         * Example010, then read the item. */
+        if( pxParameters->eStrategy == eByCopy )
+        {
+            xQueueReceive( pxParameters->xQueue, pxParameters->ucBuffers[ 0 ], portMAX_DELAY );
+            ucValue = pxParameters->ucBuffers[ 0 ][ 0 ];
+        }
+        else
+        {
+            xQueueReceive( pxParameters->xQueue, &pucReceived, portMAX_DELAY );
+            ucValue = pucReceived[ 0 ];
+        }
+
+        ( void ) ucValue;
+        pxParameters->ulMessages++;
+    }
+}
+/*-----------------------------------------------------------*/
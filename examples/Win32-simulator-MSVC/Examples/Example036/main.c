@@ -0,0 +1,264 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "spsc_ring.h"
+
+/* The number of the simulated interrupt used in this example.  Numbers 0 to 2
+ * are used by the FreeRTOS Windows port itself, so 3 is the first number available
+ * to the application. */
+#define mainINTERRUPT_NUMBER         3
+
+/* The number of interrupts generated per test, and the number of items each
+ * interrupt passes to the task - Example019 passes five items at a time. */
+#define mainINTERRUPTS_PER_TEST      20000UL
+#define mainITEMS_PER_INTERRUPT      5
+
+/* The capacity of both the queue and the ring. */
+#define mainBUFFER_LENGTH            64
+
+/* The item passed from the interrupt to the task.  The time stamp is used to
+ * measure the latency from the item being sent to the item being received. */
+typedef struct Sample
+{
+    uint64_t ullTimeStamp;
+    uint32_t ulSequence;
+} Sample_t;
+
+/* The tasks to be created. */
+static void vInterruptGeneratorTask( void * pvParameters );
+static void vQueueReceiverTask( void * pvParameters );
+static void vRingReceiverTask( void * pvParameters );
+
+/* The service routine for the (simulated) interrupt. */
+static uint32_t ulExampleInterruptHandler( void );
+
+/* Record the latency of a received sample, and check none were lost. */
+static void prvRecordSample( const Sample_t * pxSample );
+
+/*-----------------------------------------------------------*/
+
+/* The two paths from the interrupt to the task.  xUseRing selects which the
+ * interrupt uses. */
+static QueueHandle_t xSampleQueue;
+static SpscRingHandle_t xSampleRing;
+static volatile BaseType_t xUseRing = pdFALSE;
+
+/* Updated by the interrupt. */
+static volatile uint32_t ulNextSequence = 0;
+static volatile uint32_t ulSendFailures = 0;
+
+/* Updated by whichever task is receiving. */
+static volatile uint32_t ulSamplesReceived = 0;
+static volatile uint32_t ulSequenceErrors = 0;
+static uint32_t ulExpectedSequence = 0;
+static uint64_t ullTotalLatencyNs = 0;
+static uint64_t ullMaxLatencyNs = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    vBenchmarkTimerInit();
+
+    xSampleQueue = xQueueCreate( mainBUFFER_LENGTH, sizeof( Sample_t ) );
+    xSampleRing = xSpscRingCreate( mainBUFFER_LENGTH, sizeof( Sample_t ) );
+
+    if( ( xSampleQueue != NULL ) && ( xSampleRing != NULL ) )
+    {
+        /* The receiving tasks have the higher priority, as does the string
+         * printer task in Example019.  Only one of them receives samples in
+         * each test, the other remains blocked. */
+        xTaskCreate( vQueueReceiverTask, "QueueRx", 1000, NULL, 2, NULL );
+        xTaskCreate( vRingReceiverTask, "RingRx", 1000, NULL, 2, NULL );
+        xTaskCreate( vInterruptGeneratorTask, "Generator", 1000, NULL, 1, NULL );
+
+        /* Install the handler for the software interrupt.  The syntax necessary
+         * to do this is dependent on the FreeRTOS port being used.  The syntax
+         * shown here can only be used with the FreeRTOS Windows port, where such
+         * interrupts are only simulated. */
+        vPortSetInterruptHandler( mainINTERRUPT_NUMBER, ulExampleInterruptHandler );
+
+        /* Start the scheduler so the created tasks start executing. */
+        vTaskStartScheduler();
+    }
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vInterruptGeneratorTask( void * pvParameters )
+{
+    const uint32_t ulSamplesPerTest = mainINTERRUPTS_PER_TEST * mainITEMS_PER_INTERRUPT;
+    uint64_t ullStartTime, ullElapsedNs;
+    uint32_t ulInterrupt;
+    BaseType_t xTest;
+    char cBuffer[ 120 ];
+
+    ( void ) pvParameters;
+
+    vPrintString( "Path                        Samples/second  Mean latency (ns)  Max latency (ns)  Lost\r\n" );
+
+    for( xTest = 0; xTest < 2; xTest++ )
+    {
+        xUseRing = ( xTest == 1 ) ? pdTRUE : pdFALSE;
+        ulNextSequence = 0;
+        ulSendFailures = 0;
+        ulSamplesReceived = 0;
+        ulSequenceErrors = 0;
+        ulExpectedSequence = 0;
+        ullTotalLatencyNs = 0;
+        ullMaxLatencyNs = 0;
+
+        ullStartTime = ullBenchmarkTimerGetNanoseconds();
+
+        /* Generate interrupts as fast as they can be processed.  The syntax
+         * used to generate a software interrupt is dependent on the FreeRTOS
+         * port being used.  The syntax used below can only be used with the
+         * FreeRTOS Windows port, in which such interrupts are only simulated. */
+        for( ulInterrupt = 0; ulInterrupt < mainINTERRUPTS_PER_TEST; ulInterrupt++ )
+        {
+            vPortGenerateSimulatedInterrupt( mainINTERRUPT_NUMBER );
+        }
+
+        /* Wait for the receiving task to catch up with the interrupt. */
+        while( ( ulSamplesReceived + ulSendFailures ) < ulSamplesPerTest )
+        {
+            vTaskDelay( 1 );
+        }
+
+        ullElapsedNs = ullBenchmarkTimerGetNanoseconds() - ullStartTime;
+
+        snprintf( cBuffer, sizeof( cBuffer ), "%-26s  %14lu  %17lu  %16lu  %4lu\r\n",
+                  ( xUseRing != pdFALSE ) ? "SPSC ring" : "xQueueSendToBackFromISR()",
+                  ( unsigned long ) ( ( ulSamplesReceived * 1000000000ULL ) / ullElapsedNs ),
+                  ( unsigned long ) ( ullTotalLatencyNs / ulSamplesReceived ),
+                  ( unsigned long ) ullMaxLatencyNs,
+                  ( unsigned long ) ulSendFailures );
+        vPrintString( cBuffer );
+
+        /* Samples are never reordered, so gaps are only caused by send
+         * failures. */
+        configASSERT( ( ulSendFailures != 0 ) || ( ulSequenceErrors == 0 ) );
+    }
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void vQueueReceiverTask( void * pvParameters )
+{
+    Sample_t xSample;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* Block on the queue to wait for data to arrive, as per Example019. */
+        xQueueReceive( xSampleQueue, &xSample, portMAX_DELAY );
+        prvRecordSample( &xSample );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vRingReceiverTask( void * pvParameters )
+{
+    Sample_t xSample;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* Block on the ring to wait for data to arrive.  The task is only
+         * notified when it is actually waiting, so while data is arriving
+         * faster than it is processed no notifications are sent. */
+        xSpscRingReceive( xSampleRing, &xSample, portMAX_DELAY );
+        prvRecordSample( &xSample );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordSample( const Sample_t * pxSample )
+{
+    uint64_t ullLatency;
+
+    ullLatency = ullBenchmarkTimerGetNanoseconds() - pxSample->ullTimeStamp;
+    ullTotalLatencyNs += ullLatency;
+
+    if( ullLatency > ullMaxLatencyNs )
+    {
+        ullMaxLatencyNs = ullLatency;
+    }
+
+    if( pxSample->ulSequence != ulExpectedSequence )
+    {
+        ulSequenceErrors++;
+    }
+
+    ulExpectedSequence = pxSample->ulSequence + 1;
+    ulSamplesReceived++;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t ulExampleInterruptHandler( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE, xSent;
+    Sample_t xSample;
+    uint32_t ul;
+
+    for( ul = 0; ul < mainITEMS_PER_INTERRUPT; ul++ )
+    {
+        xSample.ullTimeStamp = ullBenchmarkTimerGetNanoseconds();
+        xSample.ulSequence = ulNextSequence;
+        ulNextSequence++;
+
+        if( xUseRing != pdFALSE )
+        {
+            xSent = xSpscRingPushFromISR( xSampleRing, &xSample, &xHigherPriorityTaskWoken );
+        }
+        else
+        {
+            xSent = xQueueSendToBackFromISR( xSampleQueue, &xSample, &xHigherPriorityTaskWoken );
+        }
+
+        if( xSent != pdPASS )
+        {
+            ulSendFailures++;
+        }
+    }
+
+    /* The implementation of portYIELD_FROM_ISR() used by the Windows port
+     * includes a return statement, which is why this function does not
+     * explicitly return a value. */
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,290 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "ready_set.h"
+
+/* The benchmark is repeated with 2, 4, 8... members, up to this number. */
+#define mainMAX_MEMBERS          256
+
+/* The length of each member queue. */
+#define mainMEMBER_LENGTH        4
+
+/* The number of items sent to randomly chosen members in each test. */
+#define mainITEMS_PER_TEST       20000UL
+
+/* The priorities of the tasks.  In the immediate tests the consumer runs above
+ * the producer, so receives each item as soon as it is sent.  In the backlog
+ * tests the consumer runs below the producer, so items build up in many
+ * members at once until the producer raises the consumer's priority to let it
+ * drain them. */
+#define mainPRODUCER_PRIORITY    2
+#define mainCONSUMER_ABOVE       3
+#define mainCONSUMER_BELOW       1
+
+/* The tasks to be created. */
+static void vProducerTask( void * pvParameters );
+static void vQueueSetConsumerTask( void * pvParameters );
+static void vReadySetConsumerTask( void * pvParameters );
+
+/* Time sending mainITEMS_PER_TEST items to randomly chosen members, using
+ * either a queue set or a ready set to multiplex the members, and with or
+ * without letting the members build a backlog. */
+static uint64_t prvRunTest( UBaseType_t uxNumMembers,
+                            BaseType_t xUseReadySet,
+                            BaseType_t xBacklog );
+
+/* A simple xorshift pseudo random number generator, so both tests send to the
+ * same sequence of members. */
+static uint32_t prvRand( void );
+
+/*-----------------------------------------------------------*/
+
+/* The members, and the set that multiplexes them.  Only one of the two sets
+ * exists at a time. */
+static QueueHandle_t xMembers[ mainMAX_MEMBERS ];
+static QueueSetHandle_t xQueueSet = NULL;
+static ReadySetHandle_t xReadySet = NULL;
+
+static volatile uint32_t ulItemsReceived = 0;
+static uint32_t ulRandomState = 1;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    vBenchmarkTimerInit();
+
+    /* The producer creates a consumer task for each test. */
+    xTaskCreate( vProducerTask, "Producer", 1000, NULL, mainPRODUCER_PRIORITY, NULL );
+
+    /* Start the scheduler so the created tasks start executing. */
+    vTaskStartScheduler();
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vProducerTask( void * pvParameters )
+{
+    UBaseType_t uxNumMembers;
+    uint64_t ullQueueSetNs, ullReadySetNs, ullQueueSetBacklogNs, ullReadySetBacklogNs;
+    size_t xQueueSetBytes;
+    char cBuffer[ 200 ];
+
+    ( void ) pvParameters;
+
+    vPrintString( "Times are in nanoseconds per item.\r\n" );
+    vPrintString( "Members  Immediate queue set  Immediate ready set    Backlog queue set    Backlog ready set  Queue set (bytes)  Ready set (bytes)\r\n" );
+
+    for( uxNumMembers = 2; uxNumMembers <= mainMAX_MEMBERS; uxNumMembers *= 2 )
+    {
+        ullQueueSetNs = prvRunTest( uxNumMembers, pdFALSE, pdFALSE );
+        ullReadySetNs = prvRunTest( uxNumMembers, pdTRUE, pdFALSE );
+        ullQueueSetBacklogNs = prvRunTest( uxNumMembers, pdFALSE, pdTRUE );
+        ullReadySetBacklogNs = prvRunTest( uxNumMembers, pdTRUE, pdTRUE );
+
+        /* A queue set holds one handle for every item that could be in any of
+         * its members. */
+        xQueueSetBytes = ( size_t ) uxNumMembers * mainMEMBER_LENGTH * sizeof( QueueSetMemberHandle_t );
+
+        snprintf( cBuffer, sizeof( cBuffer ), "%7lu  %19lu  %19lu  %19lu  %19lu  %17lu  %17lu\r\n",
+                  ( unsigned long ) uxNumMembers,
+                  ( unsigned long ) ( ullQueueSetNs / mainITEMS_PER_TEST ),
+                  ( unsigned long ) ( ullReadySetNs / mainITEMS_PER_TEST ),
+                  ( unsigned long ) ( ullQueueSetBacklogNs / mainITEMS_PER_TEST ),
+                  ( unsigned long ) ( ullReadySetBacklogNs / mainITEMS_PER_TEST ),
+                  ( unsigned long ) xQueueSetBytes,
+                  ( unsigned long ) xReadySetGetRequiredSize( uxNumMembers ) );
+        vPrintString( cBuffer );
+    }
+
+    vPrintString( "Benchmark complete\r\n" );
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvRunTest( UBaseType_t uxNumMembers,
+                            BaseType_t xUseReadySet,
+                            BaseType_t xBacklog )
+{
+    /* In the backlog tests the consumer is let run each time the members are,
+     * on average, half full. */
+    const uint32_t ulBurstLength = ( uint32_t ) ( uxNumMembers * mainMEMBER_LENGTH ) / 2UL;
+    uint64_t ullStartTime, ullElapsedNs;
+    TaskHandle_t xConsumer;
+    uint32_t ulItem;
+    UBaseType_t ux, uxMember;
+
+    /* Create the members, and add them to the set being tested.  The queue set
+     * must be long enough to hold an event for every item in every member, as
+     * described in section 5.6. */
+    if( xUseReadySet != pdFALSE )
+    {
+        xReadySet = xReadySetCreate( uxNumMembers );
+        configASSERT( xReadySet != NULL );
+    }
+    else
+    {
+        xQueueSet = xQueueCreateSet( uxNumMembers * mainMEMBER_LENGTH );
+        configASSERT( xQueueSet != NULL );
+    }
+
+    for( ux = 0; ux < uxNumMembers; ux++ )
+    {
+        xMembers[ ux ] = xQueueCreate( mainMEMBER_LENGTH, sizeof( uint32_t ) );
+        configASSERT( xMembers[ ux ] != NULL );
+
+        if( xUseReadySet == pdFALSE )
+        {
+            xQueueAddToSet( xMembers[ ux ], xQueueSet );
+        }
+    }
+
+    ulRandomState = 1;
+    ulItemsReceived = 0;
+
+    xTaskCreate( ( xUseReadySet != pdFALSE ) ? vReadySetConsumerTask : vQueueSetConsumerTask,
+                 "Consumer", 1000, NULL,
+                 ( xBacklog != pdFALSE ) ? mainCONSUMER_BELOW : mainCONSUMER_ABOVE,
+                 &xConsumer );
+    configASSERT( xConsumer != NULL );
+
+    ullStartTime = ullBenchmarkTimerGetNanoseconds();
+
+    for( ulItem = 0; ulItem < mainITEMS_PER_TEST; ulItem++ )
+    {
+        uxMember = ( UBaseType_t ) ( prvRand() % uxNumMembers );
+
+        /* In the immediate tests every member is always empty.  In the backlog
+         * tests the chosen member may be full, in which case the item is sent
+         * to the next member that has space - there always is one, as the
+         * members are drained before they are more than half full. */
+        while( xQueueSendToBack( xMembers[ uxMember ], &ulItem, 0 ) != pdPASS )
+        {
+            uxMember = ( uxMember + 1 ) % uxNumMembers;
+        }
+
+        if( xUseReadySet != pdFALSE )
+        {
+            vReadySetSignal( xReadySet, uxMember );
+        }
+
+        if( ( xBacklog != pdFALSE ) &&
+            ( ( ( ( ulItem + 1UL ) % ulBurstLength ) == 0UL ) || ( ( ulItem + 1UL ) == mainITEMS_PER_TEST ) ) )
+        {
+            /* Raising the consumer above this task lets it run straight away,
+             * and it drains every member before blocking on the set again.  It
+             * is then returned below this task so the next backlog builds up. */
+            vTaskPrioritySet( xConsumer, mainCONSUMER_ABOVE );
+            vTaskPrioritySet( xConsumer, mainCONSUMER_BELOW );
+        }
+    }
+
+    ullElapsedNs = ullBenchmarkTimerGetNanoseconds() - ullStartTime;
+    configASSERT( ulItemsReceived == mainITEMS_PER_TEST );
+
+    /* Delete the consumer, which is blocked on the set, before the set. */
+    vTaskDelete( xConsumer );
+
+    for( ux = 0; ux < uxNumMembers; ux++ )
+    {
+        if( xUseReadySet == pdFALSE )
+        {
+            xQueueRemoveFromSet( xMembers[ ux ], xQueueSet );
+        }
+
+        vQueueDelete( xMembers[ ux ] );
+    }
+
+    if( xUseReadySet != pdFALSE )
+    {
+        vReadySetDelete( xReadySet );
+        xReadySet = NULL;
+    }
+    else
+    {
+        vQueueDelete( xQueueSet );
+        xQueueSet = NULL;
+    }
+
+    return ullElapsedNs;
+}
+/*-----------------------------------------------------------*/
+
+static void vQueueSetConsumerTask( void * pvParameters )
+{
+    QueueSetMemberHandle_t xMember;
+    uint32_t ulReceived;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* Block on the queue set to wait for one of its members to contain
+         * data, as per Example012, then read from the selected member. */
+        xMember = xQueueSelectFromSet( xQueueSet, portMAX_DELAY );
+        xQueueReceive( ( QueueHandle_t ) xMember, &ulReceived, 0 );
+        ulItemsReceived++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vReadySetConsumerTask( void * pvParameters )
+{
+    UBaseType_t uxMember;
+    uint32_t ulReceived;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* The same, but using the ready set, which returns a member number
+         * rather than a handle. */
+        if( xReadySetSelect( xReadySet, &uxMember, portMAX_DELAY ) == pdPASS )
+        {
+            xQueueReceive( xMembers[ uxMember ], &ulReceived, 0 );
+            ulItemsReceived++;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+    ulRandomState ^= ulRandomState << 13;
+    ulRandomState ^= ulRandomState >> 17;
+    ulRandomState ^= ulRandomState << 5;
+
+    return ulRandomState;
+}
+/*-----------------------------------------------------------*/
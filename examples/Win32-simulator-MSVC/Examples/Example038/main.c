@@ -0,0 +1,258 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "seqlock_mailbox.h"
+
+/* The benchmark is repeated with 1, 2, 4... reader tasks, up to this number. */
+#define mainMAX_READERS         16
+
+/* How long the readers are left to run in each test. */
+#define mainTEST_DURATION_MS    1000UL
+
+/* Priorities of the tasks.  The writer preempts the readers each time it
+ * updates the mailboxes, so some reads are interrupted part way through. */
+#define mainCONTROL_PRIORITY    ( configMAX_PRIORITIES - 1 )
+#define mainWRITER_PRIORITY     2
+#define mainREADER_PRIORITY     1
+
+/* The item held in the mailboxes, as per section 5.7, with an extra member
+ * that lets the readers check they never read a partially updated item. */
+typedef struct xExampleStruct
+{
+    TickType_t xTimeStamp;
+    uint32_t ulValue;
+    uint32_t ulCheck; /* Always the bitwise inverse of ulValue. */
+} Example_t;
+
+/* The tasks to be created. */
+static void vControlTask( void * pvParameters );
+static void vWriterTask( void * pvParameters );
+static void vQueueReaderTask( void * pvParameters );
+static void vSeqlockReaderTask( void * pvParameters );
+
+/* Let uxNumReaders reader tasks sample one of the mailboxes for
+ * mainTEST_DURATION_MS, and return the total number of reads per second.  The
+ * total number of retries is written to *pulRetries. */
+static uint32_t prvRunTest( UBaseType_t uxNumReaders,
+                            TaskFunction_t pxReaderTask,
+                            uint32_t * pulRetries );
+
+/*-----------------------------------------------------------*/
+
+/* The queue based mailbox from section 5.7, and the sequence lock mailbox. */
+static QueueHandle_t xQueueMailbox = NULL;
+static SeqlockMailboxHandle_t xSeqlockMailbox = NULL;
+
+/* Each reader counts its reads, retries and torn reads in its own structure,
+ * so the readers do not share anything other than the mailbox. */
+typedef struct ReaderCounts
+{
+    volatile uint32_t ulReads;
+    uint32_t ulRetries;
+    volatile uint32_t ulTornReads;
+} ReaderCounts_t;
+
+static ReaderCounts_t xReaderCounts[ mainMAX_READERS ];
+
+/* The total number of torn reads seen by every test so far. */
+static uint32_t ulTornReads = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    vBenchmarkTimerInit();
+
+    xQueueMailbox = xQueueCreate( 1, sizeof( Example_t ) );
+    xSeqlockMailbox = xSeqlockMailboxCreate( sizeof( Example_t ) );
+
+    if( ( xQueueMailbox != NULL ) && ( xSeqlockMailbox != NULL ) )
+    {
+        /* The writer updates both mailboxes, so both tests pay the same cost
+         * for the writes. */
+        xTaskCreate( vWriterTask, "Writer", 1000, NULL, mainWRITER_PRIORITY, NULL );
+
+        /* The control task creates the readers for each test. */
+        xTaskCreate( vControlTask, "Control", 1000, NULL, mainCONTROL_PRIORITY, NULL );
+
+        /* Start the scheduler so the created tasks start executing. */
+        vTaskStartScheduler();
+    }
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vControlTask( void * pvParameters )
+{
+    UBaseType_t uxNumReaders;
+    uint32_t ulQueueReadsPerSecond, ulSeqlockReadsPerSecond, ulRetries;
+    char cBuffer[ 100 ];
+
+    ( void ) pvParameters;
+
+    /* Let the writer fill the mailboxes before any reader runs. */
+    vTaskDelay( pdMS_TO_TICKS( 10UL ) );
+
+    vPrintString( "Readers  Queue (reads/s)  Seqlock (reads/s)  Seqlock retries  Torn reads\r\n" );
+
+    for( uxNumReaders = 1; uxNumReaders <= mainMAX_READERS; uxNumReaders *= 2 )
+    {
+        ulQueueReadsPerSecond = prvRunTest( uxNumReaders, vQueueReaderTask, &ulRetries );
+        ulSeqlockReadsPerSecond = prvRunTest( uxNumReaders, vSeqlockReaderTask, &ulRetries );
+
+        snprintf( cBuffer, sizeof( cBuffer ), "%7lu  %15lu  %17lu  %15lu  %10lu\r\n",
+                  ( unsigned long ) uxNumReaders,
+                  ( unsigned long ) ulQueueReadsPerSecond,
+                  ( unsigned long ) ulSeqlockReadsPerSecond,
+                  ( unsigned long ) ulRetries,
+                  ( unsigned long ) ulTornReads );
+        vPrintString( cBuffer );
+    }
+
+    vPrintString( "Benchmark complete\r\n" );
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRunTest( UBaseType_t uxNumReaders,
+                            TaskFunction_t pxReaderTask,
+                            uint32_t * pulRetries )
+{
+    TaskHandle_t xReaders[ mainMAX_READERS ];
+    uint64_t ullStartTime, ullElapsedNs, ullTotalReads = 0;
+    UBaseType_t ux;
+
+    for( ux = 0; ux < uxNumReaders; ux++ )
+    {
+        xReaderCounts[ ux ].ulReads = 0;
+        xReaderCounts[ ux ].ulRetries = 0;
+        xReaderCounts[ ux ].ulTornReads = 0;
+    }
+
+    /* The readers have the lowest priority so they do not run until this task
+     * blocks.  Each is passed a pointer to its own counters. */
+    for( ux = 0; ux < uxNumReaders; ux++ )
+    {
+        xTaskCreate( pxReaderTask, "Reader", 1000, ( void * ) &( xReaderCounts[ ux ] ), mainREADER_PRIORITY, &( xReaders[ ux ] ) );
+        configASSERT( xReaders[ ux ] != NULL );
+    }
+
+    ullStartTime = ullBenchmarkTimerGetNanoseconds();
+    vTaskDelay( pdMS_TO_TICKS( mainTEST_DURATION_MS ) );
+    ullElapsedNs = ullBenchmarkTimerGetNanoseconds() - ullStartTime;
+
+    /* The readers never block, and this task cannot run while a reader is
+     * inside a critical section, so they can be deleted at any time. */
+    *pulRetries = 0;
+
+    for( ux = 0; ux < uxNumReaders; ux++ )
+    {
+        vTaskDelete( xReaders[ ux ] );
+        ullTotalReads += xReaderCounts[ ux ].ulReads;
+        *pulRetries += xReaderCounts[ ux ].ulRetries;
+        ulTornReads += xReaderCounts[ ux ].ulTornReads;
+    }
+
+    return ( uint32_t ) ( ( ullTotalReads * 1000000000ULL ) / ullElapsedNs );
+}
+/*-----------------------------------------------------------*/
+
+static void vWriterTask( void * pvParameters )
+{
+    Example_t xData;
+    uint32_t ulValue = 0;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        xData.xTimeStamp = xTaskGetTickCount();
+        xData.ulValue = ulValue;
+        xData.ulCheck = ~ulValue;
+        ulValue++;
+
+        /* xQueueOverwrite() is used as per Listing 5.25.  The sequence lock
+         * mailbox is always overwritten. */
+        xQueueOverwrite( xQueueMailbox, &xData );
+        vSeqlockMailboxWrite( xSeqlockMailbox, &xData );
+
+        /* Update the mailboxes once per tick. */
+        vTaskDelay( 1 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vQueueReaderTask( void * pvParameters )
+{
+    ReaderCounts_t * pxCounts = ( ReaderCounts_t * ) pvParameters;
+    Example_t xData;
+
+    for( ; ; )
+    {
+        /* Read the mailbox with xQueuePeek() as per Listing 5.26.  Each read
+         * copies the item inside a critical section. */
+        if( xQueuePeek( xQueueMailbox, &xData, 0 ) == pdPASS )
+        {
+            if( xData.ulCheck != ~xData.ulValue )
+            {
+                pxCounts->ulTornReads++;
+            }
+
+            pxCounts->ulReads++;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vSeqlockReaderTask( void * pvParameters )
+{
+    ReaderCounts_t * pxCounts = ( ReaderCounts_t * ) pvParameters;
+    Example_t xData;
+
+    for( ; ; )
+    {
+        /* The same, but without a critical section.  A read that overlaps an
+         * update is retried inside xSeqlockMailboxRead(). */
+        if( xSeqlockMailboxRead( xSeqlockMailbox, &xData, &( pxCounts->ulRetries ) ) == pdTRUE )
+        {
+            if( xData.ulCheck != ~xData.ulValue )
+            {
+                pxCounts->ulTornReads++;
+            }
+
+            pxCounts->ulReads++;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
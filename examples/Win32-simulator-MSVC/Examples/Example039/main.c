@@ -0,0 +1,253 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "queue_stats.h"
+
+/* The number of the simulated interrupt used in this example.  Numbers 0 to 2
+ * are used by the FreeRTOS Windows port itself, so 3 is the first number available
+ * to the application. */
+#define mainINTERRUPT_NUMBER      3
+
+/* The lengths of the two queues, which are deliberately chosen without
+ * measurement, as they would be in an application that has not been tuned. */
+#define mainDATA_QUEUE_LENGTH     5
+#define mainEVENT_QUEUE_LENGTH    8
+
+/* The number of events the interrupt sends to the event queue each time it
+ * executes. */
+#define mainEVENTS_PER_INTERRUPT  3
+
+/* How often the statistics are printed. */
+#define mainREPORT_PERIOD_MS      5000UL
+
+/* The tasks to be created. */
+static void vSenderTask( void * pvParameters );
+static void vReceiverTask( void * pvParameters );
+static void vPeriodicTask( void * pvParameters );
+static void vHandlerTask( void * pvParameters );
+static void vMonitorTask( void * pvParameters );
+
+/* The service routine for the (simulated) interrupt. */
+static uint32_t ulExampleInterruptHandler( void );
+
+/* Busy wait for ulMicroseconds, to simulate processing a received item. */
+static void prvProcess( uint32_t ulMicroseconds );
+
+/* A simple xorshift pseudo random number generator. */
+static uint32_t prvRand( void );
+
+/*-----------------------------------------------------------*/
+
+/* Data is sent from two tasks to one task, as per Example011.  Events are sent
+ * from an interrupt to a task, as per Example019. */
+static QueueHandle_t xDataQueue = NULL, xEventQueue = NULL;
+
+static uint32_t ulRandomState = 1;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    /* The statistics are time stamped with the benchmark timer. */
+    vBenchmarkTimerInit();
+
+    xDataQueue = xQueueCreate( mainDATA_QUEUE_LENGTH, sizeof( uint32_t ) );
+    xEventQueue = xQueueCreate( mainEVENT_QUEUE_LENGTH, sizeof( uint32_t ) );
+
+    if( ( xDataQueue != NULL ) && ( xEventQueue != NULL ) )
+    {
+        /* Register the queues so they are instrumented.  This also adds them to
+         * the queue registry, so kernel aware debuggers show the same names. */
+        xQueueStatsRegister( xDataQueue, "Data" );
+        xQueueStatsRegister( xEventQueue, "Event" );
+
+        /* As per Example011 the senders have a higher priority than the
+         * receiver, so the data queue is normally full. */
+        xTaskCreate( vSenderTask, "Sender1", 1000, ( void * ) 100, 2, NULL );
+        xTaskCreate( vSenderTask, "Sender2", 1000, ( void * ) 200, 2, NULL );
+        xTaskCreate( vReceiverTask, "Receiver", 1000, NULL, 1, NULL );
+
+        /* As per Example019 the handler task has a high priority, so the event
+         * queue is normally empty. */
+        xTaskCreate( vHandlerTask, "Handler", 1000, NULL, 3, NULL );
+        xTaskCreate( vPeriodicTask, "Periodic", 1000, NULL, 3, NULL );
+        vPortSetInterruptHandler( mainINTERRUPT_NUMBER, ulExampleInterruptHandler );
+
+        /* Print the statistics of both queues periodically, and use the
+         * snapshot API to check whether the data queue is long enough. */
+        xQueueStatsStartReporter( pdMS_TO_TICKS( mainREPORT_PERIOD_MS ), configMAX_PRIORITIES - 1 );
+        xTaskCreate( vMonitorTask, "Monitor", 1000, NULL, configMAX_PRIORITIES - 2, NULL );
+
+        /* Start the scheduler so the created tasks start executing. */
+        vTaskStartScheduler();
+    }
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vSenderTask( void * pvParameters )
+{
+    const uint32_t ulValueToSend = ( uint32_t ) ( size_t ) pvParameters;
+    const TickType_t xTicksToWait = pdMS_TO_TICKS( 10UL );
+
+    for( ; ; )
+    {
+        /* Send to the queue, blocking for up to 10ms for space to become
+         * available.  Failures are counted by the instrumentation, so are not
+         * reported here. */
+        xQueueSendToBack( xDataQueue, &ulValueToSend, xTicksToWait );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vReceiverTask( void * pvParameters )
+{
+    uint32_t ulReceivedValue;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        if( xQueueReceive( xDataQueue, &ulReceivedValue, portMAX_DELAY ) == pdPASS )
+        {
+            /* Most items take up to 2ms to process, but one in twenty takes
+             * 15ms, during which time the senders' 10ms timeout can expire. */
+            if( ( prvRand() % 20UL ) == 0 )
+            {
+                prvProcess( 15000UL );
+            }
+            else
+            {
+                prvProcess( prvRand() % 2000UL );
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vPeriodicTask( void * pvParameters )
+{
+    const TickType_t xDelay5ms = pdMS_TO_TICKS( 5UL );
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        vTaskDelay( xDelay5ms );
+        vPortGenerateSimulatedInterrupt( mainINTERRUPT_NUMBER );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vHandlerTask( void * pvParameters )
+{
+    uint32_t ulEvent;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* Block indefinitely waiting for an event, then process it briefly. */
+        if( xQueueReceive( xEventQueue, &ulEvent, portMAX_DELAY ) == pdPASS )
+        {
+            prvProcess( 50UL );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vMonitorTask( void * pvParameters )
+{
+    QueueStatsSnapshot_t xSnapshot;
+    uint32_t ulLastFailures = 0;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        vTaskDelay( pdMS_TO_TICKS( mainREPORT_PERIOD_MS ) );
+
+        /* A queue that has been full, and caused sends to fail, is too short for
+         * the rate at which its receiver empties it. */
+        if( xQueueStatsGetSnapshot( "Data", &xSnapshot ) == pdPASS )
+        {
+            if( ( xSnapshot.uxHighWaterMark == xSnapshot.uxLength ) && ( xSnapshot.ulSendFailures != ulLastFailures ) )
+            {
+                vPrintStringAndNumber( "Data queue filled and sends failed - length is too short:", xSnapshot.uxLength );
+            }
+
+            ulLastFailures = xSnapshot.ulSendFailures;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t ulExampleInterruptHandler( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    static uint32_t ulEvent = 0;
+    uint32_t ul;
+
+    for( ul = 0; ul < mainEVENTS_PER_INTERRUPT; ul++ )
+    {
+        xQueueSendToBackFromISR( xEventQueue, &ulEvent, &xHigherPriorityTaskWoken );
+        ulEvent++;
+    }
+
+    /* The implementation of portYIELD_FROM_ISR() used by the Windows port
+     * includes a return statement, which is why this function does not
+     * explicitly return a value. */
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcess( uint32_t ulMicroseconds )
+{
+    uint32_t ulStartTime = ulBenchmarkTimerGetMicroseconds();
+
+    while( ( ulBenchmarkTimerGetMicroseconds() - ulStartTime ) < ulMicroseconds )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+    ulRandomState ^= ulRandomState << 13;
+    ulRandomState ^= ulRandomState >> 17;
+    ulRandomState ^= ulRandomState << 5;
+
+    return ulRandomState;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,383 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "priority_queue.h"
+
+/* The number of the simulated interrupt used in this example.  Numbers 0 to 2
+ * are used by the FreeRTOS Windows port itself, so 3 is the first number available
+ * to the application. */
+#define mainINTERRUPT_NUMBER     3
+
+/* The classes of message, which are also the priority levels used when they
+ * are sent to the priority queue.  Control messages are the most urgent. */
+#define mainCLASS_BULK           0
+#define mainCLASS_STATUS         1
+#define mainCLASS_CONTROL        2
+#define mainNUM_CLASSES          3
+
+/* The length of the plain queue, and of each level of the priority queue. */
+#define mainQUEUE_LENGTH         10
+
+/* The number of control messages the interrupt sends each time it executes.
+ * Sending more than one shows whether they are received in order. */
+#define mainCONTROL_PER_INTERRUPT 2
+
+/* How long the consumer takes to process each message. */
+#define mainPROCESSING_TIME_US   200UL
+
+/* How long each method is tested for before the results are printed. */
+#define mainTEST_DURATION_MS     5000UL
+
+/* The message passed from the producers to the consumer. */
+typedef struct Message
+{
+    uint64_t ullTimeStamp;
+    uint32_t ulSequence;
+    uint32_t ulClass;
+} Message_t;
+
+/* The tasks to be created. */
+static void vControllerTask( void * pvParameters );
+static void vTelemetryTask( void * pvParameters );
+static void vStatusTask( void * pvParameters );
+static void vInterruptGeneratorTask( void * pvParameters );
+static void vConsumerTask( void * pvParameters );
+
+/* The service routine for the (simulated) interrupt. */
+static uint32_t ulExampleInterruptHandler( void );
+
+/* Send a message of class ulClass from a task, using whichever method is being
+ * tested. */
+static void prvSendFromTask( uint32_t ulClass );
+
+/* Update the statistics with a received message. */
+static void prvRecordMessage( const Message_t * pxMessage );
+
+/*-----------------------------------------------------------*/
+
+/* The plain queue, as used in Example021, the priority queue, and the queue set
+ * the consumer uses to wait on both. */
+static QueueHandle_t xPlainQueue = NULL;
+static PriorityQueueHandle_t xPriorityQueue = NULL;
+static QueueSetHandle_t xQueueSet = NULL;
+
+/* Set to pdTRUE to test the priority queue, pdFALSE to test the plain queue. */
+static volatile BaseType_t xUsePriorityQueue = pdFALSE;
+
+/* The statistics for each class of message. */
+static volatile uint32_t ulReceived[ mainNUM_CLASSES ];
+static volatile uint32_t ulDropped[ mainNUM_CLASSES ];
+static volatile uint64_t ullTotalLatencyNs[ mainNUM_CLASSES ];
+static volatile uint64_t ullMaxLatencyNs[ mainNUM_CLASSES ];
+static volatile uint32_t ulControlOutOfOrder = 0;
+static uint32_t ulLastControlSequence = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    vBenchmarkTimerInit();
+
+    xPlainQueue = xQueueCreate( mainQUEUE_LENGTH, sizeof( Message_t ) );
+    xPriorityQueue = xPriorityQueueCreate( mainNUM_CLASSES, mainQUEUE_LENGTH, sizeof( Message_t ) );
+
+    /* The set must be able to hold an event for every item in both queues. */
+    xQueueSet = xQueueCreateSet( mainQUEUE_LENGTH + ( mainNUM_CLASSES * mainQUEUE_LENGTH ) );
+
+    if( ( xPlainQueue != NULL ) && ( xPriorityQueue != NULL ) && ( xQueueSet != NULL ) )
+    {
+        /* The priority queue is added to the set in the same way as the plain
+         * queue, so the consumer can wait on either. */
+        xQueueAddToSet( xPlainQueue, xQueueSet );
+        xPriorityQueueAddToSet( xPriorityQueue, xQueueSet );
+
+        /* The producers run above the consumer, so the queues are normally
+         * full of bulk messages, as they would be when telemetry is streaming
+         * faster than it can be processed. */
+        xTaskCreate( vTelemetryTask, "Telemetry", 1000, NULL, 2, NULL );
+        xTaskCreate( vStatusTask, "Status", 1000, NULL, 2, NULL );
+        xTaskCreate( vInterruptGeneratorTask, "Generator", 1000, NULL, 3, NULL );
+        xTaskCreate( vConsumerTask, "Consumer", 1000, NULL, 1, NULL );
+        xTaskCreate( vControllerTask, "Controller", 1000, NULL, configMAX_PRIORITIES - 1, NULL );
+        vPortSetInterruptHandler( mainINTERRUPT_NUMBER, ulExampleInterruptHandler );
+
+        /* Start the scheduler so the created tasks start executing. */
+        vTaskStartScheduler();
+    }
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vControllerTask( void * pvParameters )
+{
+    static const char * pcClassNames[ mainNUM_CLASSES ] = { "Bulk", "Status", "Control" };
+    uint32_t ulClass, ulOutOfOrder;
+    uint32_t ulReceivedCopy[ mainNUM_CLASSES ], ulDroppedCopy[ mainNUM_CLASSES ];
+    uint64_t ullTotalLatencyCopy[ mainNUM_CLASSES ], ullMaxLatencyCopy[ mainNUM_CLASSES ];
+    char cBuffer[ 120 ];
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* Clear the statistics.  This task has the highest priority, so no
+         * other task can update them while it runs, but the interrupt counts
+         * the control messages it drops, so the statistics are cleared, and
+         * later copied, inside a critical section. */
+        taskENTER_CRITICAL();
+        {
+            for( ulClass = 0; ulClass < mainNUM_CLASSES; ulClass++ )
+            {
+                ulReceived[ ulClass ] = 0;
+                ulDropped[ ulClass ] = 0;
+                ullTotalLatencyNs[ ulClass ] = 0;
+                ullMaxLatencyNs[ ulClass ] = 0;
+            }
+
+            ulControlOutOfOrder = 0;
+        }
+        taskEXIT_CRITICAL();
+
+        vTaskDelay( pdMS_TO_TICKS( mainTEST_DURATION_MS ) );
+
+        taskENTER_CRITICAL();
+        {
+            for( ulClass = 0; ulClass < mainNUM_CLASSES; ulClass++ )
+            {
+                ulReceivedCopy[ ulClass ] = ulReceived[ ulClass ];
+                ulDroppedCopy[ ulClass ] = ulDropped[ ulClass ];
+                ullTotalLatencyCopy[ ulClass ] = ullTotalLatencyNs[ ulClass ];
+                ullMaxLatencyCopy[ ulClass ] = ullMaxLatencyNs[ ulClass ];
+            }
+
+            ulOutOfOrder = ulControlOutOfOrder;
+        }
+        taskEXIT_CRITICAL();
+
+        vPrintString( ( xUsePriorityQueue != pdFALSE ) ? "Priority queue\r\n" : "Plain queue, control messages sent to the front\r\n" );
+        vPrintString( "Class     Received  Dropped  Mean latency (us)  Max latency (us)\r\n" );
+
+        for( ulClass = 0; ulClass < mainNUM_CLASSES; ulClass++ )
+        {
+            snprintf( cBuffer, sizeof( cBuffer ), "%-8s  %8lu  %7lu  %17lu  %16lu\r\n",
+                      pcClassNames[ ulClass ],
+                      ( unsigned long ) ulReceivedCopy[ ulClass ],
+                      ( unsigned long ) ulDroppedCopy[ ulClass ],
+                      ( unsigned long ) ( ( ulReceivedCopy[ ulClass ] != 0 ) ? ( ullTotalLatencyCopy[ ulClass ] / ulReceivedCopy[ ulClass ] / 1000ULL ) : 0ULL ),
+                      ( unsigned long ) ( ullMaxLatencyCopy[ ulClass ] / 1000ULL ) );
+            vPrintString( cBuffer );
+        }
+
+        vPrintStringAndNumber( "Control messages received out of order:", ulOutOfOrder );
+        vPrintString( "\r\n" );
+
+        /* Test the other method next. */
+        xUsePriorityQueue = ( xUsePriorityQueue != pdFALSE ) ? pdFALSE : pdTRUE;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vTelemetryTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* Send bulk messages as fast as the queue accepts them. */
+        prvSendFromTask( mainCLASS_BULK );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vStatusTask( void * pvParameters )
+{
+    const TickType_t xDelay20ms = pdMS_TO_TICKS( 20UL );
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        vTaskDelay( xDelay20ms );
+        prvSendFromTask( mainCLASS_STATUS );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvSendFromTask( uint32_t ulClass )
+{
+    static uint32_t ulSequence = 0;
+    Message_t xMessage;
+
+    taskENTER_CRITICAL();
+    {
+        xMessage.ulSequence = ulSequence;
+        ulSequence++;
+    }
+    taskEXIT_CRITICAL();
+
+    xMessage.ulClass = ulClass;
+    xMessage.ullTimeStamp = ullBenchmarkTimerGetNanoseconds();
+
+    /* Block indefinitely for space, so task messages are never dropped. */
+    if( xUsePriorityQueue != pdFALSE )
+    {
+        xPriorityQueueSend( xPriorityQueue, &xMessage, ulClass, portMAX_DELAY );
+    }
+    else
+    {
+        xQueueSendToBack( xPlainQueue, &xMessage, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vInterruptGeneratorTask( void * pvParameters )
+{
+    const TickType_t xDelay50ms = pdMS_TO_TICKS( 50UL );
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        vTaskDelay( xDelay50ms );
+        vPortGenerateSimulatedInterrupt( mainINTERRUPT_NUMBER );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t ulExampleInterruptHandler( void )
+{
+    static uint32_t ulSequence = 0;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE, xSent;
+    Message_t xMessage;
+    uint32_t ul;
+
+    xMessage.ulClass = mainCLASS_CONTROL;
+
+    for( ul = 0; ul < mainCONTROL_PER_INTERRUPT; ul++ )
+    {
+        xMessage.ulSequence = ulSequence;
+        ulSequence++;
+        xMessage.ullTimeStamp = ullBenchmarkTimerGetNanoseconds();
+
+        /* Example021 sends urgent messages to the front of the queue, which
+         * fails if the queue is full, and reverses the order of messages sent
+         * in quick succession. */
+        if( xUsePriorityQueue != pdFALSE )
+        {
+            xSent = xPriorityQueueSendFromISR( xPriorityQueue, &xMessage, mainCLASS_CONTROL, &xHigherPriorityTaskWoken );
+        }
+        else
+        {
+            xSent = xQueueSendToFrontFromISR( xPlainQueue, &xMessage, &xHigherPriorityTaskWoken );
+        }
+
+        if( xSent != pdPASS )
+        {
+            ulDropped[ mainCLASS_CONTROL ]++;
+        }
+    }
+
+    /* The implementation of portYIELD_FROM_ISR() used by the Windows port
+     * includes a return statement, which is why this function does not
+     * explicitly return a value. */
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+static void vConsumerTask( void * pvParameters )
+{
+    QueueSetMemberHandle_t xMember;
+    Message_t xMessage;
+    uint32_t ulStartTime;
+    BaseType_t xReceived;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* Wait for either queue to contain a message, then receive from the
+         * queue selected.  The priority queue returns the most urgent message
+         * it holds, irrespective of the order in which they were sent. */
+        xMember = xQueueSelectFromSet( xQueueSet, portMAX_DELAY );
+
+        if( xMember == xPriorityQueueGetSetMember( xPriorityQueue ) )
+        {
+            xReceived = xPriorityQueueReceive( xPriorityQueue, &xMessage, NULL, 0 );
+        }
+        else
+        {
+            xReceived = xQueueReceive( xPlainQueue, &xMessage, 0 );
+        }
+
+        if( xReceived == pdPASS )
+        {
+            prvRecordMessage( &xMessage );
+
+            /* Simulate the time taken to process the message. */
+            ulStartTime = ulBenchmarkTimerGetMicroseconds();
+
+            while( ( ulBenchmarkTimerGetMicroseconds() - ulStartTime ) < mainPROCESSING_TIME_US )
+            {
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordMessage( const Message_t * pxMessage )
+{
+    uint64_t ullLatencyNs = ullBenchmarkTimerGetNanoseconds() - pxMessage->ullTimeStamp;
+    uint32_t ulClass = pxMessage->ulClass;
+
+    ulReceived[ ulClass ]++;
+    ullTotalLatencyNs[ ulClass ] += ullLatencyNs;
+
+    if( ullLatencyNs > ullMaxLatencyNs[ ulClass ] )
+    {
+        ullMaxLatencyNs[ ulClass ] = ullLatencyNs;
+    }
+
+    if( ulClass == mainCLASS_CONTROL )
+    {
+        /* Control messages are numbered in the order they were sent.  Dropped
+         * messages leave gaps, but the numbers should never go backwards. */
+        if( ( ulReceived[ ulClass ] > 1 ) && ( pxMessage->ulSequence < ulLastControlSequence ) )
+        {
+            ulControlOutOfOrder++;
+        }
+
+        ulLastControlSequence = pxMessage->ulSequence;
+    }
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,230 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <memory>
+#include <utility>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo includes.  The C headers do not declare their functions with C linkage
+ * themselves, so are included within an extern "C" block. */
+extern "C"
+{
+    #include "supporting_functions.h"
+    #include "benchmark_timer.h"
+}
+#include "typed_queue.hpp"
+
+/* The length of every queue used in the benchmark. */
+#define mainQUEUE_LENGTH            8
+
+/* The number of send and receive pairs timed in each test. */
+#define mainITERATIONS              100000UL
+
+/* The items sent in each test, which are all trivially copyable. */
+struct Small
+{
+    uint32_t ulValue;
+};
+
+struct Medium
+{
+    uint32_t ulValues[ 4 ];
+};
+
+struct Large
+{
+    uint32_t ulValues[ 16 ];
+};
+
+/* A move only item, which can only be sent through a Channel.  The buffer it
+ * owns is freed when the frame is deleted. */
+struct Frame
+{
+    std::unique_ptr< uint8_t[] > pucData;
+    size_t xLength;
+};
+
+/* The task that runs the benchmark. */
+static void vBenchmarkTask( void * pvParameters );
+
+/* Time sending then receiving an item of type T using the C API and using
+ * Queue<T, N>, and print the results.  pcName names T in the results. */
+template< typename T >
+static void prvCompareQueues( const char * pcName );
+
+/* The same, for a move only item, comparing a C queue of pointers with a
+ * Channel. */
+static void prvCompareChannels( void );
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    vBenchmarkTimerInit();
+
+    xTaskCreate( vBenchmarkTask, "Benchmark", 1000, NULL, 1, NULL );
+
+    /* Start the scheduler so the created tasks start executing. */
+    vTaskStartScheduler();
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vBenchmarkTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    vPrintString( "Item    Size  C API (ns/pair)  Template (ns/pair)  C API heap (bytes)\r\n" );
+
+    prvCompareQueues< Small >( "Small" );
+    prvCompareQueues< Medium >( "Medium" );
+    prvCompareQueues< Large >( "Large" );
+    prvCompareChannels();
+
+    vPrintString( "Benchmark complete\r\n" );
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+template< typename T >
+static void prvCompareQueues( const char * pcName )
+{
+    T xItem = {}, xReceived;
+    QueueHandle_t xQueue;
+    uint64_t ullStartTime, ullCApiNs, ullTemplateNs;
+    size_t xHeapBefore, xHeapUsed;
+    uint32_t ul;
+    char cBuffer[ 100 ];
+
+    /* Using the C API, as per Example010.  The item size is passed at run time,
+     * and the queue is allocated from the FreeRTOS heap. */
+    xHeapBefore = xPortGetFreeHeapSize();
+    xQueue = xQueueCreate( mainQUEUE_LENGTH, sizeof( T ) );
+    configASSERT( xQueue != NULL );
+    xHeapUsed = xHeapBefore - xPortGetFreeHeapSize();
+
+    ullStartTime = ullBenchmarkTimerGetNanoseconds();
+
+    for( ul = 0; ul < mainITERATIONS; ul++ )
+    {
+        xQueueSendToBack( xQueue, &xItem, 0 );
+        xQueueReceive( xQueue, &xReceived, 0 );
+    }
+
+    ullCApiNs = ullBenchmarkTimerGetNanoseconds() - ullStartTime;
+    vQueueDelete( xQueue );
+
+    /* Using the template.  The queue, including its storage, is a local
+     * variable, so no heap is used, and it is deleted when it goes out of
+     * scope. */
+    {
+        FreeRTOS::Queue< T, mainQUEUE_LENGTH > xTypedQueue;
+
+        ullStartTime = ullBenchmarkTimerGetNanoseconds();
+
+        for( ul = 0; ul < mainITERATIONS; ul++ )
+        {
+            xTypedQueue.send( xItem );
+            xTypedQueue.receive( xReceived, 0 );
+        }
+
+        ullTemplateNs = ullBenchmarkTimerGetNanoseconds() - ullStartTime;
+    }
+
+    snprintf( cBuffer, sizeof( cBuffer ), "%-6s  %4lu  %15lu  %18lu  %18lu\r\n",
+              pcName,
+              ( unsigned long ) sizeof( T ),
+              ( unsigned long ) ( ullCApiNs / mainITERATIONS ),
+              ( unsigned long ) ( ullTemplateNs / mainITERATIONS ),
+              ( unsigned long ) xHeapUsed );
+    vPrintString( cBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCompareChannels( void )
+{
+    std::unique_ptr< Frame > pxFrame( new Frame );
+    Frame * pxRawFrame, * pxReceivedFrame;
+    QueueHandle_t xQueue;
+    uint64_t ullStartTime, ullCApiNs, ullTemplateNs;
+    size_t xHeapBefore, xHeapUsed;
+    uint32_t ul;
+    char cBuffer[ 100 ];
+
+    pxFrame->xLength = 1500;
+    pxFrame->pucData.reset( new uint8_t[ pxFrame->xLength ] );
+
+    /* Using the C API, a queue of pointers passes ownership of the frame by
+     * convention only - nothing stops the sender using the frame after sending
+     * it. */
+    xHeapBefore = xPortGetFreeHeapSize();
+    xQueue = xQueueCreate( mainQUEUE_LENGTH, sizeof( Frame * ) );
+    configASSERT( xQueue != NULL );
+    xHeapUsed = xHeapBefore - xPortGetFreeHeapSize();
+
+    pxRawFrame = pxFrame.get();
+    ullStartTime = ullBenchmarkTimerGetNanoseconds();
+
+    for( ul = 0; ul < mainITERATIONS; ul++ )
+    {
+        xQueueSendToBack( xQueue, &pxRawFrame, 0 );
+        xQueueReceive( xQueue, &pxReceivedFrame, 0 );
+    }
+
+    ullCApiNs = ullBenchmarkTimerGetNanoseconds() - ullStartTime;
+    vQueueDelete( xQueue );
+    configASSERT( pxReceivedFrame == pxRawFrame );
+
+    /* Using a Channel, the frame is moved into the channel by the send, leaving
+     * the sender's pointer empty, and moved out again by the receive. */
+    {
+        FreeRTOS::Channel< Frame, mainQUEUE_LENGTH > xChannel;
+
+        ullStartTime = ullBenchmarkTimerGetNanoseconds();
+
+        for( ul = 0; ul < mainITERATIONS; ul++ )
+        {
+            xChannel.send( std::move( pxFrame ) );
+            xChannel.receive( pxFrame, 0 );
+        }
+
+        ullTemplateNs = ullBenchmarkTimerGetNanoseconds() - ullStartTime;
+    }
+
+    configASSERT( pxFrame.get() == pxRawFrame );
+
+    snprintf( cBuffer, sizeof( cBuffer ), "%-6s  %4lu  %15lu  %18lu  %18lu\r\n",
+              "Frame",
+              ( unsigned long ) sizeof( Frame * ),
+              ( unsigned long ) ( ullCApiNs / mainITERATIONS ),
+              ( unsigned long ) ( ullTemplateNs / mainITERATIONS ),
+              ( unsigned long ) xHeapUsed );
+    vPrintString( cBuffer );
+}
+/*-----------------------------------------------------------*/
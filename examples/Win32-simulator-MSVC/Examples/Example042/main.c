@@ -0,0 +1,340 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "latency.h"
+#include "timer_wheel.h"
+
+/* The largest number of timers created, and the number of timers created in
+ * each test. */
+#define mainMAX_TIMERS             100000UL
+#define mainNUM_SIZES              ( sizeof( ulTimerCounts ) / sizeof( ulTimerCounts[ 0 ] ) )
+
+/* The timers in the population are given periods long enough that none of them
+ * expire during a test, so the kernel's active timer list and the wheels remain
+ * populated throughout. */
+#define mainPOPULATION_PERIOD      pdMS_TO_TICKS( 1000000UL )
+
+/* The number of randomly chosen timers reset to measure the cost of a reset. */
+#define mainRESETS_TO_TIME         1000UL
+
+/* The probe timer whose expiry latency is measured, and the number of random
+ * resets sent per tick while it runs to model connection timeouts being
+ * restarted as traffic arrives. */
+#define mainPROBE_PERIOD           pdMS_TO_TICKS( 7UL )
+#define mainPROBE_EXPIRIES         150UL
+#define mainRESETS_PER_TICK        10UL
+
+/* The task that performs the benchmark. */
+static void vBenchmarkTask( void * pvParameters );
+
+/* Run one test, populating the selected timer service with ulNumTimers
+ * timers. */
+static void prvRunTest( BaseType_t xUseWheel,
+                        uint32_t ulNumTimers );
+
+/* Wrappers that send a command to whichever timer service is being tested. */
+static void prvCreateAndStart( BaseType_t xUseWheel,
+                               uint32_t ulTimer,
+                               TickType_t xPeriod );
+static void prvReset( BaseType_t xUseWheel,
+                      uint32_t ulTimer );
+static void prvDelete( BaseType_t xUseWheel,
+                       uint32_t ulTimer );
+
+/* The timer callbacks. */
+static void prvKernelPopulationCallback( TimerHandle_t xTimer );
+static void prvWheelPopulationCallback( TimerWheelHandle_t xTimer );
+static void prvKernelProbeCallback( TimerHandle_t xTimer );
+static void prvWheelProbeCallback( TimerWheelHandle_t xTimer );
+
+/* Record the latency of one expiry of the probe timer. */
+static void prvRecordProbeExpiry( void );
+
+/* A simple xorshift pseudo random number generator, so both timer services are
+ * sent the same sequence of resets. */
+static uint32_t prvRand( void );
+
+/*-----------------------------------------------------------*/
+
+/* The population sizes tested. */
+static const uint32_t ulTimerCounts[] = { 10UL, 100UL, 1000UL, 10000UL, 100000UL };
+
+/* The population.  Index mainMAX_TIMERS is the probe timer. */
+static TimerHandle_t xKernelTimers[ mainMAX_TIMERS + 1 ];
+static TimerWheelHandle_t xWheelTimers[ mainMAX_TIMERS + 1 ];
+
+/* Written by the probe timer's callback. */
+static TickType_t xProbeStartTick = 0;
+static volatile uint32_t ulProbeExpiries = 0;
+static uint64_t ullTotalLatencyUs = 0;
+static uint32_t ulMaxLatencyUs = 0;
+
+static uint32_t ulRandomState = 1;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    vBenchmarkTimerInit();
+
+    /* The timing wheel service has the same priority as the kernel's timer
+     * service task.  The benchmark task has a lower priority than both, so
+     * each command is processed as soon as it is sent, and the time taken to
+     * send a command includes the time taken to process it. */
+    xTimerWheelServiceStart( configTIMER_TASK_PRIORITY );
+    xTaskCreate( vBenchmarkTask, "Benchmark", 1000, NULL, configTIMER_TASK_PRIORITY - 1, NULL );
+
+    /* Start the scheduler so the created tasks start executing. */
+    vTaskStartScheduler();
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vBenchmarkTask( void * pvParameters )
+{
+    size_t x;
+
+    ( void ) pvParameters;
+
+    vPrintString( "Service        Timers  Start (ns)  Reset (ns)  Mean latency (us)  Max latency (us)\r\n" );
+
+    for( x = 0; x < mainNUM_SIZES; x++ )
+    {
+        prvRunTest( pdFALSE, ulTimerCounts[ x ] );
+        prvRunTest( pdTRUE, ulTimerCounts[ x ] );
+    }
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunTest( BaseType_t xUseWheel,
+                        uint32_t ulNumTimers )
+{
+    uint64_t ullStartTime, ullStartNs, ullResetNs;
+    uint32_t ul;
+    char cBuffer[ 120 ];
+
+    ulRandomState = 1;
+
+    /* Populate the timer service.  Each timer is given a slightly shorter
+     * period than the one before, so each new timer expires before all those
+     * already running and the kernel inserts it at the front of its sorted
+     * active timer list.  This is the best case for the kernel, so the cost of
+     * starting a timer is the cost of sending and processing the command. */
+    ullStartTime = ullBenchmarkTimerGetNanoseconds();
+
+    for( ul = 0; ul < ulNumTimers; ul++ )
+    {
+        prvCreateAndStart( xUseWheel, ul, mainPOPULATION_PERIOD + ( ulNumTimers - ul ) );
+    }
+
+    ullStartNs = ( ullBenchmarkTimerGetNanoseconds() - ullStartTime ) / ulNumTimers;
+
+    /* Reset randomly chosen timers.  The population's expiry times only span
+     * ulNumTimers ticks from when they were started, so a timer reset after
+     * that expires after nearly all of them.  The kernel searches its sorted
+     * active timer list from the front, so each reset walks almost the whole
+     * list - the worst case for the kernel.  The timing wheel places the timer
+     * in a slot without searching, so the position makes no difference to it. */
+    ullStartTime = ullBenchmarkTimerGetNanoseconds();
+
+    for( ul = 0; ul < mainRESETS_TO_TIME; ul++ )
+    {
+        prvReset( xUseWheel, prvRand() % ulNumTimers );
+    }
+
+    ullResetNs = ( ullBenchmarkTimerGetNanoseconds() - ullStartTime ) / mainRESETS_TO_TIME;
+
+    /* Measure the latency of the probe timer while resets continue at a lower
+     * rate.  The probe timer is started just after a tick, so its period is
+     * measured from the tick count read here. */
+    ulProbeExpiries = 0;
+    ullTotalLatencyUs = 0;
+    ulMaxLatencyUs = 0;
+    vTaskDelay( 1 );
+    xProbeStartTick = xTaskGetTickCount();
+    prvCreateAndStart( xUseWheel, mainMAX_TIMERS, mainPROBE_PERIOD );
+
+    while( ulProbeExpiries < mainPROBE_EXPIRIES )
+    {
+        for( ul = 0; ul < mainRESETS_PER_TICK; ul++ )
+        {
+            prvReset( xUseWheel, prvRand() % ulNumTimers );
+        }
+
+        vTaskDelay( 1 );
+    }
+
+    /* Delete the probe timer and the population, so the heap is free for the
+     * next test. */
+    prvDelete( xUseWheel, mainMAX_TIMERS );
+
+    for( ul = 0; ul < ulNumTimers; ul++ )
+    {
+        prvDelete( xUseWheel, ul );
+    }
+
+    snprintf( cBuffer, sizeof( cBuffer ), "%-13s  %6lu  %10lu  %10lu  %17lu  %16lu\r\n",
+              ( xUseWheel != pdFALSE ) ? "Timing wheel" : "Kernel timers",
+              ( unsigned long ) ulNumTimers,
+              ( unsigned long ) ullStartNs,
+              ( unsigned long ) ullResetNs,
+              ( unsigned long ) ( ullTotalLatencyUs / mainPROBE_EXPIRIES ),
+              ( unsigned long ) ulMaxLatencyUs );
+    vPrintString( cBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCreateAndStart( BaseType_t xUseWheel,
+                               uint32_t ulTimer,
+                               TickType_t xPeriod )
+{
+    BaseType_t xProbe = ( ulTimer == mainMAX_TIMERS ) ? pdTRUE : pdFALSE;
+
+    if( xUseWheel != pdFALSE )
+    {
+        xWheelTimers[ ulTimer ] = xTimerWheelCreate( "Wheel", xPeriod, xProbe, NULL,
+                                                     ( xProbe != pdFALSE ) ? prvWheelProbeCallback : prvWheelPopulationCallback );
+        configASSERT( xWheelTimers[ ulTimer ] != NULL );
+        xTimerWheelStart( xWheelTimers[ ulTimer ], portMAX_DELAY );
+    }
+    else
+    {
+        xKernelTimers[ ulTimer ] = xTimerCreate( "Kernel", xPeriod, xProbe, NULL,
+                                                 ( xProbe != pdFALSE ) ? prvKernelProbeCallback : prvKernelPopulationCallback );
+        configASSERT( xKernelTimers[ ulTimer ] != NULL );
+        xTimerStart( xKernelTimers[ ulTimer ], portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvReset( BaseType_t xUseWheel,
+                      uint32_t ulTimer )
+{
+    if( xUseWheel != pdFALSE )
+    {
+        xTimerWheelReset( xWheelTimers[ ulTimer ], portMAX_DELAY );
+    }
+    else
+    {
+        xTimerReset( xKernelTimers[ ulTimer ], portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvDelete( BaseType_t xUseWheel,
+                       uint32_t ulTimer )
+{
+    if( xUseWheel != pdFALSE )
+    {
+        xTimerWheelDelete( xWheelTimers[ ulTimer ], portMAX_DELAY );
+    }
+    else
+    {
+        xTimerDelete( xKernelTimers[ ulTimer ], portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvKernelPopulationCallback( TimerHandle_t xTimer )
+{
+    /* The population's periods are chosen so this is never called. */
+    ( void ) xTimer;
+    configASSERT( pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWheelPopulationCallback( TimerWheelHandle_t xTimer )
+{
+    ( void ) xTimer;
+    configASSERT( pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvKernelProbeCallback( TimerHandle_t xTimer )
+{
+    ( void ) xTimer;
+    prvRecordProbeExpiry();
+}
+/*-----------------------------------------------------------*/
+
+static void prvWheelProbeCallback( TimerWheelHandle_t xTimer )
+{
+    ( void ) xTimer;
+    prvRecordProbeExpiry();
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordProbeExpiry( void )
+{
+    TickType_t xExpiryTick;
+    uint32_t ulTickTimeUs, ulLatencyUs;
+
+    /* The latency is measured from the tick interrupt that made the timer
+     * expire.  Both timer services process expiries that were missed because
+     * the service was busy, so the expiry tick is always known.  If the time of
+     * that tick has been overwritten the callback is very late, so the latency
+     * is calculated from the tick count. */
+    xExpiryTick = xProbeStartTick + ( ( ulProbeExpiries + 1UL ) * mainPROBE_PERIOD );
+
+    if( xLatencyGetTickTime( xExpiryTick, &ulTickTimeUs ) != pdFAIL )
+    {
+        ulLatencyUs = ulBenchmarkTimerGetMicroseconds() - ulTickTimeUs;
+    }
+    else
+    {
+        ulLatencyUs = ( uint32_t ) ( xTaskGetTickCount() - xExpiryTick ) * portTICK_PERIOD_MS * 1000UL;
+    }
+
+    ullTotalLatencyUs += ulLatencyUs;
+
+    if( ulLatencyUs > ulMaxLatencyUs )
+    {
+        ulMaxLatencyUs = ulLatencyUs;
+    }
+
+    ulProbeExpiries++;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+    ulRandomState ^= ulRandomState << 13;
+    ulRandomState ^= ulRandomState >> 17;
+    ulRandomState ^= ulRandomState << 5;
+
+    return ulRandomState;
+}
+/*-----------------------------------------------------------*/
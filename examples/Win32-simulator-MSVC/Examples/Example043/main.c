@@ -0,0 +1,314 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "timer_wheel.h"
+
+/* The number of the simulated interrupt used in this example.  Numbers 0 to 2
+ * are used by the FreeRTOS Windows port itself, so 3 is the first number available
+ * to the application. */
+#define mainINTERRUPT_NUMBER          3
+
+/* Timer 0 is the backlight timer from Example015.  Timers 1 to 3 are timeouts
+ * that are reset by other parts of the application. */
+#define mainNUM_TIMERS                4
+#define mainTIMER_PERIOD              pdMS_TO_TICKS( 20UL )
+
+/* Each burst models a key bouncing, or being held down with auto repeat, so
+ * the backlight timer is reset many times in quick succession.  The other
+ * timers are each reset once at the end of the burst.  Bursts are sent more
+ * often than the timers' period, so no timer should expire until the bursts
+ * stop. */
+#define mainBACKLIGHT_RESETS          48UL
+#define mainNUM_BURSTS                100UL
+#define mainBURST_INTERVAL            pdMS_TO_TICKS( 5UL )
+
+/* The task that performs the benchmark. */
+static void vBenchmarkTask( void * pvParameters );
+
+/* Run one test, sending bursts either from a task or from an interrupt. */
+static void prvRunTest( BaseType_t xUseWheel,
+                        BaseType_t xFromISR );
+
+/* Send one burst of resets from a task. */
+static void prvSendBurst( void );
+
+/* The service routine for the (simulated) interrupt, which sends a burst of
+ * resets. */
+static uint32_t ulExampleInterruptHandler( void );
+
+/* The timer callbacks. */
+static void prvKernelTimerCallback( TimerHandle_t xTimer );
+static void prvWheelTimerCallback( TimerWheelHandle_t xTimer );
+
+/* Count an expiry of one of the timers. */
+static void prvRecordExpiry( void );
+
+/*-----------------------------------------------------------*/
+
+static TimerHandle_t xKernelTimers[ mainNUM_TIMERS ];
+static TimerWheelHandle_t xWheelTimers[ mainNUM_TIMERS ];
+
+/* Selects the timer service the bursts are sent to. */
+static volatile BaseType_t xUseWheel = pdFALSE;
+
+/* Updated by whichever task or interrupt is sending the bursts. */
+static volatile uint32_t ulCommandsSent = 0;
+static volatile uint32_t ulCommandsFailed = 0;
+
+/* Updated by the timer callbacks.  A timer that expires while bursts are still
+ * being sent only expired because a reset was lost. */
+static volatile BaseType_t xBursting = pdFALSE;
+static volatile uint32_t ulExpiries = 0;
+static volatile uint32_t ulEarlyExpiries = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    BaseType_t x;
+
+    for( x = 0; x < mainNUM_TIMERS; x++ )
+    {
+        xKernelTimers[ x ] = xTimerCreate( "Kernel", mainTIMER_PERIOD, pdFALSE, NULL, prvKernelTimerCallback );
+        xWheelTimers[ x ] = xTimerWheelCreate( "Wheel", mainTIMER_PERIOD, pdFALSE, NULL, prvWheelTimerCallback );
+        configASSERT( ( xKernelTimers[ x ] != NULL ) && ( xWheelTimers[ x ] != NULL ) );
+    }
+
+    /* The timing wheel service has the same priority as the kernel's timer
+     * service task, and so does the benchmark task.  The timer services are
+     * therefore not scheduled while the benchmark task is sending a burst, as
+     * happens when the sender has a higher priority than the timer service, or
+     * when a burst is sent from an interrupt. */
+    xTimerWheelServiceStart( configTIMER_TASK_PRIORITY );
+    xTaskCreate( vBenchmarkTask, "Benchmark", 1000, NULL, configTIMER_TASK_PRIORITY, NULL );
+
+    /* Install the handler for the software interrupt.  The syntax necessary
+     * to do this is dependent on the FreeRTOS port being used.  The syntax
+     * shown here can only be used with the FreeRTOS Windows port, where such
+     * interrupts are only simulated. */
+    vPortSetInterruptHandler( mainINTERRUPT_NUMBER, ulExampleInterruptHandler );
+
+    /* Start the scheduler so the created tasks start executing. */
+    vTaskStartScheduler();
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vBenchmarkTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    vPrintString( "Service        Sender     Commands  Queue full  Coalesced  Max pending  Early expiries\r\n" );
+
+    prvRunTest( pdFALSE, pdFALSE );
+    prvRunTest( pdTRUE, pdFALSE );
+    prvRunTest( pdFALSE, pdTRUE );
+    prvRunTest( pdTRUE, pdTRUE );
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunTest( BaseType_t xWheel,
+                        BaseType_t xFromISR )
+{
+    TimerWheelStats_t xStatsBefore, xStatsAfter;
+    char cBuffer[ 120 ], cCoalesced[ 12 ], cMaxPending[ 12 ];
+    uint32_t ulBurst;
+    BaseType_t x;
+
+    xUseWheel = xWheel;
+    ulCommandsSent = 0;
+    ulCommandsFailed = 0;
+    ulExpiries = 0;
+    ulEarlyExpiries = 0;
+    vTimerWheelResetMaxPending();
+    vTimerWheelGetStats( &xStatsBefore );
+
+    /* The timeouts are already running when the first burst is sent. */
+    for( x = 0; x < mainNUM_TIMERS; x++ )
+    {
+        if( xWheel != pdFALSE )
+        {
+            xTimerWheelStart( xWheelTimers[ x ], portMAX_DELAY );
+        }
+        else
+        {
+            xTimerStart( xKernelTimers[ x ], portMAX_DELAY );
+        }
+    }
+
+    vTaskDelay( 1 );
+    xBursting = pdTRUE;
+
+    for( ulBurst = 0; ulBurst < mainNUM_BURSTS; ulBurst++ )
+    {
+        if( xFromISR != pdFALSE )
+        {
+            /* The syntax used to generate a software interrupt is dependent on
+             * the FreeRTOS port being used.  The syntax used below can only be
+             * used with the FreeRTOS Windows port, in which such interrupts are
+             * only simulated. */
+            vPortGenerateSimulatedInterrupt( mainINTERRUPT_NUMBER );
+        }
+        else
+        {
+            prvSendBurst();
+        }
+
+        /* Let the timer service process the burst. */
+        vTaskDelay( mainBURST_INTERVAL );
+    }
+
+    /* Every timer should now expire once, a period after the last burst. */
+    xBursting = pdFALSE;
+    vTaskDelay( mainTIMER_PERIOD * 2 );
+
+    if( xWheel != pdFALSE )
+    {
+        /* The wheel's counts accumulate, so only the change is printed.  The
+         * high water mark was reset at the start of the test. */
+        vTimerWheelGetStats( &xStatsAfter );
+        snprintf( cCoalesced, sizeof( cCoalesced ), "%lu", ( unsigned long ) ( xStatsAfter.ulCommandsCoalesced - xStatsBefore.ulCommandsCoalesced ) );
+        snprintf( cMaxPending, sizeof( cMaxPending ), "%lu", ( unsigned long ) xStatsAfter.uxMaxPending );
+    }
+    else
+    {
+        snprintf( cCoalesced, sizeof( cCoalesced ), "-" );
+        snprintf( cMaxPending, sizeof( cMaxPending ), "-" );
+    }
+
+    snprintf( cBuffer, sizeof( cBuffer ), "%-13s  %-9s  %8lu  %10lu  %9s  %11s  %14lu\r\n",
+              ( xWheel != pdFALSE ) ? "Timing wheel" : "Kernel timers",
+              ( xFromISR != pdFALSE ) ? "Interrupt" : "Task",
+              ( unsigned long ) ulCommandsSent,
+              ( unsigned long ) ulCommandsFailed,
+              cCoalesced,
+              cMaxPending,
+              ( unsigned long ) ulEarlyExpiries );
+    vPrintString( cBuffer );
+
+    /* A timer whose last reset was lost expires early, and again after the
+     * bursts stop only if a later reset got through, so the total number of
+     * expiries is only known when no commands were lost. */
+    configASSERT( ( ulCommandsFailed != 0 ) || ( ulExpiries == mainNUM_TIMERS ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSendBurst( void )
+{
+    uint32_t ul;
+    BaseType_t xTimer, xResult;
+
+    /* The block time is 0 as a task that is handling key presses cannot wait
+     * for the timer service. */
+    for( ul = 0; ul < ( mainBACKLIGHT_RESETS + mainNUM_TIMERS - 1 ); ul++ )
+    {
+        xTimer = ( ul < mainBACKLIGHT_RESETS ) ? 0 : ( BaseType_t ) ( ul - mainBACKLIGHT_RESETS + 1 );
+
+        if( xUseWheel != pdFALSE )
+        {
+            xResult = xTimerWheelReset( xWheelTimers[ xTimer ], 0 );
+        }
+        else
+        {
+            xResult = xTimerReset( xKernelTimers[ xTimer ], 0 );
+        }
+
+        ulCommandsSent++;
+
+        if( xResult != pdPASS )
+        {
+            ulCommandsFailed++;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t ulExampleInterruptHandler( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE, xTimer, xResult;
+    uint32_t ul;
+
+    for( ul = 0; ul < ( mainBACKLIGHT_RESETS + mainNUM_TIMERS - 1 ); ul++ )
+    {
+        xTimer = ( ul < mainBACKLIGHT_RESETS ) ? 0 : ( BaseType_t ) ( ul - mainBACKLIGHT_RESETS + 1 );
+
+        if( xUseWheel != pdFALSE )
+        {
+            xResult = xTimerWheelResetFromISR( xWheelTimers[ xTimer ], &xHigherPriorityTaskWoken );
+        }
+        else
+        {
+            xResult = xTimerResetFromISR( xKernelTimers[ xTimer ], &xHigherPriorityTaskWoken );
+        }
+
+        ulCommandsSent++;
+
+        if( xResult != pdPASS )
+        {
+            ulCommandsFailed++;
+        }
+    }
+
+    /* The implementation of portYIELD_FROM_ISR() used by the Windows port
+     * includes a return statement, which is why this function does not
+     * explicitly return a value. */
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+static void prvKernelTimerCallback( TimerHandle_t xTimer )
+{
+    ( void ) xTimer;
+    prvRecordExpiry();
+}
+/*-----------------------------------------------------------*/
+
+static void prvWheelTimerCallback( TimerWheelHandle_t xTimer )
+{
+    ( void ) xTimer;
+    prvRecordExpiry();
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordExpiry( void )
+{
+    if( xBursting != pdFALSE )
+    {
+        ulEarlyExpiries++;
+    }
+
+    ulExpiries++;
+}
+/*-----------------------------------------------------------*/
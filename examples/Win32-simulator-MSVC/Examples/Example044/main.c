@@ -0,0 +1,233 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "timer_stats.h"
+
+/* The number of the simulated interrupt used in this example.  Numbers 0 to 2
+ * are used by the FreeRTOS Windows port itself, so 3 is the first number available
+ * to the application. */
+#define mainINTERRUPT_NUMBER          3
+
+/* The timers' periods.  The backlight and watchdog timers are reset before they
+ * expire, so only expire if a reset is delayed. */
+#define mainCONTROL_TIMER_PERIOD      pdMS_TO_TICKS( 10UL )
+#define mainLOGGER_TIMER_PERIOD       pdMS_TO_TICKS( 100UL )
+#define mainBACKLIGHT_TIMER_PERIOD    pdMS_TO_TICKS( 50UL )
+#define mainWATCHDOG_TIMER_PERIOD     pdMS_TO_TICKS( 30UL )
+
+/* The logger timer's callback does far more work than a timer callback should,
+ * as per the work done by prvAutoReloadTimerCallback() were it to write to a
+ * slow peripheral.  It delays every other timer that expires while it executes.
+ * Such work should be deferred to a task. */
+#define mainLOGGER_WORK_US            15000UL
+
+/* How often the watchdog interrupt occurs, and the longest gap between key
+ * presses. */
+#define mainWATCHDOG_KICK_PERIOD      pdMS_TO_TICKS( 10UL )
+#define mainMAX_KEY_GAP_MS            35UL
+
+/* How often the statistics are printed. */
+#define mainREPORT_PERIOD             pdMS_TO_TICKS( 5000UL )
+
+/* The timer callbacks. */
+static void prvControlTimerCallback( TimerHandle_t xTimer );
+static void prvLoggerTimerCallback( TimerHandle_t xTimer );
+static void prvBacklightTimerCallback( TimerHandle_t xTimer );
+static void prvWatchdogTimerCallback( TimerHandle_t xTimer );
+
+/* The tasks that reset the backlight timer, and generate the interrupt that
+ * resets the watchdog timer. */
+static void vKeyPressTask( void * pvParameters );
+static void vInterruptGeneratorTask( void * pvParameters );
+
+/* The service routine for the (simulated) interrupt. */
+static uint32_t ulExampleInterruptHandler( void );
+
+/* Execute for ulMicroseconds without blocking. */
+static void prvBusyWait( uint32_t ulMicroseconds );
+
+/* A simple xorshift pseudo random number generator, used to vary the time
+ * between key presses. */
+static uint32_t prvRand( void );
+
+/*-----------------------------------------------------------*/
+
+static TimerHandle_t xBacklightTimer, xWatchdogTimer;
+
+/* Counts of the timer expiries, so the callbacks have something to do. */
+static volatile uint32_t ulControlExpiries = 0;
+static volatile uint32_t ulBacklightOffCount = 0;
+static volatile uint32_t ulWatchdogTimeouts = 0;
+
+static uint32_t ulRandomState = 1;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    TimerHandle_t xControlTimer, xLoggerTimer;
+
+    vBenchmarkTimerInit();
+
+    /* Create the timers with xTimerStatsCreate() in place of xTimerCreate(), so
+     * their statistics are gathered. */
+    xControlTimer = xTimerStatsCreate( "Control", mainCONTROL_TIMER_PERIOD, pdTRUE, NULL, prvControlTimerCallback );
+    xLoggerTimer = xTimerStatsCreate( "Logger", mainLOGGER_TIMER_PERIOD, pdTRUE, NULL, prvLoggerTimerCallback );
+    xBacklightTimer = xTimerStatsCreate( "Backlight", mainBACKLIGHT_TIMER_PERIOD, pdFALSE, NULL, prvBacklightTimerCallback );
+    xWatchdogTimer = xTimerStatsCreate( "Watchdog", mainWATCHDOG_TIMER_PERIOD, pdFALSE, NULL, prvWatchdogTimerCallback );
+
+    if( ( xControlTimer != NULL ) && ( xLoggerTimer != NULL ) && ( xBacklightTimer != NULL ) && ( xWatchdogTimer != NULL ) )
+    {
+        /* The timers are started before the scheduler, so the block time is 0. */
+        xTimerStart( xControlTimer, 0 );
+        xTimerStart( xLoggerTimer, 0 );
+        xTimerStart( xBacklightTimer, 0 );
+        xTimerStart( xWatchdogTimer, 0 );
+
+        /* Both tasks have a lower priority than the timer service task, so
+         * their commands are received as soon as they are sent unless the
+         * timer service task is executing a callback. */
+        xTaskCreate( vKeyPressTask, "Keys", 1000, NULL, 2, NULL );
+        xTaskCreate( vInterruptGeneratorTask, "IntGen", 1000, NULL, 2, NULL );
+        xTimerStatsStartReporter( mainREPORT_PERIOD, 1 );
+
+        /* Install the handler for the software interrupt.  The syntax necessary
+         * to do this is dependent on the FreeRTOS port being used.  The syntax
+         * shown here can only be used with the FreeRTOS Windows port, where such
+         * interrupts are only simulated. */
+        vPortSetInterruptHandler( mainINTERRUPT_NUMBER, ulExampleInterruptHandler );
+
+        /* Start the scheduler so the created tasks start executing. */
+        vTaskStartScheduler();
+    }
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTimerCallback( TimerHandle_t xTimer )
+{
+    ( void ) xTimer;
+    ulControlExpiries++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvLoggerTimerCallback( TimerHandle_t xTimer )
+{
+    ( void ) xTimer;
+    prvBusyWait( mainLOGGER_WORK_US );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBacklightTimerCallback( TimerHandle_t xTimer )
+{
+    /* The backlight times out if no key has been pressed for a period. */
+    ( void ) xTimer;
+    ulBacklightOffCount++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWatchdogTimerCallback( TimerHandle_t xTimer )
+{
+    /* The watchdog is kicked three times per period, so only times out if the
+     * commands sent from the interrupt wait too long. */
+    ( void ) xTimer;
+    ulWatchdogTimeouts++;
+}
+/*-----------------------------------------------------------*/
+
+static void vKeyPressTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* Simulate key presses at random intervals, each of which resets the
+         * backlight timer, as per Example015. */
+        vTaskDelay( pdMS_TO_TICKS( 1UL + ( prvRand() % mainMAX_KEY_GAP_MS ) ) );
+        xTimerReset( xBacklightTimer, 0 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vInterruptGeneratorTask( void * pvParameters )
+{
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        vTaskDelayUntil( &xLastWakeTime, mainWATCHDOG_KICK_PERIOD );
+
+        /* The syntax used to generate a software interrupt is dependent on the
+         * FreeRTOS port being used.  The syntax used below can only be used with
+         * the FreeRTOS Windows port, in which such interrupts are only
+         * simulated. */
+        vPortGenerateSimulatedInterrupt( mainINTERRUPT_NUMBER );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t ulExampleInterruptHandler( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    xTimerResetFromISR( xWatchdogTimer, &xHigherPriorityTaskWoken );
+
+    /* The implementation of portYIELD_FROM_ISR() used by the Windows port
+     * includes a return statement, which is why this function does not
+     * explicitly return a value. */
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBusyWait( uint32_t ulMicroseconds )
+{
+    uint32_t ulStart = ulBenchmarkTimerGetMicroseconds();
+
+    while( ( ulBenchmarkTimerGetMicroseconds() - ulStart ) < ulMicroseconds )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+    ulRandomState ^= ulRandomState << 13;
+    ulRandomState ^= ulRandomState >> 17;
+    ulRandomState ^= ulRandomState << 5;
+
+    return ulRandomState;
+}
+/*-----------------------------------------------------------*/
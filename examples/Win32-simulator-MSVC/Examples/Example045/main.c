@@ -0,0 +1,243 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "latency.h"
+#include "timer_offload.h"
+
+/* The fast timers, whose expiry latency is measured.  Their periods have no
+ * common factor, so they expire at many different points in the slow timer's
+ * period. */
+#define mainNUM_FAST_TIMERS          3
+#define mainNUM_MODES                3
+
+/* The slow timer's callback takes a large part of its period, as per the work
+ * done by prvAutoReloadTimerCallback() were it to write to a slow peripheral. */
+#define mainSLOW_TIMER_PERIOD        pdMS_TO_TICKS( 50UL )
+#define mainSLOW_WORK_US             10000UL
+
+/* How long each test runs for. */
+#define mainTEST_DURATION            pdMS_TO_TICKS( 3000UL )
+
+/* The ways the slow timer is run in each test. */
+typedef enum
+{
+    eNoSlowTimer = 0,
+    eSlowTimerInline,   /* The slow callback executes in the timer service task. */
+    eSlowTimerOffloaded /* The slow callback executes in a worker task. */
+} SlowTimerMode_t;
+
+/* The task that performs the benchmark. */
+static void vBenchmarkTask( void * pvParameters );
+
+/* The timer callbacks. */
+static void prvFastTimerCallback( TimerHandle_t xTimer );
+static void prvSlowTimerCallback( TimerHandle_t xTimer );
+
+/* Execute for ulMicroseconds without blocking. */
+static void prvBusyWait( uint32_t ulMicroseconds );
+
+/*-----------------------------------------------------------*/
+
+static const TickType_t xFastTimerPeriods[ mainNUM_FAST_TIMERS ] = { pdMS_TO_TICKS( 5UL ), pdMS_TO_TICKS( 7UL ), pdMS_TO_TICKS( 11UL ) };
+static const char * const pcModeNames[ mainNUM_MODES ] = { "None", "In timer task", "Offloaded" };
+
+/* The pool the slow timer's callback is offloaded to.  Its priority is below
+ * that of the timer service task. */
+static TimerOffloadPoolHandle_t xWorkerPool;
+
+/* Written by the fast timer callbacks. */
+static TickType_t xNextExpiry[ mainNUM_FAST_TIMERS ];
+static uint32_t ulFastExpiries = 0;
+static uint64_t ullTotalLatencyUs = 0;
+static uint32_t ulMaxLatencyUs = 0;
+
+/* Written by the slow timer callback. */
+static volatile uint32_t ulSlowExecutions = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    vBenchmarkTimerInit();
+
+    xWorkerPool = xTimerOffloadCreatePool( "Worker", 1, 1, 4 );
+    configASSERT( xWorkerPool != NULL );
+
+    /* The benchmark task has a lower priority than the timer service task, so
+     * each command it sends is processed as soon as it is sent. */
+    xTaskCreate( vBenchmarkTask, "Benchmark", 1000, NULL, configTIMER_TASK_PRIORITY - 1, NULL );
+
+    /* Start the scheduler so the created tasks start executing. */
+    vTaskStartScheduler();
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vBenchmarkTask( void * pvParameters )
+{
+    TimerHandle_t xFastTimers[ mainNUM_FAST_TIMERS ], xSlowTimer = NULL;
+    TimerOffloadPoolStats_t xStatsBefore, xStatsAfter;
+    SlowTimerMode_t eMode;
+    size_t x;
+    char cBuffer[ 120 ];
+
+    ( void ) pvParameters;
+
+    vPrintString( "Slow callback   Mean latency (us)  Max latency (us)  Slow executions  Overruns\r\n" );
+
+    for( eMode = eNoSlowTimer; eMode < mainNUM_MODES; eMode++ )
+    {
+        ulFastExpiries = 0;
+        ullTotalLatencyUs = 0;
+        ulMaxLatencyUs = 0;
+        ulSlowExecutions = 0;
+        vTimerOffloadGetPoolStats( xWorkerPool, &xStatsBefore );
+
+        if( eMode == eSlowTimerInline )
+        {
+            xSlowTimer = xTimerCreate( "Slow", mainSLOW_TIMER_PERIOD, pdTRUE, NULL, prvSlowTimerCallback );
+        }
+        else if( eMode == eSlowTimerOffloaded )
+        {
+            /* The only change needed to offload the callback. */
+            xSlowTimer = xTimerOffloadCreate( "Slow", mainSLOW_TIMER_PERIOD, pdTRUE, NULL, prvSlowTimerCallback, xWorkerPool );
+        }
+
+        if( xSlowTimer != NULL )
+        {
+            xTimerStart( xSlowTimer, portMAX_DELAY );
+        }
+
+        /* Each fast timer's first expiry is a period after the tick in which it
+         * is started.  Starting the timers just after a tick makes it unlikely
+         * the tick count changes before the start command is sent. */
+        vTaskDelay( 1 );
+
+        for( x = 0; x < mainNUM_FAST_TIMERS; x++ )
+        {
+            xFastTimers[ x ] = xTimerCreate( "Fast", xFastTimerPeriods[ x ], pdTRUE, ( void * ) x, prvFastTimerCallback );
+            configASSERT( xFastTimers[ x ] != NULL );
+            xNextExpiry[ x ] = xTaskGetTickCount() + xFastTimerPeriods[ x ];
+            xTimerStart( xFastTimers[ x ], portMAX_DELAY );
+        }
+
+        vTaskDelay( mainTEST_DURATION );
+
+        for( x = 0; x < mainNUM_FAST_TIMERS; x++ )
+        {
+            xTimerDelete( xFastTimers[ x ], portMAX_DELAY );
+        }
+
+        if( eMode == eSlowTimerInline )
+        {
+            xTimerDelete( xSlowTimer, portMAX_DELAY );
+        }
+        else if( eMode == eSlowTimerOffloaded )
+        {
+            /* An offloaded timer cannot be deleted while its callback is
+             * executing, so stop it and wait for the worker to finish. */
+            xTimerStop( xSlowTimer, portMAX_DELAY );
+
+            do
+            {
+                vTaskDelay( mainSLOW_TIMER_PERIOD );
+                vTimerOffloadGetPoolStats( xWorkerPool, &xStatsAfter );
+            } while( xStatsAfter.ulCompleted != xStatsAfter.ulDispatched );
+
+            xTimerOffloadDelete( xSlowTimer, portMAX_DELAY );
+        }
+
+        xSlowTimer = NULL;
+        vTimerOffloadGetPoolStats( xWorkerPool, &xStatsAfter );
+
+        snprintf( cBuffer, sizeof( cBuffer ), "%-14s  %17lu  %16lu  %15lu  %8lu\r\n",
+                  pcModeNames[ eMode ],
+                  ( unsigned long ) ( ( ulFastExpiries > 0 ) ? ( ullTotalLatencyUs / ulFastExpiries ) : 0 ),
+                  ( unsigned long ) ulMaxLatencyUs,
+                  ( unsigned long ) ulSlowExecutions,
+                  ( unsigned long ) ( xStatsAfter.ulOverruns - xStatsBefore.ulOverruns ) );
+        vPrintString( cBuffer );
+    }
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFastTimerCallback( TimerHandle_t xTimer )
+{
+    size_t x = ( size_t ) pvTimerGetTimerID( xTimer );
+    uint32_t ulTickTimeUs, ulLatency;
+
+    /* The kernel calls the callback once for every period that has passed, so
+     * the tick on which this expiry was due is always known.  If the time of
+     * that tick has been overwritten the callback is very late, so the latency
+     * is calculated from the tick count. */
+    if( xLatencyGetTickTime( xNextExpiry[ x ], &ulTickTimeUs ) != pdFAIL )
+    {
+        ulLatency = ulBenchmarkTimerGetMicroseconds() - ulTickTimeUs;
+    }
+    else
+    {
+        ulLatency = ( xTaskGetTickCount() - xNextExpiry[ x ] ) * portTICK_PERIOD_MS * 1000UL;
+    }
+
+    xNextExpiry[ x ] += xFastTimerPeriods[ x ];
+    ullTotalLatencyUs += ulLatency;
+
+    if( ulLatency > ulMaxLatencyUs )
+    {
+        ulMaxLatencyUs = ulLatency;
+    }
+
+    ulFastExpiries++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSlowTimerCallback( TimerHandle_t xTimer )
+{
+    ( void ) xTimer;
+    prvBusyWait( mainSLOW_WORK_US );
+    ulSlowExecutions++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBusyWait( uint32_t ulMicroseconds )
+{
+    uint32_t ulStart = ulBenchmarkTimerGetMicroseconds();
+
+    while( ( ulBenchmarkTimerGetMicroseconds() - ulStart ) < ulMicroseconds )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,258 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "deferred_work.h"
+
+/* The number of the simulated interrupt used in this example.  Numbers 0 to 2
+ * are used by the FreeRTOS Windows port itself, so 3 is the first number available
+ * to the application. */
+#define mainINTERRUPT_NUMBER         3
+
+/* The deferred work service's ring holds more entries than the timer command
+ * queue, which has configTIMER_QUEUE_LENGTH entries, and executes up to
+ * mainBATCH_SIZE functions each time it runs. */
+#define mainRING_LENGTH              64
+#define mainBATCH_SIZE               16
+
+/* The number of bursts of interrupts generated for each burst size. */
+#define mainBURSTS_PER_TEST          200UL
+#define mainNUM_BURST_SIZES          ( sizeof( uxBurstSizes ) / sizeof( uxBurstSizes[ 0 ] ) )
+
+/* The task to be created. */
+static void vInterruptGeneratorTask( void * pvParameters );
+
+/* The function that performs the deferred interrupt processing, as per
+ * Example018.  It is executed by either the daemon task or the deferred work
+ * service's task. */
+static void vDeferredHandlingFunction( void * pvParameter1,
+                                       uint32_t ulParameter2 );
+
+/* The service routine for the (simulated) interrupt. */
+static uint32_t ulExampleInterruptHandler( void );
+
+/* The callback of the timer that is reset alongside each interrupt. */
+static void prvBacklightTimerCallback( TimerHandle_t xTimer );
+
+/*-----------------------------------------------------------*/
+
+/* Each burst models interrupts that arrive faster than they can be processed,
+ * each of which also causes the application to reset a software timer, as the
+ * key presses in Example015 reset the backlight timer. */
+static const UBaseType_t uxBurstSizes[] = { 4, 8, 16, 32, 64, 128 };
+
+static TimerHandle_t xBacklightTimer;
+static DeferredWorkHandle_t xDeferredWork;
+
+/* Selects the path the interrupt defers its processing through. */
+static volatile BaseType_t xUseDeferredWork = pdFALSE;
+
+/* Updated by the interrupt. */
+static volatile uint32_t ulPendFailures = 0;
+
+/* Updated by the deferred handling function. */
+static volatile uint32_t ulExecuted = 0;
+static uint64_t ullTotalLatencyNs = 0;
+static uint32_t ulMaxLatencyNs = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    vBenchmarkTimerInit();
+
+    xBacklightTimer = xTimerCreate( "Backlight", pdMS_TO_TICKS( 500UL ), pdFALSE, NULL, prvBacklightTimerCallback );
+
+    /* The deferred work service's task has the same priority as the daemon
+     * task, so the two paths are compared on equal terms. */
+    xDeferredWork = xDeferredWorkCreate( "Deferred", mainRING_LENGTH, configTIMER_TASK_PRIORITY, mainBATCH_SIZE );
+
+    if( ( xBacklightTimer != NULL ) && ( xDeferredWork != NULL ) )
+    {
+        /* The task that generates the interrupts has a priority above both the
+         * daemon task and the deferred work service's task, so neither runs
+         * until a burst is complete, as happens when interrupts arrive faster
+         * than they are processed. */
+        xTaskCreate( vInterruptGeneratorTask, "Generator", 1000, NULL, configMAX_PRIORITIES - 1, NULL );
+
+        /* Install the handler for the software interrupt.  The syntax necessary
+         * to do this is dependent on the FreeRTOS port being used.  The syntax
+         * shown here can only be used with the FreeRTOS Windows port, where such
+         * interrupts are only simulated. */
+        vPortSetInterruptHandler( mainINTERRUPT_NUMBER, ulExampleInterruptHandler );
+
+        /* Start the scheduler so the created tasks start executing. */
+        vTaskStartScheduler();
+    }
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vInterruptGeneratorTask( void * pvParameters )
+{
+    uint32_t ulBurst, ulGenerated, ulTimerFailures;
+    UBaseType_t uxInterrupt;
+    DeferredWorkStats_t xStats;
+    BaseType_t xPath;
+    size_t x;
+    char cBuffer[ 120 ];
+
+    ( void ) pvParameters;
+
+    vPrintString( "Path                             Burst  Calls lost  Timer commands lost  Mean latency (ns)  Max latency (ns)\r\n" );
+
+    for( xPath = 0; xPath < 2; xPath++ )
+    {
+        xUseDeferredWork = ( xPath == 1 ) ? pdTRUE : pdFALSE;
+
+        for( x = 0; x < mainNUM_BURST_SIZES; x++ )
+        {
+            ulPendFailures = 0;
+            ulExecuted = 0;
+            ullTotalLatencyNs = 0;
+            ulMaxLatencyNs = 0;
+            ulTimerFailures = 0;
+            ulGenerated = 0;
+
+            for( ulBurst = 0; ulBurst < mainBURSTS_PER_TEST; ulBurst++ )
+            {
+                /* Let the deferred processing catch up between bursts. */
+                vTaskDelay( 1 );
+
+                /* The syntax used to generate a software interrupt is dependent
+                 * on the FreeRTOS port being used.  The syntax used below can
+                 * only be used with the FreeRTOS Windows port, in which such
+                 * interrupts are only simulated. */
+                for( uxInterrupt = 0; uxInterrupt < uxBurstSizes[ x ]; uxInterrupt++ )
+                {
+                    vPortGenerateSimulatedInterrupt( mainINTERRUPT_NUMBER );
+                    ulGenerated++;
+
+                    if( xTimerReset( xBacklightTimer, 0 ) != pdPASS )
+                    {
+                        ulTimerFailures++;
+                    }
+                }
+            }
+
+            /* Wait for every pended call to execute. */
+            while( ( ulExecuted + ulPendFailures ) < ulGenerated )
+            {
+                vTaskDelay( 1 );
+            }
+
+            snprintf( cBuffer, sizeof( cBuffer ), "%-31s  %5lu  %10lu  %19lu  %17lu  %16lu\r\n",
+                      ( xUseDeferredWork != pdFALSE ) ? "xDeferredWorkPendFromISR()" : "xTimerPendFunctionCallFromISR()",
+                      ( unsigned long ) uxBurstSizes[ x ],
+                      ( unsigned long ) ulPendFailures,
+                      ( unsigned long ) ulTimerFailures,
+                      ( unsigned long ) ( ( ulExecuted > 0 ) ? ( ullTotalLatencyNs / ulExecuted ) : 0 ),
+                      ( unsigned long ) ulMaxLatencyNs );
+            vPrintString( cBuffer );
+        }
+    }
+
+    /* The deferred work service notifies its task once per burst, and executes
+     * each burst in as few batches as the batch size allows. */
+    vDeferredWorkGetStats( xDeferredWork, &xStats );
+    snprintf( cBuffer, sizeof( cBuffer ), "\r\nDeferred work: %lu executed in %lu batches, largest batch %lu, most entries in ring %lu, %lu overflows\r\n",
+              ( unsigned long ) xStats.ulExecuted,
+              ( unsigned long ) xStats.ulBatches,
+              ( unsigned long ) xStats.uxMaxBatch,
+              ( unsigned long ) xStats.uxMaxFill,
+              ( unsigned long ) xStats.ulOverflows );
+    vPrintString( cBuffer );
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t ulExampleInterruptHandler( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE, xPended;
+    uint32_t ulTimeStamp;
+
+    /* The deferred handling function's ulParameter2 parameter is used to pass
+     * the time at which the interrupt occurred, so the function can measure how
+     * long its execution was deferred.  Only the low 32 bits of the time in
+     * nanoseconds are passed, which is enough for latencies of up to four
+     * seconds. */
+    ulTimeStamp = ( uint32_t ) ullBenchmarkTimerGetNanoseconds();
+
+    if( xUseDeferredWork != pdFALSE )
+    {
+        xPended = xDeferredWorkPendFromISR( xDeferredWork, vDeferredHandlingFunction, NULL, ulTimeStamp, &xHigherPriorityTaskWoken );
+    }
+    else
+    {
+        xPended = xTimerPendFunctionCallFromISR( vDeferredHandlingFunction, NULL, ulTimeStamp, &xHigherPriorityTaskWoken );
+    }
+
+    if( xPended != pdPASS )
+    {
+        ulPendFailures++;
+    }
+
+    /* The implementation of portYIELD_FROM_ISR() used by the Windows port
+     * includes a return statement, which is why this function does not
+     * explicitly return a value. */
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+static void vDeferredHandlingFunction( void * pvParameter1,
+                                       uint32_t ulParameter2 )
+{
+    uint32_t ulLatency;
+
+    ( void ) pvParameter1;
+
+    ulLatency = ( uint32_t ) ullBenchmarkTimerGetNanoseconds() - ulParameter2;
+    ullTotalLatencyNs += ulLatency;
+
+    if( ulLatency > ulMaxLatencyNs )
+    {
+        ulMaxLatencyNs = ulLatency;
+    }
+
+    ulExecuted++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBacklightTimerCallback( TimerHandle_t xTimer )
+{
+    /* The timer is reset far more often than its period, so only expires
+     * between tests. */
+    ( void ) xTimer;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,171 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "timer_wheel.h"
+
+/* The number of periodic timers, which have similar but not identical periods,
+ * like the auto-reload timer in Example013 with a different period in each
+ * part of an application. */
+#define mainNUM_TIMERS               8
+
+/* The slack given to every timer in the second test.  Each callback can
+ * execute up to this long after its timer expires. */
+#define mainSLACK                    pdMS_TO_TICKS( 10UL )
+
+/* The timers are started this far apart, so they expire out of step. */
+#define mainSTART_INTERVAL           pdMS_TO_TICKS( 7UL )
+
+/* How long each test runs for. */
+#define mainTEST_DURATION            pdMS_TO_TICKS( 10000UL )
+
+/* The task that performs the benchmark. */
+static void vBenchmarkTask( void * pvParameters );
+
+/* Run one test with every timer given xSlack ticks of slack, and print a line
+ * of results.  Returns the number of service task wake-ups. */
+static uint32_t prvRunTest( TickType_t xSlack );
+
+/* The callback used by every timer. */
+static void prvTimerCallback( TimerWheelHandle_t xTimer );
+
+/*-----------------------------------------------------------*/
+
+static const TickType_t xTimerPeriods[ mainNUM_TIMERS ] =
+{
+    pdMS_TO_TICKS( 97UL ),  pdMS_TO_TICKS( 98UL ),  pdMS_TO_TICKS( 99UL ),  pdMS_TO_TICKS( 100UL ),
+    pdMS_TO_TICKS( 101UL ), pdMS_TO_TICKS( 102UL ), pdMS_TO_TICKS( 103UL ), pdMS_TO_TICKS( 104UL )
+};
+
+static TimerWheelHandle_t xTimers[ mainNUM_TIMERS ];
+
+/* Updated by the timer callbacks.  xNextExpiry[] holds the tick on which each
+ * timer should next expire, ignoring slack. */
+static TickType_t xNextExpiry[ mainNUM_TIMERS ];
+static uint32_t ulExpiries = 0;
+static TickType_t xMaxLateness = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    size_t x;
+
+    for( x = 0; x < mainNUM_TIMERS; x++ )
+    {
+        xTimers[ x ] = xTimerWheelCreate( "Periodic", xTimerPeriods[ x ], pdTRUE, ( void * ) x, prvTimerCallback );
+        configASSERT( xTimers[ x ] != NULL );
+    }
+
+    /* The benchmark task has a lower priority than the timer service, so each
+     * command it sends is processed as soon as it is sent. */
+    xTimerWheelServiceStart( configTIMER_TASK_PRIORITY );
+    xTaskCreate( vBenchmarkTask, "Benchmark", 1000, NULL, configTIMER_TASK_PRIORITY - 1, NULL );
+
+    /* Start the scheduler so the created tasks start executing. */
+    vTaskStartScheduler();
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vBenchmarkTask( void * pvParameters )
+{
+    uint32_t ulWakeupsWithoutSlack, ulWakeupsWithSlack;
+
+    ( void ) pvParameters;
+
+    vPrintString( "Slack (ticks)  Expiries  Expiry ticks  Service wake-ups  Slacked expiries  Max lateness (ticks)\r\n" );
+
+    ulWakeupsWithoutSlack = prvRunTest( 0 );
+    ulWakeupsWithSlack = prvRunTest( mainSLACK );
+
+    vPrintStringAndNumber( "Service wake-ups saved by slack:", ulWakeupsWithoutSlack - ulWakeupsWithSlack );
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRunTest( TickType_t xSlack )
+{
+    TimerWheelStats_t xStatsBefore, xStatsAfter;
+    char cBuffer[ 120 ];
+    size_t x;
+
+    ulExpiries = 0;
+    xMaxLateness = 0;
+    vTimerWheelGetStats( &xStatsBefore );
+
+    for( x = 0; x < mainNUM_TIMERS; x++ )
+    {
+        vTimerWheelSetSlack( xTimers[ x ], xSlack );
+        xNextExpiry[ x ] = xTaskGetTickCount() + xTimerPeriods[ x ];
+        xTimerWheelStart( xTimers[ x ], portMAX_DELAY );
+        vTaskDelay( mainSTART_INTERVAL );
+    }
+
+    vTaskDelay( mainTEST_DURATION );
+
+    for( x = 0; x < mainNUM_TIMERS; x++ )
+    {
+        xTimerWheelStop( xTimers[ x ], portMAX_DELAY );
+    }
+
+    /* The wheel's statistics accumulate, so only the change is printed. */
+    vTimerWheelGetStats( &xStatsAfter );
+
+    snprintf( cBuffer, sizeof( cBuffer ), "%13lu  %8lu  %12lu  %16lu  %16lu  %20lu\r\n",
+              ( unsigned long ) xSlack,
+              ( unsigned long ) ulExpiries,
+              ( unsigned long ) ( xStatsAfter.ulExpiryTicks - xStatsBefore.ulExpiryTicks ),
+              ( unsigned long ) ( xStatsAfter.ulWakeups - xStatsBefore.ulWakeups ),
+              ( unsigned long ) ( xStatsAfter.ulSlackedExpiries - xStatsBefore.ulSlackedExpiries ),
+              ( unsigned long ) xMaxLateness );
+    vPrintString( cBuffer );
+
+    return xStatsAfter.ulWakeups - xStatsBefore.ulWakeups;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerWheelHandle_t xTimer )
+{
+    size_t x = ( size_t ) pvTimerWheelGetTimerID( xTimer );
+    TickType_t xLateness;
+
+    xLateness = xTaskGetTickCount() - xNextExpiry[ x ];
+    xNextExpiry[ x ] += xTimerPeriods[ x ];
+    ulExpiries++;
+
+    if( xLateness > xMaxLateness )
+    {
+        xMaxLateness = xLateness;
+    }
+}
+/*-----------------------------------------------------------*/
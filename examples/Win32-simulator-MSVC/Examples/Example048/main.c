@@ -0,0 +1,369 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "cpu_load.h"
+#include "workload.h"
+
+/* The period of the control loop, which is one tick at the 1 kHz tick rate
+ * set in FreeRTOSConfig.h. */
+#define mainPERIOD_TICKS             pdMS_TO_TICKS( 1UL )
+#define mainPERIOD_US                1000UL
+
+/* The ways the periodic work is run.  eMechanismNone measures the CPU load
+ * without any periodic work, so the cost of each mechanism can be separated
+ * from the cost of the background load. */
+typedef enum
+{
+    eMechanismNone = 0,
+    eMechanismAutoReload,   /* An auto-reload timer, as per Example013. */
+    eMechanismDelayUntil,   /* A task that calls vTaskDelayUntil(), as per Example005. */
+    eMechanismChangePeriod, /* A one-shot timer that re-arms itself with xTimerChangePeriod(). */
+    eNumMechanisms
+} Mechanism_t;
+
+/* How long each test runs for.  The first second lets the CPU load average
+ * settle after the load changes. */
+#define mainTEST_DURATION            pdMS_TO_TICKS( 4000UL )
+#define mainTEST_SECONDS             4UL
+
+/* The number of background load levels in ulLoadLevels[]. */
+#define mainNUM_LOAD_LEVELS          ( sizeof( ulLoadLevels ) / sizeof( ulLoadLevels[ 0 ] ) )
+
+/* The tasks to be created. */
+static void vBenchmarkTask( void * pvParameters );
+static void vDelayUntilTask( void * pvParameters );
+
+/* The timer callbacks. */
+static void prvAutoReloadTimerCallback( TimerHandle_t xTimer );
+static void prvChangePeriodTimerCallback( TimerHandle_t xTimer );
+
+/* Start and stop the periodic work. */
+static void prvStartMechanism( Mechanism_t eMechanism );
+static void prvStopMechanism( Mechanism_t eMechanism );
+
+/* The periodic work, which records the time at which it executes. */
+static void prvActivation( void );
+
+/*-----------------------------------------------------------*/
+
+static const char * const pcMechanismNames[ eNumMechanisms ] = { "None", "Auto-reload timer", "vTaskDelayUntil()", "xTimerChangePeriod()" };
+
+/* The background load is a higher priority task, so it delays the periodic work
+ * as well as competing with it for the CPU.  Its duty cycle is changed between
+ * tests. */
+static const uint32_t ulLoadLevels[] = { 0UL, 20UL, 40UL };
+
+static const WorkloadParameters_t xLoadParameters =
+{
+    /* Name, Priority,                 Period (us), Duty %, Burst distribution,        Memory pattern,        Size,      Stride, Seed */
+    "Load",  configMAX_PRIORITIES - 1, 10000UL,     0UL,    eWorkloadBurstExponential, eWorkloadMemoryRandom, 64 * 1024, 0,      1UL
+};
+
+static WorkloadHandle_t xLoad;
+static TimerHandle_t xAutoReloadTimer, xChangePeriodTimer;
+static TaskHandle_t xDelayUntilTask;
+
+/* Set while the vTaskDelayUntil() task should run the periodic work. */
+static volatile BaseType_t xDelayUntilRunning = pdFALSE;
+
+/* The tick on which the xTimerChangePeriod() timer should next expire. */
+static TickType_t xNextActivationTick;
+
+/* Updated by prvActivation().  The phase of each activation is its time
+ * relative to the first activation, less the time that should have elapsed, so
+ * a phase that grows over a test is drift, and the variation from one interval
+ * to the next is jitter. */
+static uint32_t ulActivations = 0;
+static uint32_t ulFirstActivationUs = 0;
+static uint32_t ulLastActivationUs = 0;
+static int32_t lPhaseUs = 0;
+static uint32_t ulMaxPhaseErrorUs = 0;
+static uint64_t ullTotalJitterUs = 0;
+static uint32_t ulMaxJitterUs = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    /* The workload is calibrated against the benchmark timer. */
+    vBenchmarkTimerInit();
+
+    xAutoReloadTimer = xTimerCreate( "AutoReload", mainPERIOD_TICKS, pdTRUE, NULL, prvAutoReloadTimerCallback );
+    xChangePeriodTimer = xTimerCreate( "ChangePeriod", mainPERIOD_TICKS, pdFALSE, NULL, prvChangePeriodTimerCallback );
+    configASSERT( ( xAutoReloadTimer != NULL ) && ( xChangePeriodTimer != NULL ) );
+
+    /* The vTaskDelayUntil() task has the same priority as the timer service
+     * task, so all three mechanisms compete with the background load on equal
+     * terms. */
+    xTaskCreate( vDelayUntilTask, "DelayUntil", 1000, NULL, configTIMER_TASK_PRIORITY, &xDelayUntilTask );
+
+    /* The workload is created by the benchmark task once the idle hook has
+     * been calibrated, as per Example030. */
+    xTaskCreate( vBenchmarkTask, "Benchmark", 1000, NULL, configMAX_PRIORITIES - 1, NULL );
+
+    /* Start the scheduler so the created tasks start executing. */
+    vTaskStartScheduler();
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vBenchmarkTask( void * pvParameters )
+{
+    uint32_t ulBaselineLoad = 0, ulLoad, ulWorkUs, ulCostUs;
+    WorkloadStats_t xStatsBefore, xStatsAfter;
+    Mechanism_t eMechanism;
+    size_t xLevel;
+    char cBuffer[ 140 ];
+
+    ( void ) pvParameters;
+
+    vCpuLoadCalibrate( pdMS_TO_TICKS( 1000UL ) );
+    xLoad = xWorkloadCreate( &xLoadParameters );
+    configASSERT( xLoad != NULL );
+
+    vPrintString( "Load  Mechanism             Activations  Drift (us)  Max phase error (us)  Mean jitter (us)  Max jitter (us)  CPU per activation (us)\r\n" );
+
+    for( xLevel = 0; xLevel < mainNUM_LOAD_LEVELS; xLevel++ )
+    {
+        vWorkloadSetDutyCycle( xLoad, ulLoadLevels[ xLevel ] );
+
+        for( eMechanism = eMechanismNone; eMechanism < eNumMechanisms; eMechanism++ )
+        {
+            ulActivations = 0;
+            lPhaseUs = 0;
+            ulMaxPhaseErrorUs = 0;
+            ullTotalJitterUs = 0;
+            ulMaxJitterUs = 0;
+            vWorkloadGetStats( xLoad, &xStatsBefore );
+
+            prvStartMechanism( eMechanism );
+            vTaskDelay( mainTEST_DURATION );
+
+            /* The load average is read before the periodic work stops.  The
+             * background load requests a random amount of CPU time, so the CPU
+             * time it actually requested during the test is subtracted from the
+             * load, leaving the cost of the periodic work and of the kernel. */
+            ulLoad = ulCpuLoadGet( eCpuLoad1Second );
+            prvStopMechanism( eMechanism );
+            vWorkloadGetStats( xLoad, &xStatsAfter );
+
+            /* Convert to CPU time in microseconds per second. */
+            ulLoad *= ( 1000000UL / cpuloadFULL_LOAD );
+            ulWorkUs = ( uint32_t ) ( ( xStatsAfter.ullRequestedWorkUs - xStatsBefore.ullRequestedWorkUs ) / mainTEST_SECONDS );
+            ulLoad = ( ulLoad > ulWorkUs ) ? ( ulLoad - ulWorkUs ) : 0UL;
+
+            if( eMechanism == eMechanismNone )
+            {
+                /* Every other mechanism at this load level is compared against
+                 * the load measured with no periodic work. */
+                ulBaselineLoad = ulLoad;
+                continue;
+            }
+
+            if( ( ulLoad > ulBaselineLoad ) && ( ulActivations > 0 ) )
+            {
+                ulCostUs = ( ( ulLoad - ulBaselineLoad ) * mainTEST_SECONDS ) / ulActivations;
+            }
+            else
+            {
+                ulCostUs = 0;
+            }
+
+            snprintf( cBuffer, sizeof( cBuffer ), "%3lu%%  %-20s  %11lu  %10ld  %20lu  %16lu  %15lu  %23lu\r\n",
+                      ( unsigned long ) ulLoadLevels[ xLevel ],
+                      pcMechanismNames[ eMechanism ],
+                      ( unsigned long ) ulActivations,
+                      ( long ) lPhaseUs,
+                      ( unsigned long ) ulMaxPhaseErrorUs,
+                      ( unsigned long ) ( ( ulActivations > 1 ) ? ( ullTotalJitterUs / ( ulActivations - 1 ) ) : 0 ),
+                      ( unsigned long ) ulMaxJitterUs,
+                      ( unsigned long ) ulCostUs );
+            vPrintString( cBuffer );
+        }
+    }
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void vDelayUntilTask( void * pvParameters )
+{
+    TickType_t xLastWakeTime;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* Wait to be told to start. */
+        ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        xLastWakeTime = xTaskGetTickCount();
+
+        while( xDelayUntilRunning != pdFALSE )
+        {
+            /* As per Example005.  The wake time is relative to the time the
+             * task should have woken, not the time it actually woke. */
+            vTaskDelayUntil( &xLastWakeTime, mainPERIOD_TICKS );
+            prvActivation();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartMechanism( Mechanism_t eMechanism )
+{
+    switch( eMechanism )
+    {
+        case eMechanismAutoReload:
+            xTimerStart( xAutoReloadTimer, portMAX_DELAY );
+            break;
+
+        case eMechanismDelayUntil:
+            xDelayUntilRunning = pdTRUE;
+            xTaskNotifyGive( xDelayUntilTask );
+            break;
+
+        case eMechanismChangePeriod:
+            xNextActivationTick = xTaskGetTickCount() + mainPERIOD_TICKS;
+            xTimerStart( xChangePeriodTimer, portMAX_DELAY );
+            break;
+
+        case eMechanismNone:
+        default:
+            break;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvStopMechanism( Mechanism_t eMechanism )
+{
+    switch( eMechanism )
+    {
+        case eMechanismAutoReload:
+            xTimerStop( xAutoReloadTimer, portMAX_DELAY );
+            break;
+
+        case eMechanismDelayUntil:
+            xDelayUntilRunning = pdFALSE;
+            break;
+
+        case eMechanismChangePeriod:
+            xTimerStop( xChangePeriodTimer, portMAX_DELAY );
+            break;
+
+        case eMechanismNone:
+        default:
+            break;
+    }
+
+    /* Let the mechanism stop before the next test starts. */
+    vTaskDelay( mainPERIOD_TICKS * 2 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvAutoReloadTimerCallback( TimerHandle_t xTimer )
+{
+    ( void ) xTimer;
+
+    /* As per Example013.  The kernel calculates the next expiry time from the
+     * time the timer should have expired. */
+    prvActivation();
+}
+/*-----------------------------------------------------------*/
+
+static void prvChangePeriodTimerCallback( TimerHandle_t xTimer )
+{
+    TickType_t xTimeNow;
+
+    prvActivation();
+
+    /* Re-arm the timer for the next activation.  xTimerChangePeriod() starts
+     * the timer from the time the command is processed, so the period is
+     * shortened by however late this activation was.  A period cannot be 0, so
+     * once an activation is a whole period late the lost time can never be
+     * recovered, and shows up as drift. */
+    xTimeNow = xTaskGetTickCount();
+    xNextActivationTick += mainPERIOD_TICKS;
+
+    if( ( xNextActivationTick - xTimeNow ) > ( portMAX_DELAY / 2 ) )
+    {
+        xNextActivationTick = xTimeNow + 1;
+    }
+    else if( xNextActivationTick == xTimeNow )
+    {
+        xNextActivationTick++;
+    }
+
+    xTimerChangePeriod( xTimer, xNextActivationTick - xTimeNow, 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvActivation( void )
+{
+    uint32_t ulTimeNow = ulBenchmarkTimerGetMicroseconds(), ulPhaseError, ulJitter;
+    int32_t lInterval;
+
+    if( ulActivations == 0 )
+    {
+        ulFirstActivationUs = ulTimeNow;
+    }
+    else
+    {
+        lInterval = ( int32_t ) ( ulTimeNow - ulLastActivationUs );
+        ulJitter = ( uint32_t ) ( ( lInterval > ( int32_t ) mainPERIOD_US ) ? ( lInterval - ( int32_t ) mainPERIOD_US ) : ( ( int32_t ) mainPERIOD_US - lInterval ) );
+        ullTotalJitterUs += ulJitter;
+
+        if( ulJitter > ulMaxJitterUs )
+        {
+            ulMaxJitterUs = ulJitter;
+        }
+
+        lPhaseUs = ( int32_t ) ( ulTimeNow - ulFirstActivationUs - ( ulActivations * mainPERIOD_US ) );
+        ulPhaseError = ( uint32_t ) ( ( lPhaseUs < 0 ) ? -lPhaseUs : lPhaseUs );
+
+        if( ulPhaseError > ulMaxPhaseErrorUs )
+        {
+            ulMaxPhaseErrorUs = ulPhaseError;
+        }
+    }
+
+    ulLastActivationUs = ulTimeNow;
+    ulActivations++;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+    vCpuLoadIdleHook();
+}
+/*-----------------------------------------------------------*/
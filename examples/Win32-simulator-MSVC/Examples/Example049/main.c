@@ -0,0 +1,240 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "interrupt_source.h"
+
+/* The number of interrupt sources, each of which uses its own simulated
+ * interrupt.  Numbers 0 to 2 are used by the FreeRTOS Windows port itself, so 3
+ * is the first number available to the application. */
+#define mainNUM_SOURCES              4
+
+/* The replay file is opened relative to the working directory, which is the
+ * MSVC directory when the example is run from Visual Studio.  The file holds
+ * the times of the receive interrupts of a UART at 115200 baud receiving a
+ * series of short messages. */
+#define mainREPLAY_FILE              "..\\interrupt_times.txt"
+
+/* The tasks to be created. */
+static void vHandlerTask( void * pvParameters );
+static void vReporterTask( void * pvParameters );
+
+/* The service routines for the (simulated) interrupts.  Each is the same apart
+ * from the source it handles. */
+static uint32_t ulFixedInterruptHandler( void );
+static uint32_t ulPoissonInterruptHandler( void );
+static uint32_t ulBurstyInterruptHandler( void );
+static uint32_t ulReplayInterruptHandler( void );
+
+/* The work common to all the service routines.  Returns pdTRUE if a context
+ * switch should be requested. */
+static BaseType_t prvHandleInterrupt( size_t xSource );
+
+/*-----------------------------------------------------------*/
+
+static const InterruptSourceParameters_t xSourceParameters[ mainNUM_SOURCES ] =
+{
+    /* Name,     Interrupt, Model,                   Interval (us), Burst length, Burst spacing (us), Replay file,      Seed */
+    { "Fixed",   3,         eInterruptSourceFixed,   1000UL,        0UL,          0UL,                NULL,             0UL },
+    { "Poisson", 4,         eInterruptSourcePoisson, 500UL,         0UL,          0UL,                NULL,             1UL },
+    { "Bursty",  5,         eInterruptSourceBursty,  20000UL,       16UL,         20UL,               NULL,             0UL },
+    { "Replay",  6,         eInterruptSourceReplay,  10000UL,       0UL,          0UL,                mainREPLAY_FILE,  0UL }
+};
+
+static uint32_t ( * const pxHandlers[ mainNUM_SOURCES ] )( void ) =
+{
+    ulFixedInterruptHandler, ulPoissonInterruptHandler, ulBurstyInterruptHandler, ulReplayInterruptHandler
+};
+
+static InterruptSourceHandle_t xSources[ mainNUM_SOURCES ];
+static TaskHandle_t xHandlerTask = NULL;
+
+/* Updated by the handler task. */
+static volatile uint32_t ulEventsProcessed = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    size_t x;
+
+    vBenchmarkTimerInit();
+
+    /* The sources must be created before the scheduler is started, as each
+     * creates a Windows thread. */
+    for( x = 0; x < mainNUM_SOURCES; x++ )
+    {
+        xSources[ x ] = xInterruptSourceCreate( &( xSourceParameters[ x ] ) );
+
+        if( xSources[ x ] != NULL )
+        {
+            /* Install the handler for the software interrupt.  The syntax
+             * necessary to do this is dependent on the FreeRTOS port being
+             * used.  The syntax shown here can only be used with the FreeRTOS
+             * Windows port, where such interrupts are only simulated. */
+            vPortSetInterruptHandler( xSourceParameters[ x ].ulInterruptNumber, pxHandlers[ x ] );
+        }
+        else
+        {
+            vPrintTwoStrings( "Could not create interrupt source", xSourceParameters[ x ].pcName );
+        }
+    }
+
+    /* The handler task processes the interrupts as per Example024. */
+    xTaskCreate( vHandlerTask, "Handler", 1000, NULL, 3, &xHandlerTask );
+    xTaskCreate( vReporterTask, "Reporter", 1000, NULL, 1, NULL );
+
+    /* Start the scheduler so the created tasks start executing. */
+    vTaskStartScheduler();
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vHandlerTask( void * pvParameters )
+{
+    uint32_t ulEventsToProcess;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* Wait to receive a notification sent directly to this task from an
+         * interrupt service routine, as per Example024.  Every interrupt that
+         * occurred since the last time the task ran is processed. */
+        ulEventsToProcess = ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        ulEventsProcessed += ulEventsToProcess;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vReporterTask( void * pvParameters )
+{
+    const TickType_t xReportPeriod = pdMS_TO_TICKS( 2000UL );
+    InterruptSourceStats_t xStats;
+    uint32_t ulLastEventsProcessed = 0, ulEvents;
+    char cBuffer[ 120 ];
+    size_t x;
+
+    ( void ) pvParameters;
+
+    /* The sources are started once the scheduler is running, so the
+     * interrupts they raise can be processed.  Their statistics are cleared
+     * each time they are printed. */
+    for( x = 0; x < mainNUM_SOURCES; x++ )
+    {
+        if( xSources[ x ] != NULL )
+        {
+            vInterruptSourceStart( xSources[ x ] );
+        }
+    }
+
+    for( ; ; )
+    {
+        vTaskDelay( xReportPeriod );
+
+        vPrintString( "Source    Raised/s  Handled/s  Coalesced  Mean latency (ns)  Max latency (ns)  Max lag (us)\r\n" );
+
+        for( x = 0; x < mainNUM_SOURCES; x++ )
+        {
+            if( xSources[ x ] == NULL )
+            {
+                continue;
+            }
+
+            vInterruptSourceGetStats( xSources[ x ], &xStats, pdTRUE );
+            snprintf( cBuffer, sizeof( cBuffer ), "%-8s  %8lu  %9lu  %9lu  %17lu  %16lu  %12lu\r\n",
+                      xSourceParameters[ x ].pcName,
+                      ( unsigned long ) ( xStats.ulRaised / 2UL ),
+                      ( unsigned long ) ( xStats.ulHandled / 2UL ),
+                      ( unsigned long ) xStats.ulCoalesced,
+                      ( unsigned long ) ( ( xStats.ulMeasured > 0 ) ? ( xStats.ullTotalLatencyNs / xStats.ulMeasured ) : 0 ),
+                      ( unsigned long ) xStats.ulMaxLatencyNs,
+                      ( unsigned long ) xStats.ulMaxLagUs );
+            vPrintString( cBuffer );
+        }
+
+        ulEvents = ulEventsProcessed;
+        vPrintStringAndNumber( "Events processed by the handler task per second:", ( ulEvents - ulLastEventsProcessed ) / 2UL );
+        vPrintString( "\r\n" );
+        ulLastEventsProcessed = ulEvents;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvHandleInterrupt( size_t xSource )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    /* Record the latency before doing anything else. */
+    vInterruptSourceISREntry( xSources[ xSource ] );
+
+    /* Defer the processing to the handler task, as per Example024. */
+    vTaskNotifyGiveFromISR( xHandlerTask, &xHigherPriorityTaskWoken );
+
+    return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t ulFixedInterruptHandler( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = prvHandleInterrupt( 0 );
+
+    /* The implementation of portYIELD_FROM_ISR() used by the Windows port
+     * includes a return statement, which is why this function does not
+     * explicitly return a value. */
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t ulPoissonInterruptHandler( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = prvHandleInterrupt( 1 );
+
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t ulBurstyInterruptHandler( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = prvHandleInterrupt( 2 );
+
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t ulReplayInterruptHandler( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = prvHandleInterrupt( 3 );
+
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,338 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "interrupt_source.h"
+
+/* The number of the simulated interrupt used in this example.  Numbers 0 to 2
+ * are used by the FreeRTOS Windows port itself, so 3 is the first number available
+ * to the application. */
+#define mainINTERRUPT_NUMBER         3
+
+/* As per Example017, each interrupt generates three events, and the counting
+ * semaphore has a maximum count of 10.  The queue has the same capacity. */
+#define mainEVENTS_PER_INTERRUPT     3UL
+#define mainMAX_PENDING_EVENTS       10
+
+/* The CPU time the handler task needs to process each event, so the handler
+ * task can process at most 1000000 / mainPROCESSING_US events per second. */
+#define mainPROCESSING_US            100UL
+
+/* How long each interrupt rate is held for. */
+#define mainSTEP_DURATION            pdMS_TO_TICKS( 2000UL )
+
+/* The interrupt rates, in interrupts per second. */
+#define mainNUM_RATES                ( sizeof( ulRates ) / sizeof( ulRates[ 0 ] ) )
+
+/* The ways the interrupt defers events to the handler task. */
+typedef enum
+{
+    eDeferSemaphore = 0, /* xSemaphoreGiveFromISR(), as per Example017. */
+    eDeferNotification,  /* vTaskNotifyGiveFromISR(), as per Example024. */
+    eDeferQueue,         /* xQueueSendToBackFromISR(). */
+    eNumDeferMethods
+} DeferMethod_t;
+
+/* The tasks to be created. */
+static void vBenchmarkTask( void * pvParameters );
+static void vSemaphoreHandlerTask( void * pvParameters );
+static void vNotificationHandlerTask( void * pvParameters );
+static void vQueueHandlerTask( void * pvParameters );
+
+/* The service routine for the (simulated) interrupt. */
+static uint32_t ulExampleInterruptHandler( void );
+
+/* Process one event, which takes mainPROCESSING_US of CPU time. */
+static void prvProcessEvent( void );
+
+/*-----------------------------------------------------------*/
+
+static const uint32_t ulRates[] = { 250UL, 500UL, 1000UL, 2000UL, 3000UL, 4000UL, 6000UL, 8000UL };
+static const char * const pcMethodNames[ eNumDeferMethods ] = { "Semaphore", "Notification", "Queue" };
+
+static InterruptSourceHandle_t xSource;
+static SemaphoreHandle_t xCountingSemaphore;
+static QueueHandle_t xEventQueue;
+static TaskHandle_t xNotificationHandlerTask;
+
+/* Selects the method the interrupt uses. */
+static volatile DeferMethod_t eMethod = eDeferSemaphore;
+
+/* Updated by the interrupt. */
+static volatile uint32_t ulEventsGenerated = 0;
+static volatile uint32_t ulFailedGives = 0;
+
+/* Updated by whichever handler task is receiving events. */
+static volatile uint32_t ulEventsProcessed = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    const InterruptSourceParameters_t xSourceParameters =
+    {
+        /* Name,  Interrupt,            Model,                 Interval (us), Burst length, Burst spacing (us), Replay file, Seed */
+        "Storm",  mainINTERRUPT_NUMBER, eInterruptSourceFixed, 1000UL,        0UL,          0UL,                NULL,        0UL
+    };
+
+    vBenchmarkTimerInit();
+
+    /* The source must be created before the scheduler is started, as it creates
+     * a Windows thread. */
+    xSource = xInterruptSourceCreate( &xSourceParameters );
+    xCountingSemaphore = xSemaphoreCreateCounting( mainMAX_PENDING_EVENTS, 0 );
+    xEventQueue = xQueueCreate( mainMAX_PENDING_EVENTS, sizeof( uint32_t ) );
+
+    if( ( xSource != NULL ) && ( xCountingSemaphore != NULL ) && ( xEventQueue != NULL ) )
+    {
+        /* Only one handler task receives events in each test, the others remain
+         * blocked.  The benchmark task has the highest priority so it can stop
+         * the interrupts however far behind the handler task falls. */
+        xTaskCreate( vSemaphoreHandlerTask, "SemHandler", 1000, NULL, 2, NULL );
+        xTaskCreate( vNotificationHandlerTask, "NotHandler", 1000, NULL, 2, &xNotificationHandlerTask );
+        xTaskCreate( vQueueHandlerTask, "QueHandler", 1000, NULL, 2, NULL );
+        xTaskCreate( vBenchmarkTask, "Benchmark", 1000, NULL, 3, NULL );
+
+        /* Install the handler for the software interrupt.  The syntax necessary
+         * to do this is dependent on the FreeRTOS port being used.  The syntax
+         * shown here can only be used with the FreeRTOS Windows port, where such
+         * interrupts are only simulated. */
+        vPortSetInterruptHandler( mainINTERRUPT_NUMBER, ulExampleInterruptHandler );
+
+        /* Start the scheduler so the created tasks start executing. */
+        vTaskStartScheduler();
+    }
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void vBenchmarkTask( void * pvParameters )
+{
+    uint32_t ulMaxSustainableRate[ eNumDeferMethods ] = { 0 };
+    uint32_t ulLost, ulBacklog, ulLastProcessed, ulLostHundredths;
+    BaseType_t xSustainable;
+    InterruptSourceStats_t xStats;
+    DeferMethod_t eTestMethod;
+    size_t x;
+    char cBuffer[ 140 ];
+
+    ( void ) pvParameters;
+
+    vPrintString( "Method        Ints (/s)  Interrupts  Events  Failed gives  Coalesced  Backlog  Lost (%)\r\n" );
+
+    for( eTestMethod = eDeferSemaphore; eTestMethod < eNumDeferMethods; eTestMethod++ )
+    {
+        eMethod = eTestMethod;
+        xSustainable = pdTRUE;
+
+        for( x = 0; x < mainNUM_RATES; x++ )
+        {
+            ulEventsGenerated = 0;
+            ulFailedGives = 0;
+            ulEventsProcessed = 0;
+            vInterruptSourceSetInterval( xSource, 1000000UL / ulRates[ x ] );
+            vInterruptSourceGetStats( xSource, &xStats, pdTRUE );
+
+            vInterruptSourceStart( xSource );
+            vTaskDelay( mainSTEP_DURATION );
+            vInterruptSourceStop( xSource );
+
+            /* The events the handler task has not yet processed when the
+             * interrupts stop show whether it is keeping up.  A task notification
+             * never saturates, so it never fails, but the backlog grows without
+             * limit if the handler task cannot keep up. */
+            ulBacklog = ( ulEventsGenerated - ulFailedGives ) - ulEventsProcessed;
+
+            /* Wait for the handler task to process the backlog. */
+            do
+            {
+                ulLastProcessed = ulEventsProcessed;
+                vTaskDelay( pdMS_TO_TICKS( 100UL ) );
+            } while( ulEventsProcessed != ulLastProcessed );
+
+            vInterruptSourceGetStats( xSource, &xStats, pdTRUE );
+
+            /* Events are lost when a give fails, and when the Windows port
+             * merges an interrupt with one that is already pending, in which
+             * case the interrupt's events are never generated at all. */
+            ulLost = ulFailedGives + ( xStats.ulCoalesced * mainEVENTS_PER_INTERRUPT );
+            ulLostHundredths = ( xStats.ulRaised > 0 ) ? ( ( ulLost * 10000UL ) / ( xStats.ulRaised * mainEVENTS_PER_INTERRUPT ) ) : 0;
+
+            snprintf( cBuffer, sizeof( cBuffer ), "%-12s  %9lu  %10lu  %6lu  %12lu  %9lu  %7lu  %5lu.%02lu\r\n",
+                      pcMethodNames[ eTestMethod ],
+                      ( unsigned long ) ulRates[ x ],
+                      ( unsigned long ) xStats.ulRaised,
+                      ( unsigned long ) ulEventsGenerated,
+                      ( unsigned long ) ulFailedGives,
+                      ( unsigned long ) xStats.ulCoalesced,
+                      ( unsigned long ) ulBacklog,
+                      ( unsigned long ) ( ulLostHundredths / 100UL ),
+                      ( unsigned long ) ( ulLostHundredths % 100UL ) );
+            vPrintString( cBuffer );
+
+            /* A rate is sustainable if no events were lost and the handler task
+             * was keeping up when the interrupts stopped, and every lower rate
+             * was also sustainable. */
+            if( ( ulLost != 0 ) || ( ulBacklog > mainMAX_PENDING_EVENTS ) )
+            {
+                xSustainable = pdFALSE;
+            }
+
+            if( xSustainable != pdFALSE )
+            {
+                ulMaxSustainableRate[ eTestMethod ] = ulRates[ x ];
+            }
+        }
+    }
+
+    /* Each interrupt generates mainEVENTS_PER_INTERRUPT events, so the maximum
+     * sustainable event rate is the interrupt rate multiplied by that number. */
+    vPrintString( "\r\nMaximum sustainable rate:\r\n" );
+    vPrintString( "Method        Interrupts (/s)  Events (/s)\r\n" );
+
+    for( eTestMethod = eDeferSemaphore; eTestMethod < eNumDeferMethods; eTestMethod++ )
+    {
+        snprintf( cBuffer, sizeof( cBuffer ), "%-12s  %15lu  %11lu\r\n",
+                  pcMethodNames[ eTestMethod ],
+                  ( unsigned long ) ulMaxSustainableRate[ eTestMethod ],
+                  ( unsigned long ) ( ulMaxSustainableRate[ eTestMethod ] * mainEVENTS_PER_INTERRUPT ) );
+        vPrintString( cBuffer );
+    }
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void vSemaphoreHandlerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* As per Example017, each take processes one event. */
+        xSemaphoreTake( xCountingSemaphore, portMAX_DELAY );
+        prvProcessEvent();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vNotificationHandlerTask( void * pvParameters )
+{
+    uint32_t ulEventsToProcess;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* As per Example024, every event that occurred since the task last ran
+         * is processed. */
+        ulEventsToProcess = ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        while( ulEventsToProcess > 0 )
+        {
+            prvProcessEvent();
+            ulEventsToProcess--;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vQueueHandlerTask( void * pvParameters )
+{
+    uint32_t ulEvent;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        xQueueReceive( xEventQueue, &ulEvent, portMAX_DELAY );
+        prvProcessEvent();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessEvent( void )
+{
+    uint32_t ulStart = ulBenchmarkTimerGetMicroseconds();
+
+    while( ( ulBenchmarkTimerGetMicroseconds() - ulStart ) < mainPROCESSING_US )
+    {
+    }
+
+    ulEventsProcessed++;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t ulExampleInterruptHandler( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE, xGiven;
+    uint32_t ul, ulEvent;
+
+    vInterruptSourceISREntry( xSource );
+
+    for( ul = 0; ul < mainEVENTS_PER_INTERRUPT; ul++ )
+    {
+        ulEvent = ulEventsGenerated;
+
+        switch( eMethod )
+        {
+            case eDeferSemaphore:
+                xGiven = xSemaphoreGiveFromISR( xCountingSemaphore, &xHigherPriorityTaskWoken );
+                break;
+
+            case eDeferNotification:
+                vTaskNotifyGiveFromISR( xNotificationHandlerTask, &xHigherPriorityTaskWoken );
+                xGiven = pdPASS;
+                break;
+
+            case eDeferQueue:
+            default:
+                xGiven = xQueueSendToBackFromISR( xEventQueue, &ulEvent, &xHigherPriorityTaskWoken );
+                break;
+        }
+
+        ulEventsGenerated = ulEvent + 1;
+
+        if( xGiven != pdPASS )
+        {
+            ulFailedGives++;
+        }
+    }
+
+    /* The implementation of portYIELD_FROM_ISR() used by the Windows port
+     * includes a return statement, which is why this function does not
+     * explicitly return a value. */
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,501 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "timers.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "deferred_work.h"
+
+/* The number of the simulated interrupt used in this example.  Numbers 0 to 2
+ * are used by the FreeRTOS Windows port itself, so 3 is the first number available
+ * to the application. */
+#define mainINTERRUPT_NUMBER         3
+
+/* The number of interrupts generated to measure latency, which are generated
+ * one at a time, and to measure throughput, which are generated in bursts of
+ * mainBURST_LENGTH. */
+#define mainLATENCY_INTERRUPTS       1000UL
+#define mainTHROUGHPUT_INTERRUPTS    20000UL
+#define mainBURST_LENGTH             16UL
+
+/* The capacity of the counting semaphore, as per Example017, and of the queue
+ * and the deferred work service's ring. */
+#define mainMAX_PENDING_EVENTS       10
+#define mainRING_LENGTH              16
+
+/* The priority of the tasks that handle the events, which is the same as the
+ * priority of the daemon task so every mechanism is compared on equal terms.
+ * The benchmark task normally has a lower priority, so each interrupt it
+ * generates is completely processed before it generates the next.  It raises
+ * itself above the handlers while it generates a burst, so the events of a
+ * burst build up until it lowers itself again. */
+#define mainHANDLER_PRIORITY         configTIMER_TASK_PRIORITY
+#define mainBENCHMARK_PRIORITY       1
+#define mainBURST_PRIORITY           ( configMAX_PRIORITIES - 1 )
+
+/* The mechanisms, each of which is used as per the example named in
+ * pcMechanismNames[]. */
+typedef enum
+{
+    eBinarySemaphore = 0,
+    eCountingSemaphore,
+    ePendFunctionCall,
+    eQueue,
+    eNotificationClear,
+    eNotificationDecrement,
+    eDeferredWork,
+    eNumMechanisms
+} Mechanism_t;
+
+/* The tasks to be created. */
+static void vBenchmarkTask( void * pvParameters );
+static void vBinarySemaphoreHandlerTask( void * pvParameters );
+static void vCountingSemaphoreHandlerTask( void * pvParameters );
+static void vQueueHandlerTask( void * pvParameters );
+static void vNotificationClearHandlerTask( void * pvParameters );
+static void vNotificationDecrementHandlerTask( void * pvParameters );
+static void prvRamMeasurementTask( void * pvParameters );
+
+/* The function that performs the deferred processing when it is executed by
+ * the daemon task or the deferred work service's task. */
+static void vDeferredHandlingFunction( void * pvParameter1,
+                                       uint32_t ulParameter2 );
+
+/* The service routine for the (simulated) interrupt. */
+static uint32_t ulExampleInterruptHandler( void );
+
+/* The processing performed for each event, whichever mechanism delivered it. */
+static void prvHandleEvent( void );
+
+/* Create the objects used by a mechanism, and return the heap memory they
+ * consumed. */
+static size_t prvCreateMechanism( Mechanism_t eMechanism );
+
+/*-----------------------------------------------------------*/
+
+static const char * const pcMechanismNames[ eNumMechanisms ] =
+{
+    "Binary semaphore (016)",
+    "Counting semaphore (017)",
+    "Pend function call (018)",
+    "Queue (019)",
+    "Notification, clear (024)",
+    "Notification, count (025)",
+    "Deferred work service"
+};
+
+static SemaphoreHandle_t xBinarySemaphore, xCountingSemaphore;
+static QueueHandle_t xEventQueue;
+static TaskHandle_t xNotificationClearTask, xNotificationDecrementTask;
+static DeferredWorkHandle_t xDeferredWork;
+
+/* The heap memory consumed by each mechanism. */
+static size_t xMechanismRam[ eNumMechanisms ];
+
+/* Used to calculate the heap memory consumed by the daemon task, which is
+ * created when the scheduler starts. */
+static size_t xFreeHeapBeforeScheduler, xIdleTaskRam;
+
+/* Selects the mechanism the interrupt uses. */
+static volatile Mechanism_t eMechanism = eBinarySemaphore;
+
+/* Updated by the interrupt. */
+static volatile uint64_t ullInterruptEntryNs = 0;
+static volatile uint32_t ulFailedSends = 0;
+static uint64_t ullTotalIsrNs = 0;
+
+/* Updated by prvHandleEvent(). */
+static volatile BaseType_t xMeasuringLatency = pdFALSE;
+static volatile uint32_t ulEventsHandled = 0;
+static uint64_t ullTotalLatencyNs = 0;
+static uint64_t ullMaxLatencyNs = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    Mechanism_t eToCreate;
+    size_t xFreeHeap;
+
+    vBenchmarkTimerInit();
+
+    /* Measure the heap memory consumed by a task the same size as the idle
+     * task.  The task deletes itself as soon as it runs. */
+    xFreeHeap = xPortGetFreeHeapSize();
+    xTaskCreate( prvRamMeasurementTask, "Measure", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL );
+    xIdleTaskRam = xFreeHeap - xPortGetFreeHeapSize();
+
+    for( eToCreate = eBinarySemaphore; eToCreate < eNumMechanisms; eToCreate++ )
+    {
+        xMechanismRam[ eToCreate ] = prvCreateMechanism( eToCreate );
+    }
+
+    xTaskCreate( vBenchmarkTask, "Benchmark", 1000, NULL, mainBENCHMARK_PRIORITY, NULL );
+
+    /* Install the handler for the software interrupt.  The syntax necessary
+     * to do this is dependent on the FreeRTOS port being used.  The syntax
+     * shown here can only be used with the FreeRTOS Windows port, where such
+     * interrupts are only simulated. */
+    vPortSetInterruptHandler( mainINTERRUPT_NUMBER, ulExampleInterruptHandler );
+
+    /* The scheduler creates the idle task and the daemon task. */
+    xFreeHeapBeforeScheduler = xPortGetFreeHeapSize();
+
+    /* Start the scheduler so the created tasks start executing. */
+    vTaskStartScheduler();
+
+    /* The following line should never be reached because vTaskStartScheduler()
+    *  will only return if there was not enough FreeRTOS heap memory available to
+    *  create the Idle and (if configured) Timer tasks.  Heap management, and
+    *  techniques for trapping heap exhaustion, are described in the book text. */
+    for( ; ; )
+    {
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCreateMechanism( Mechanism_t eToCreate )
+{
+    size_t xFreeHeap = xPortGetFreeHeapSize();
+    BaseType_t xCreated;
+
+    /* Each mechanism apart from the pend function call has its own handler
+     * task, with the same stack size. */
+    switch( eToCreate )
+    {
+        case eBinarySemaphore:
+            xBinarySemaphore = xSemaphoreCreateBinary();
+            xCreated = xTaskCreate( vBinarySemaphoreHandlerTask, "BinSem", 1000, NULL, mainHANDLER_PRIORITY, NULL );
+            configASSERT( ( xBinarySemaphore != NULL ) && ( xCreated == pdPASS ) );
+            break;
+
+        case eCountingSemaphore:
+            xCountingSemaphore = xSemaphoreCreateCounting( mainMAX_PENDING_EVENTS, 0 );
+            xCreated = xTaskCreate( vCountingSemaphoreHandlerTask, "CountSem", 1000, NULL, mainHANDLER_PRIORITY, NULL );
+            configASSERT( ( xCountingSemaphore != NULL ) && ( xCreated == pdPASS ) );
+            break;
+
+        case eQueue:
+            xEventQueue = xQueueCreate( mainMAX_PENDING_EVENTS, sizeof( uint32_t ) );
+            xCreated = xTaskCreate( vQueueHandlerTask, "Queue", 1000, NULL, mainHANDLER_PRIORITY, NULL );
+            configASSERT( ( xEventQueue != NULL ) && ( xCreated == pdPASS ) );
+            break;
+
+        case eNotificationClear:
+            xCreated = xTaskCreate( vNotificationClearHandlerTask, "NotClear", 1000, NULL, mainHANDLER_PRIORITY, &xNotificationClearTask );
+            configASSERT( xCreated == pdPASS );
+            break;
+
+        case eNotificationDecrement:
+            xCreated = xTaskCreate( vNotificationDecrementHandlerTask, "NotCount", 1000, NULL, mainHANDLER_PRIORITY, &xNotificationDecrementTask );
+            configASSERT( xCreated == pdPASS );
+            break;
+
+        case eDeferredWork:
+            xDeferredWork = xDeferredWorkCreate( "Deferred", mainRING_LENGTH, mainHANDLER_PRIORITY, mainRING_LENGTH );
+            configASSERT( xDeferredWork != NULL );
+            break;
+
+        case ePendFunctionCall:
+        default:
+            /* Uses the daemon task, which is created when the scheduler is
+             * started. */
+            break;
+    }
+
+    return xFreeHeap - xPortGetFreeHeapSize();
+}
+/*-----------------------------------------------------------*/
+
+static void vBenchmarkTask( void * pvParameters )
+{
+    Mechanism_t eTest;
+    uint32_t ulInterrupt, ulIsrTimeNs, ulMeanLatencyNs;
+    uint64_t ullStartTime, ullElapsedNs;
+    char cBuffer[ 140 ];
+
+    ( void ) pvParameters;
+
+    /* The daemon task and its command queue are the only memory allocated when
+     * the scheduler starts, apart from the idle task. */
+    xMechanismRam[ ePendFunctionCall ] = ( xFreeHeapBeforeScheduler - xPortGetFreeHeapSize() ) - xIdleTaskRam;
+
+    vPrintString( "Mechanism                  ISR time (ns)  Mean latency (ns)  Max latency (ns)  Events/second   Lost  RAM (bytes)\r\n" );
+
+    for( eTest = eBinarySemaphore; eTest < eNumMechanisms; eTest++ )
+    {
+        eMechanism = eTest;
+
+        /* Measure the latency with one interrupt outstanding at a time.  Each
+         * interrupt is processed before vPortGenerateSimulatedInterrupt()
+         * returns, as the handler has a higher priority than this task.  The
+         * syntax used to generate a software interrupt is dependent on the
+         * FreeRTOS port being used.  The syntax used below can only be used with
+         * the FreeRTOS Windows port, in which such interrupts are only
+         * simulated. */
+        ulEventsHandled = 0;
+        ulFailedSends = 0;
+        ullTotalIsrNs = 0;
+        ullTotalLatencyNs = 0;
+        ullMaxLatencyNs = 0;
+        xMeasuringLatency = pdTRUE;
+
+        for( ulInterrupt = 0; ulInterrupt < mainLATENCY_INTERRUPTS; ulInterrupt++ )
+        {
+            vPortGenerateSimulatedInterrupt( mainINTERRUPT_NUMBER );
+
+            while( ulEventsHandled <= ulInterrupt )
+            {
+                vTaskDelay( 1 );
+            }
+        }
+
+        xMeasuringLatency = pdFALSE;
+        ulIsrTimeNs = ( uint32_t ) ( ullTotalIsrNs / mainLATENCY_INTERRUPTS );
+        ulMeanLatencyNs = ( uint32_t ) ( ullTotalLatencyNs / mainLATENCY_INTERRUPTS );
+
+        /* Measure the throughput by generating bursts of interrupts that
+         * arrive faster than the handler can run.  Each burst is generated
+         * with this task above the handler, so the events are held by the
+         * mechanism until this task lowers its priority, at which point the
+         * handler processes every event the mechanism held before this task
+         * runs again.  A binary semaphore can only hold one event, and the
+         * counting semaphore and queue only mainMAX_PENDING_EVENTS, so events
+         * beyond that are lost.  A notification counts any number of events, and
+         * the handler that clears it processes them all in one wake. */
+        ulEventsHandled = 0;
+        ulFailedSends = 0;
+        ullStartTime = ullBenchmarkTimerGetNanoseconds();
+
+        for( ulInterrupt = 0; ulInterrupt < mainTHROUGHPUT_INTERRUPTS; ulInterrupt++ )
+        {
+            if( ( ulInterrupt % mainBURST_LENGTH ) == 0UL )
+            {
+                vTaskPrioritySet( NULL, mainBURST_PRIORITY );
+            }
+
+            vPortGenerateSimulatedInterrupt( mainINTERRUPT_NUMBER );
+
+            if( ( ( ulInterrupt + 1UL ) % mainBURST_LENGTH ) == 0UL )
+            {
+                vTaskPrioritySet( NULL, mainBENCHMARK_PRIORITY );
+            }
+        }
+
+        vTaskPrioritySet( NULL, mainBENCHMARK_PRIORITY );
+
+        while( ( ulEventsHandled + ulFailedSends ) < mainTHROUGHPUT_INTERRUPTS )
+        {
+            vTaskDelay( 1 );
+        }
+
+        ullElapsedNs = ullBenchmarkTimerGetNanoseconds() - ullStartTime;
+
+        snprintf( cBuffer, sizeof( cBuffer ), "%-25s  %13lu  %17lu  %16lu  %13lu  %5lu  %11lu\r\n",
+                  pcMechanismNames[ eTest ],
+                  ( unsigned long ) ulIsrTimeNs,
+                  ( unsigned long ) ulMeanLatencyNs,
+                  ( unsigned long ) ullMaxLatencyNs,
+                  ( unsigned long ) ( ( ulEventsHandled * 1000000000ULL ) / ullElapsedNs ),
+                  ( unsigned long ) ulFailedSends,
+                  ( unsigned long ) xMechanismRam[ eTest ] );
+        vPrintString( cBuffer );
+    }
+
+    vPrintString( "\r\nThe pend function call RAM is the daemon task and its queue, which are shared with any software timers.\r\n" );
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t ulExampleInterruptHandler( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE, xSent = pdPASS;
+    uint64_t ullEntryTime = ullBenchmarkTimerGetNanoseconds();
+    uint32_t ulEvent = 0;
+
+    ullInterruptEntryNs = ullEntryTime;
+
+    /* Defer one event to the handler, in the same way as the example that
+     * introduced the mechanism. */
+    switch( eMechanism )
+    {
+        case eBinarySemaphore:
+            xSent = xSemaphoreGiveFromISR( xBinarySemaphore, &xHigherPriorityTaskWoken );
+            break;
+
+        case eCountingSemaphore:
+            xSent = xSemaphoreGiveFromISR( xCountingSemaphore, &xHigherPriorityTaskWoken );
+            break;
+
+        case ePendFunctionCall:
+            xSent = xTimerPendFunctionCallFromISR( vDeferredHandlingFunction, NULL, 0, &xHigherPriorityTaskWoken );
+            break;
+
+        case eQueue:
+            xSent = xQueueSendToBackFromISR( xEventQueue, &ulEvent, &xHigherPriorityTaskWoken );
+            break;
+
+        case eNotificationClear:
+            vTaskNotifyGiveFromISR( xNotificationClearTask, &xHigherPriorityTaskWoken );
+            break;
+
+        case eNotificationDecrement:
+            vTaskNotifyGiveFromISR( xNotificationDecrementTask, &xHigherPriorityTaskWoken );
+            break;
+
+        case eDeferredWork:
+        default:
+            xSent = xDeferredWorkPendFromISR( xDeferredWork, vDeferredHandlingFunction, NULL, 0, &xHigherPriorityTaskWoken );
+            break;
+    }
+
+    if( xSent != pdPASS )
+    {
+        ulFailedSends++;
+    }
+
+    ullTotalIsrNs += ullBenchmarkTimerGetNanoseconds() - ullEntryTime;
+
+    /* The implementation of portYIELD_FROM_ISR() used by the Windows port
+     * includes a return statement, which is why this function does not
+     * explicitly return a value. */
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+static void prvHandleEvent( void )
+{
+    uint64_t ullLatency;
+
+    /* While latency is being measured there is only ever one event
+     * outstanding, so it was generated by the most recent interrupt. */
+    if( xMeasuringLatency != pdFALSE )
+    {
+        ullLatency = ullBenchmarkTimerGetNanoseconds() - ullInterruptEntryNs;
+        ullTotalLatencyNs += ullLatency;
+
+        if( ullLatency > ullMaxLatencyNs )
+        {
+            ullMaxLatencyNs = ullLatency;
+        }
+    }
+
+    ulEventsHandled++;
+}
+/*-----------------------------------------------------------*/
+
+static void vBinarySemaphoreHandlerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        xSemaphoreTake( xBinarySemaphore, portMAX_DELAY );
+        prvHandleEvent();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vCountingSemaphoreHandlerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        xSemaphoreTake( xCountingSemaphore, portMAX_DELAY );
+        prvHandleEvent();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vQueueHandlerTask( void * pvParameters )
+{
+    uint32_t ulEvent;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        xQueueReceive( xEventQueue, &ulEvent, portMAX_DELAY );
+        prvHandleEvent();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vNotificationClearHandlerTask( void * pvParameters )
+{
+    uint32_t ulEventsToProcess;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* The notification value is cleared to zero, so every event that
+         * occurred since the task last ran is processed. */
+        ulEventsToProcess = ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        while( ulEventsToProcess > 0 )
+        {
+            prvHandleEvent();
+            ulEventsToProcess--;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vNotificationDecrementHandlerTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* The notification value is decremented, so one event is processed
+         * each time the task takes the notification. */
+        if( ulTaskNotifyTake( pdFALSE, portMAX_DELAY ) != 0 )
+        {
+            prvHandleEvent();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void vDeferredHandlingFunction( void * pvParameter1,
+                                       uint32_t ulParameter2 )
+{
+    ( void ) pvParameter1;
+    ( void ) ulParameter2;
+
+    prvHandleEvent();
+}
+/*-----------------------------------------------------------*/
+
+static void prvRamMeasurementTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
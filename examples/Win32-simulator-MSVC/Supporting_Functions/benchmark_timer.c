@@ -0,0 +1,59 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* Standard includes. */
+#include <windows.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+
+/* Demo includes. */
+#include "benchmark_timer.h"
+
+/* The frequency of the Windows performance counter, which is fixed at boot. */
+static uint64_t ullCounterFrequency = 0;
+
+/*-----------------------------------------------------------*/
+
+void vBenchmarkTimerInit( void )
+{
+    LARGE_INTEGER xFrequency;
+
+    QueryPerformanceFrequency( &xFrequency );
+    ullCounterFrequency = ( uint64_t ) xFrequency.QuadPart;
+}
+/*-----------------------------------------------------------*/
+
+uint64_t ullBenchmarkTimerGetNanoseconds( void )
+{
+    LARGE_INTEGER xCount;
+    uint64_t ullCount;
+
+    configASSERT( ullCounterFrequency != 0 );
+
+    QueryPerformanceCounter( &xCount );
+    ullCount = ( uint64_t ) xCount.QuadPart;
+
+    /* Convert whole seconds and the remainder separately so the intermediate
+     * product cannot overflow. */
+    return ( ( ullCount / ullCounterFrequency ) * 1000000000ULL ) +
+           ( ( ( ullCount % ullCounterFrequency ) * 1000000000ULL ) / ullCounterFrequency );
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulBenchmarkTimerGetMicroseconds( void )
+{
+    return ( uint32_t ) ( ullBenchmarkTimerGetNanoseconds() / 1000ULL );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,38 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef BENCHMARK_TIMER_H
+#define BENCHMARK_TIMER_H
+
+/*
+ * A free running high resolution time base for the benchmark examples.  The
+ * tick count only has a resolution of one tick, which is far too coarse to time
+ * individual API calls, so the Windows performance counter is used instead.
+ *
+ * vBenchmarkTimerInit() and ulBenchmarkTimerGetMicroseconds() are also suitable
+ * for use as portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() and
+ * portGET_RUN_TIME_COUNTER_VALUE() respectively.
+ */
+
+/* Must be called once, before any of the other functions are used. */
+void vBenchmarkTimerInit( void );
+
+/* Return the time since an arbitrary point in the past, in nanoseconds. */
+uint64_t ullBenchmarkTimerGetNanoseconds( void );
+
+/* Return the time since an arbitrary point in the past, in microseconds.
+ * The value wraps every 71 minutes, so only differences are meaningful. */
+uint32_t ulBenchmarkTimerGetMicroseconds( void );
+
+#endif /* BENCHMARK_TIMER_H */
@@ -0,0 +1,351 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/*
+ * Fixed size buffer pool.  See buffer_pool.h for a description.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "buffer_pool.h"
+
+/* Round a size up to a multiple of portBYTE_ALIGNMENT. */
+#define bufferpoolALIGN( x )    ( ( ( size_t ) ( x ) + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+#if ( bufferpoolTRACK_OWNERSHIP == 1 )
+
+/* When ownership is tracked each block is preceded by a header. */
+    typedef struct BlockHeader
+    {
+        TaskHandle_t xOwner;
+        BaseType_t xInUse;
+    } BlockHeader_t;
+
+    #define bufferpoolHEADER_SIZE    bufferpoolALIGN( sizeof( BlockHeader_t ) )
+#else
+    #define bufferpoolHEADER_SIZE    0
+#endif
+
+/* A free block holds a pointer to the next free block, so the free blocks form
+ * a singly linked list that can be taken from and added to in constant time. */
+typedef struct FreeBlock
+{
+    struct FreeBlock * pxNext;
+} FreeBlock_t;
+
+typedef struct BufferPool
+{
+    uint8_t * pucFirstBlock; /* Points to the first block, not its header. */
+    size_t xBlockStride;     /* Distance between the start of adjacent blocks, including any header. */
+    FreeBlock_t * pxFreeList;
+    BufferPoolStats_t xStats;
+} BufferPool_t;
+
+/* Take a block from the free list, or put one back.  Must be called from
+ * within a critical section. */
+static void * prvTakeBlock( BufferPool_t * pxPool,
+                            TaskHandle_t xOwner );
+static void prvGiveBlock( BufferPool_t * pxPool,
+                          void * pvBlock );
+
+#if ( bufferpoolTRACK_OWNERSHIP == 1 )
+    static BlockHeader_t * prvGetHeader( const void * pvBlock );
+#endif
+
+/*-----------------------------------------------------------*/
+
+BufferPoolHandle_t xBufferPoolCreate( size_t xBlockSize,
+                                      UBaseType_t uxNumBlocks )
+{
+    BufferPool_t * pxPool;
+    size_t xStride;
+    uint8_t * pucBlock;
+    UBaseType_t ux;
+
+    configASSERT( uxNumBlocks > 0 );
+
+    /* A free block must be large enough to hold the free list pointer. */
+    if( xBlockSize < sizeof( FreeBlock_t ) )
+    {
+        xBlockSize = sizeof( FreeBlock_t );
+    }
+
+    xStride = bufferpoolHEADER_SIZE + bufferpoolALIGN( xBlockSize );
+
+    /* Allocate the pool structure and all its blocks in one go. */
+    pxPool = ( BufferPool_t * ) pvPortMalloc( bufferpoolALIGN( sizeof( BufferPool_t ) ) + ( xStride * uxNumBlocks ) );
+
+    if( pxPool != NULL )
+    {
+        pxPool->pucFirstBlock = ( ( uint8_t * ) pxPool ) + bufferpoolALIGN( sizeof( BufferPool_t ) ) + bufferpoolHEADER_SIZE;
+        pxPool->xBlockStride = xStride;
+        pxPool->pxFreeList = NULL;
+
+        /* Build the free list backwards so blocks are first handed out in
+         * address order. */
+        for( ux = uxNumBlocks; ux > 0; ux-- )
+        {
+            pucBlock = pxPool->pucFirstBlock + ( ( ux - 1 ) * xStride );
+
+            #if ( bufferpoolTRACK_OWNERSHIP == 1 )
+            {
+                prvGetHeader( pucBlock )->xOwner = NULL;
+                prvGetHeader( pucBlock )->xInUse = pdFALSE;
+            }
+            #endif
+
+            ( ( FreeBlock_t * ) pucBlock )->pxNext = pxPool->pxFreeList;
+            pxPool->pxFreeList = ( FreeBlock_t * ) pucBlock;
+        }
+
+        pxPool->xStats.uxNumBlocks = uxNumBlocks;
+        pxPool->xStats.uxFreeBlocks = uxNumBlocks;
+        pxPool->xStats.uxMinimumEverFreeBlocks = uxNumBlocks;
+        pxPool->xStats.ulSuccessfulGets = 0;
+        pxPool->xStats.ulFailedGets = 0;
+    }
+
+    return pxPool;
+}
+/*-----------------------------------------------------------*/
+
+void * pvBufferPoolGet( BufferPoolHandle_t xPool )
+{
+    void * pvBlock;
+
+    taskENTER_CRITICAL();
+    {
+        pvBlock = prvTakeBlock( xPool, xTaskGetCurrentTaskHandle() );
+    }
+    taskEXIT_CRITICAL();
+
+    return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+void vBufferPoolReturn( BufferPoolHandle_t xPool,
+                        void * pvBlock )
+{
+    taskENTER_CRITICAL();
+    {
+        prvGiveBlock( xPool, pvBlock );
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void * pvBufferPoolGetFromISR( BufferPoolHandle_t xPool )
+{
+    void * pvBlock;
+    UBaseType_t uxSavedInterruptStatus;
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        pvBlock = prvTakeBlock( xPool, NULL );
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+void vBufferPoolReturnFromISR( BufferPoolHandle_t xPool,
+                               void * pvBlock )
+{
+    UBaseType_t uxSavedInterruptStatus;
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        prvGiveBlock( xPool, pvBlock );
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vBufferPoolClaim( BufferPoolHandle_t xPool,
+                       void * pvBlock )
+{
+    configASSERT( xBufferPoolContains( xPool, pvBlock ) != pdFALSE );
+
+    #if ( bufferpoolTRACK_OWNERSHIP == 1 )
+    {
+        configASSERT( prvGetHeader( pvBlock )->xInUse != pdFALSE );
+
+        /* Only the owner can access the block, so no critical section is
+         * needed. */
+        prvGetHeader( pvBlock )->xOwner = xTaskGetCurrentTaskHandle();
+    }
+    #else
+    {
+        ( void ) pvBlock;
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xBufferPoolGetOwner( BufferPoolHandle_t xPool,
+                                  const void * pvBlock )
+{
+    configASSERT( xBufferPoolContains( xPool, pvBlock ) != pdFALSE );
+
+    #if ( bufferpoolTRACK_OWNERSHIP == 1 )
+    {
+        return prvGetHeader( pvBlock )->xOwner;
+    }
+    #else
+    {
+        ( void ) pvBlock;
+        return NULL;
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxBufferPoolCountOwnedBlocks( BufferPoolHandle_t xPool,
+                                          TaskHandle_t xTask )
+{
+    UBaseType_t uxCount = 0;
+
+    #if ( bufferpoolTRACK_OWNERSHIP == 1 )
+    {
+        UBaseType_t ux;
+        const BlockHeader_t * pxHeader;
+
+        for( ux = 0; ux < xPool->xStats.uxNumBlocks; ux++ )
+        {
+            pxHeader = prvGetHeader( xPool->pucFirstBlock + ( ux * xPool->xBlockStride ) );
+
+            if( ( pxHeader->xInUse != pdFALSE ) && ( pxHeader->xOwner == xTask ) )
+            {
+                uxCount++;
+            }
+        }
+    }
+    #else
+    {
+        ( void ) xPool;
+        ( void ) xTask;
+    }
+    #endif
+
+    return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xBufferPoolContains( BufferPoolHandle_t xPool,
+                                const void * pvBlock )
+{
+    const uint8_t * pucBlock = ( const uint8_t * ) pvBlock;
+    BaseType_t xReturn = pdFALSE;
+    size_t xOffset;
+
+    if( pucBlock >= xPool->pucFirstBlock )
+    {
+        xOffset = ( size_t ) ( pucBlock - xPool->pucFirstBlock );
+
+        /* The pointer must be to the start of a block, not just somewhere in
+         * the pool. */
+        if( ( xOffset < ( xPool->xBlockStride * xPool->xStats.uxNumBlocks ) ) &&
+            ( ( xOffset % xPool->xBlockStride ) == 0 ) )
+        {
+            xReturn = pdTRUE;
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vBufferPoolGetStats( BufferPoolHandle_t xPool,
+                          BufferPoolStats_t * pxStats )
+{
+    taskENTER_CRITICAL();
+    {
+        *pxStats = xPool->xStats;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void * prvTakeBlock( BufferPool_t * pxPool,
+                            TaskHandle_t xOwner )
+{
+    FreeBlock_t * pxBlock = pxPool->pxFreeList;
+
+    if( pxBlock != NULL )
+    {
+        pxPool->pxFreeList = pxBlock->pxNext;
+        pxPool->xStats.uxFreeBlocks--;
+        pxPool->xStats.ulSuccessfulGets++;
+
+        if( pxPool->xStats.uxFreeBlocks < pxPool->xStats.uxMinimumEverFreeBlocks )
+        {
+            pxPool->xStats.uxMinimumEverFreeBlocks = pxPool->xStats.uxFreeBlocks;
+        }
+
+        #if ( bufferpoolTRACK_OWNERSHIP == 1 )
+        {
+            prvGetHeader( pxBlock )->xOwner = xOwner;
+            prvGetHeader( pxBlock )->xInUse = pdTRUE;
+        }
+        #else
+        {
+            ( void ) xOwner;
+        }
+        #endif
+    }
+    else
+    {
+        pxPool->xStats.ulFailedGets++;
+    }
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvGiveBlock( BufferPool_t * pxPool,
+                          void * pvBlock )
+{
+    FreeBlock_t * pxBlock = ( FreeBlock_t * ) pvBlock;
+
+    /* Catch blocks that did not come from this pool. */
+    configASSERT( xBufferPoolContains( pxPool, pvBlock ) != pdFALSE );
+
+    #if ( bufferpoolTRACK_OWNERSHIP == 1 )
+    {
+        /* Catch blocks that are returned more than once. */
+        configASSERT( prvGetHeader( pvBlock )->xInUse != pdFALSE );
+        prvGetHeader( pvBlock )->xOwner = NULL;
+        prvGetHeader( pvBlock )->xInUse = pdFALSE;
+    }
+    #endif
+
+    pxBlock->pxNext = pxPool->pxFreeList;
+    pxPool->pxFreeList = pxBlock;
+    pxPool->xStats.uxFreeBlocks++;
+}
+/*-----------------------------------------------------------*/
+
+#if ( bufferpoolTRACK_OWNERSHIP == 1 )
+
+    static BlockHeader_t * prvGetHeader( const void * pvBlock )
+    {
+        return ( BlockHeader_t * ) ( ( ( uint8_t * ) pvBlock ) - bufferpoolHEADER_SIZE );
+    }
+
+#endif
+/*-----------------------------------------------------------*/
@@ -0,0 +1,126 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+/*
+ * A pool of fixed size buffers for use with queues that hold pointers.
+ *
+ * Listings 5.13 to 5.15 in the book send a pointer to a buffer through a
+ * queue.  If the buffers are obtained from pvPortMalloc() and released with
+ * vPortFree() then every message costs two heap operations, each of which
+ * suspends the scheduler and searches the heap, and a long running system risks
+ * fragmenting the heap.  A buffer pool instead pre-allocates a fixed number of
+ * equally sized blocks when it is created.  Obtaining and returning a block
+ * takes a short critical section and a constant amount of time however many
+ * blocks are in use, and can also be done from an interrupt.
+ *
+ * Every pool keeps statistics that show how close it has come to running out
+ * of blocks, and how often it has run out.  If bufferpoolTRACK_OWNERSHIP is set
+ * to 1 in FreeRTOSConfig.h then each block also records the task that owns it,
+ * returning a block that is not in use (for example, returning the same block
+ * twice) triggers configASSERT(), and the blocks held by a task can be counted
+ * to find leaks.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Set to 1 in FreeRTOSConfig.h to record the owner of each block. */
+#ifndef bufferpoolTRACK_OWNERSHIP
+    #define bufferpoolTRACK_OWNERSHIP    0
+#endif
+
+/* Statistics returned by vBufferPoolGetStats(). */
+typedef struct BufferPoolStats
+{
+    UBaseType_t uxNumBlocks;             /* The number of blocks in the pool. */
+    UBaseType_t uxFreeBlocks;            /* The number of blocks not currently in use. */
+    UBaseType_t uxMinimumEverFreeBlocks; /* The lowest uxFreeBlocks has been since the pool was created. */
+    uint32_t ulSuccessfulGets;           /* The number of blocks obtained from the pool. */
+    uint32_t ulFailedGets;               /* The number of times a block was requested when none were free. */
+} BufferPoolStats_t;
+
+typedef struct BufferPool * BufferPoolHandle_t;
+
+/*
+ * Create a pool of uxNumBlocks blocks, each of which can hold at least
+ * xBlockSize bytes and is aligned to portBYTE_ALIGNMENT.  The pool and all its
+ * blocks are allocated with a single call to pvPortMalloc().  Returns NULL if
+ * there was insufficient heap memory.
+ */
+BufferPoolHandle_t xBufferPoolCreate( size_t xBlockSize,
+                                      UBaseType_t uxNumBlocks );
+
+/*
+ * Obtain a block from the pool.  Returns NULL, without blocking, if all the
+ * blocks are in use.  If ownership is tracked the calling task becomes the
+ * owner of the block.
+ */
+void * pvBufferPoolGet( BufferPoolHandle_t xPool );
+
+/*
+ * Return a block obtained from xPool to xPool.  Any task can return a block,
+ * not just the task that obtained it.
+ */
+void vBufferPoolReturn( BufferPoolHandle_t xPool,
+                        void * pvBlock );
+
+/*
+ * Versions of pvBufferPoolGet() and vBufferPoolReturn() that can be called
+ * from an interrupt service routine.  A block obtained from an interrupt has no
+ * owner until a task claims it.
+ */
+void * pvBufferPoolGetFromISR( BufferPoolHandle_t xPool );
+void vBufferPoolReturnFromISR( BufferPoolHandle_t xPool,
+                               void * pvBlock );
+
+/*
+ * Make the calling task the owner of a block it received from another task or
+ * an interrupt - normally called straight after the pointer to the block is
+ * received from a queue.  Does nothing if ownership is not tracked.
+ */
+void vBufferPoolClaim( BufferPoolHandle_t xPool,
+                       void * pvBlock );
+
+/*
+ * Return the task that owns a block, or NULL if the block was obtained from an
+ * interrupt and not yet claimed, or if ownership is not tracked.
+ */
+TaskHandle_t xBufferPoolGetOwner( BufferPoolHandle_t xPool,
+                                  const void * pvBlock );
+
+/*
+ * Count the blocks owned by xTask.  Unlike the other functions this examines
+ * every block in the pool, so is intended for debugging.  Always returns 0 if
+ * ownership is not tracked.
+ */
+UBaseType_t uxBufferPoolCountOwnedBlocks( BufferPoolHandle_t xPool,
+                                          TaskHandle_t xTask );
+
+/*
+ * Returns pdTRUE if pvBlock points to a block within xPool, otherwise pdFALSE.
+ */
+BaseType_t xBufferPoolContains( BufferPoolHandle_t xPool,
+                                const void * pvBlock );
+
+/*
+ * Copy out the pool's statistics.
+ */
+void vBufferPoolGetStats( BufferPoolHandle_t xPool,
+                          BufferPoolStats_t * pxStats );
+
+#endif /* BUFFER_POOL_H */
@@ -0,0 +1,162 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+
+/* Demo includes. */
+#include "bulk_create.h"
+
+#if ( configSUPPORT_STATIC_ALLOCATION != 1 )
+    #error configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h to use bulk_create.c
+#endif
+
+/* Round a size up so the next object carved from the block is aligned. */
+#define bulkALIGN( x )    ( ( ( size_t ) ( x ) + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/*
+ * Walk every object in pxSet, adding up the memory each requires.  If pucBlock
+ * is not NULL then the objects are also created, each using the part of
+ * pucBlock at its offset.  Using the same function for both guarantees the
+ * size calculation and the layout can never disagree.
+ */
+static size_t prvLayoutSet( const BulkCreateSet_t * pxSet,
+                            uint8_t * pucBlock );
+
+/*-----------------------------------------------------------*/
+
+size_t xBulkCreateGetRequiredSize( const BulkCreateSet_t * pxSet )
+{
+    return prvLayoutSet( pxSet, NULL );
+}
+/*-----------------------------------------------------------*/
+
+void * pvBulkCreate( const BulkCreateSet_t * pxSet,
+                     void * pvBuffer )
+{
+    if( pvBuffer == NULL )
+    {
+        pvBuffer = pvPortMalloc( prvLayoutSet( pxSet, NULL ) );
+    }
+
+    if( pvBuffer != NULL )
+    {
+        configASSERT( ( ( size_t ) pvBuffer & portBYTE_ALIGNMENT_MASK ) == 0 );
+        ( void ) prvLayoutSet( pxSet, ( uint8_t * ) pvBuffer );
+    }
+
+    return pvBuffer;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvLayoutSet( const BulkCreateSet_t * pxSet,
+                            uint8_t * pucBlock )
+{
+    size_t xOffset = 0, xObjectOffset, xStorageOffset, xStorageSize, x;
+    const BulkTaskParameters_t * pxTask;
+    const BulkQueueParameters_t * pxQueue;
+    const BulkTimerParameters_t * pxTimer;
+    TaskHandle_t xTask;
+    QueueHandle_t xQueue;
+    TimerHandle_t xTimer;
+
+    configASSERT( pxSet != NULL );
+
+    for( x = 0; x < pxSet->xNumTasks; x++ )
+    {
+        pxTask = &( pxSet->pxTasks[ x ] );
+
+        /* Each task needs a task control block followed by its stack. */
+        xObjectOffset = xOffset;
+        xOffset += bulkALIGN( sizeof( StaticTask_t ) );
+        xStorageOffset = xOffset;
+        xOffset += bulkALIGN( pxTask->ulStackDepth * sizeof( StackType_t ) );
+
+        if( pucBlock != NULL )
+        {
+            xTask = xTaskCreateStatic( pxTask->pxTaskCode,
+                                       pxTask->pcName,
+                                       pxTask->ulStackDepth,
+                                       pxTask->pvParameters,
+                                       pxTask->uxPriority,
+                                       ( StackType_t * ) &( pucBlock[ xStorageOffset ] ),
+                                       ( StaticTask_t * ) &( pucBlock[ xObjectOffset ] ) );
+            configASSERT( xTask != NULL );
+
+            if( pxTask->pxCreatedTask != NULL )
+            {
+                *( pxTask->pxCreatedTask ) = xTask;
+            }
+        }
+    }
+
+    for( x = 0; x < pxSet->xNumQueues; x++ )
+    {
+        pxQueue = &( pxSet->pxQueues[ x ] );
+
+        /* Each queue needs a queue structure followed by its storage area. */
+        xStorageSize = ( size_t ) pxQueue->uxQueueLength * ( size_t ) pxQueue->uxItemSize;
+        xObjectOffset = xOffset;
+        xOffset += bulkALIGN( sizeof( StaticQueue_t ) );
+        xStorageOffset = xOffset;
+        xOffset += bulkALIGN( xStorageSize );
+
+        if( pucBlock != NULL )
+        {
+            /* Queues with a zero item size, such as those used as semaphores,
+             * have no storage area. */
+            xQueue = xQueueCreateStatic( pxQueue->uxQueueLength,
+                                         pxQueue->uxItemSize,
+                                         ( xStorageSize > 0 ) ? &( pucBlock[ xStorageOffset ] ) : NULL,
+                                         ( StaticQueue_t * ) &( pucBlock[ xObjectOffset ] ) );
+            configASSERT( xQueue != NULL );
+
+            if( pxQueue->pxCreatedQueue != NULL )
+            {
+                *( pxQueue->pxCreatedQueue ) = xQueue;
+            }
+        }
+    }
+
+    for( x = 0; x < pxSet->xNumTimers; x++ )
+    {
+        pxTimer = &( pxSet->pxTimers[ x ] );
+
+        /* Each timer only needs a timer structure. */
+        xObjectOffset = xOffset;
+        xOffset += bulkALIGN( sizeof( StaticTimer_t ) );
+
+        if( pucBlock != NULL )
+        {
+            xTimer = xTimerCreateStatic( pxTimer->pcTimerName,
+                                         pxTimer->xTimerPeriodInTicks,
+                                         pxTimer->xAutoReload,
+                                         pxTimer->pvTimerID,
+                                         pxTimer->pxCallbackFunction,
+                                         ( StaticTimer_t * ) &( pucBlock[ xObjectOffset ] ) );
+            configASSERT( xTimer != NULL );
+
+            if( pxTimer->pxCreatedTimer != NULL )
+            {
+                *( pxTimer->pxCreatedTimer ) = xTimer;
+            }
+        }
+    }
+
+    return xOffset;
+}
+/*-----------------------------------------------------------*/
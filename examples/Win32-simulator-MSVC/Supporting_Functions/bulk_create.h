@@ -0,0 +1,98 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef BULK_CREATE_H
+#define BULK_CREATE_H
+
+/*
+ * Create a large number of tasks, queues and software timers using a single
+ * memory allocation.
+ *
+ * Creating each object with xTaskCreate(), xQueueCreate() or xTimerCreate()
+ * costs one or two calls to pvPortMalloc(), each of which walks the heap's free
+ * list and adds a block header to the allocated memory.  pvBulkCreate() instead
+ * obtains the total RAM needed by every object in the set, as calculated by
+ * xBulkCreateGetRequiredSize(), with one call to pvPortMalloc() (or uses a
+ * buffer provided by the caller), then carves the block up between the objects
+ * and creates them with the xTaskCreateStatic(), xQueueCreateStatic() and
+ * xTimerCreateStatic() API functions.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h.  Objects
+ * created this way must never be deleted individually.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+
+/* Describes one task to create.  The members are the parameters that would
+ * otherwise be passed to xTaskCreate(). */
+typedef struct BulkTaskParameters
+{
+    TaskFunction_t pxTaskCode;
+    const char * pcName;
+    uint32_t ulStackDepth;
+    void * pvParameters;
+    UBaseType_t uxPriority;
+    TaskHandle_t * pxCreatedTask; /* Can be NULL if the handle is not needed. */
+} BulkTaskParameters_t;
+
+/* Describes one queue to create. */
+typedef struct BulkQueueParameters
+{
+    UBaseType_t uxQueueLength;
+    UBaseType_t uxItemSize;
+    QueueHandle_t * pxCreatedQueue;
+} BulkQueueParameters_t;
+
+/* Describes one software timer to create. */
+typedef struct BulkTimerParameters
+{
+    const char * pcTimerName;
+    TickType_t xTimerPeriodInTicks;
+    BaseType_t xAutoReload;
+    void * pvTimerID;
+    TimerCallbackFunction_t pxCallbackFunction;
+    TimerHandle_t * pxCreatedTimer;
+} BulkTimerParameters_t;
+
+/* The complete set of objects to create. */
+typedef struct BulkCreateSet
+{
+    const BulkTaskParameters_t * pxTasks;
+    size_t xNumTasks;
+    const BulkQueueParameters_t * pxQueues;
+    size_t xNumQueues;
+    const BulkTimerParameters_t * pxTimers;
+    size_t xNumTimers;
+} BulkCreateSet_t;
+
+/*
+ * Return the number of bytes of RAM required to create every object in pxSet.
+ */
+size_t xBulkCreateGetRequiredSize( const BulkCreateSet_t * pxSet );
+
+/*
+ * Create every object in pxSet.  If pvBuffer is NULL the memory is obtained
+ * from the FreeRTOS heap in a single allocation, otherwise pvBuffer must point
+ * to at least xBulkCreateGetRequiredSize() bytes aligned to
+ * portBYTE_ALIGNMENT.  Returns a pointer to the memory used, or NULL if the
+ * memory could not be allocated, in which case no objects were created.
+ */
+void * pvBulkCreate( const BulkCreateSet_t * pxSet,
+                     void * pvBuffer );
+
+#endif /* BULK_CREATE_H */
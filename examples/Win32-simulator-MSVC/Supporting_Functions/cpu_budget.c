@@ -0,0 +1,201 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/*
+ * Per task CPU budget enforcement.  See cpu_budget.h for a description.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "cpu_budget.h"
+
+#if ( configGENERATE_RUN_TIME_STATS != 1 ) || ( configUSE_APPLICATION_TASK_TAG != 1 )
+    #error cpu_budget.c requires configGENERATE_RUN_TIME_STATS and configUSE_APPLICATION_TASK_TAG to be set to 1 in FreeRTOSConfig.h
+#endif
+
+/* The task that enforces the budgets. */
+static void prvSupervisorTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+/* The head of the singly linked list of registered budgets. */
+static CpuBudget_t * pxBudgetList = NULL;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xCpuBudgetStart( UBaseType_t uxPriority )
+{
+    return xTaskCreate( prvSupervisorTask, "Budget", 1000, NULL, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vCpuBudgetRegister( CpuBudget_t * pxBudget,
+                         TaskHandle_t xTask,
+                         uint32_t ulBudgetUs,
+                         uint32_t ulPeriodUs,
+                         CpuBudgetAction_t eAction,
+                         UBaseType_t uxDemotedPriority )
+{
+    configASSERT( pxBudget != NULL );
+    configASSERT( xTask != NULL );
+    configASSERT( ulBudgetUs <= ulPeriodUs );
+
+    pxBudget->xTask = xTask;
+    pxBudget->ulBudgetUs = ulBudgetUs;
+    pxBudget->ulPeriodUs = ulPeriodUs;
+    pxBudget->eAction = eAction;
+    pxBudget->uxDemotedPriority = uxDemotedPriority;
+    pxBudget->uxNormalPriority = uxTaskPriorityGet( xTask );
+    pxBudget->ulSwitchedInTime = 0;
+    pxBudget->ulPeriodStartTime = 0;
+    pxBudget->ulConsumedUs = 0;
+    pxBudget->xPeriodActive = pdFALSE;
+    pxBudget->xThrottled = pdFALSE;
+    pxBudget->ulOverrunCount = 0;
+
+    /* Link the budget into the list walked by the supervisor, then attach it
+     * to the task so the trace macros can find it without searching. */
+    pxBudget->pxNext = pxBudgetList;
+    pxBudgetList = pxBudget;
+    vTaskSetApplicationTaskTag( xTask, ( TaskHookFunction_t ) pxBudget );
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulCpuBudgetGetOverrunCount( const CpuBudget_t * pxBudget )
+{
+    return pxBudget->ulOverrunCount;
+}
+/*-----------------------------------------------------------*/
+
+void vCpuBudgetTaskSwitchedIn( void )
+{
+    CpuBudget_t * pxBudget;
+    uint32_t ulTimeNow;
+
+    /* Passing NULL obtains the tag of the task that is about to run. */
+    pxBudget = ( CpuBudget_t * ) xTaskGetApplicationTaskTagFromISR( NULL );
+
+    if( pxBudget != NULL )
+    {
+        ulTimeNow = portGET_RUN_TIME_COUNTER_VALUE();
+        pxBudget->ulSwitchedInTime = ulTimeNow;
+
+        /* A replenishment period starts the first time the task runs after
+         * its budget was last replenished. */
+        if( pxBudget->xPeriodActive == pdFALSE )
+        {
+            pxBudget->ulPeriodStartTime = ulTimeNow;
+            pxBudget->xPeriodActive = pdTRUE;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vCpuBudgetTaskSwitchedOut( void )
+{
+    CpuBudget_t * pxBudget;
+
+    /* Passing NULL obtains the tag of the task that is about to stop
+     * running. */
+    pxBudget = ( CpuBudget_t * ) xTaskGetApplicationTaskTagFromISR( NULL );
+
+    if( pxBudget != NULL )
+    {
+        pxBudget->ulConsumedUs += ( uint32_t ) portGET_RUN_TIME_COUNTER_VALUE() - pxBudget->ulSwitchedInTime;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvSupervisorTask( void * pvParameters )
+{
+    const TickType_t xEnforcementPeriod = pdMS_TO_TICKS( cpubudgetENFORCEMENT_PERIOD_MS );
+    TickType_t xLastWakeTime;
+    CpuBudget_t * pxBudget;
+    uint32_t ulTimeNow, ulConsumed;
+    BaseType_t xReplenish;
+
+    ( void ) pvParameters;
+
+    xLastWakeTime = xTaskGetTickCount();
+
+    for( ; ; )
+    {
+        vTaskDelayUntil( &xLastWakeTime, ( xEnforcementPeriod > 0 ) ? xEnforcementPeriod : 1 );
+
+        /* This task is the highest priority task, so every other task was
+         * switched out when it started running and the consumed times are up to
+         * date. */
+        for( pxBudget = pxBudgetList; pxBudget != NULL; pxBudget = pxBudget->pxNext )
+        {
+            /* The trace macros update the budget inside the scheduler, so take a
+             * consistent copy, and reset the budget if the period has ended, in a
+             * critical section. */
+            taskENTER_CRITICAL();
+            {
+                ulTimeNow = portGET_RUN_TIME_COUNTER_VALUE();
+                ulConsumed = pxBudget->ulConsumedUs;
+                xReplenish = ( ( pxBudget->xPeriodActive != pdFALSE ) &&
+                               ( ( ulTimeNow - pxBudget->ulPeriodStartTime ) >= pxBudget->ulPeriodUs ) );
+
+                if( xReplenish != pdFALSE )
+                {
+                    /* The next period starts the next time the task runs. */
+                    pxBudget->ulConsumedUs = 0;
+                    pxBudget->xPeriodActive = pdFALSE;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xReplenish != pdFALSE )
+            {
+                if( pxBudget->xThrottled != pdFALSE )
+                {
+                    /* Restore the task to its state before it was throttled. */
+                    if( pxBudget->eAction == eCpuBudgetDemote )
+                    {
+                        vTaskPrioritySet( pxBudget->xTask, pxBudget->uxNormalPriority );
+                    }
+                    else
+                    {
+                        vTaskResume( pxBudget->xTask );
+                    }
+
+                    pxBudget->xThrottled = pdFALSE;
+                }
+            }
+            else if( ( pxBudget->xThrottled == pdFALSE ) && ( ulConsumed >= pxBudget->ulBudgetUs ) )
+            {
+                /* The task has used all its budget for this period. */
+                pxBudget->ulOverrunCount++;
+                pxBudget->xThrottled = pdTRUE;
+
+                if( pxBudget->eAction == eCpuBudgetDemote )
+                {
+                    /* Remember the priority in case the application changed it
+                     * since the task was registered. */
+                    pxBudget->uxNormalPriority = uxTaskPriorityGet( pxBudget->xTask );
+                    vTaskPrioritySet( pxBudget->xTask, pxBudget->uxDemotedPriority );
+                }
+                else
+                {
+                    vTaskSuspend( pxBudget->xTask );
+                }
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,121 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef CPU_BUDGET_H
+#define CPU_BUDGET_H
+
+/*
+ * Per task CPU budget enforcement.
+ *
+ * A task that never blocks will starve every task of lower priority, and share
+ * the CPU with every task of equal priority, for as long as it runs.  This
+ * module limits the damage such a task can do.  Each registered task is given a
+ * budget of CPU time that it may consume within a replenishment period.  The
+ * replenishment period starts the first time the task runs after its budget was
+ * last replenished, in the style of a sporadic server.  If the task consumes its
+ * whole budget before the period ends it is either demoted to a lower priority
+ * or suspended until the end of the period, at which point its budget is
+ * replenished and its original state restored.
+ *
+ * The time each task consumes is measured in the traceTASK_SWITCHED_IN() and
+ * traceTASK_SWITCHED_OUT() trace macros using the run time stats clock.  Budgets
+ * are enforced by a supervisor task, because the trace macros execute inside the
+ * scheduler and cannot themselves change the state of a task.  The supervisor
+ * runs every cpubudgetENFORCEMENT_PERIOD_MS, so that is also the most by which a
+ * task can overrun its budget.
+ *
+ * FreeRTOSConfig.h must contain:
+ *
+ *  #define configGENERATE_RUN_TIME_STATS    1
+ *  #define configUSE_APPLICATION_TASK_TAG   1
+ *  #define traceTASK_SWITCHED_IN()          vCpuBudgetTaskSwitchedIn()
+ *  #define traceTASK_SWITCHED_OUT()         vCpuBudgetTaskSwitchedOut()
+ *
+ * along with definitions of portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() and
+ * portGET_RUN_TIME_COUNTER_VALUE() that provide a microsecond time base.  The
+ * application task tag of each registered task is used by this module, so must
+ * not be used for anything else.
+ */
+
+/* How often the supervisor task checks budgets.  Can be overridden in
+ * FreeRTOSConfig.h. */
+#ifndef cpubudgetENFORCEMENT_PERIOD_MS
+    #define cpubudgetENFORCEMENT_PERIOD_MS    1UL
+#endif
+
+/* What happens to a task that exhausts its budget. */
+typedef enum
+{
+    eCpuBudgetDemote = 0, /* Lower the priority of the task until replenishment. */
+    eCpuBudgetSuspend     /* Suspend the task until replenishment. */
+} CpuBudgetAction_t;
+
+/* The state kept for each registered task.  The application provides the
+ * memory, but must not access the members directly. */
+typedef struct CpuBudget
+{
+    struct CpuBudget * pxNext;
+    TaskHandle_t xTask;
+    uint32_t ulBudgetUs;
+    uint32_t ulPeriodUs;
+    CpuBudgetAction_t eAction;
+    UBaseType_t uxDemotedPriority;
+    UBaseType_t uxNormalPriority;
+
+    /* Updated by the trace macros. */
+    uint32_t ulSwitchedInTime;
+    uint32_t ulPeriodStartTime;
+    uint32_t ulConsumedUs;
+    BaseType_t xPeriodActive;
+
+    /* Updated by the supervisor task. */
+    BaseType_t xThrottled;
+    uint32_t ulOverrunCount;
+} CpuBudget_t;
+
+/*
+ * Create the supervisor task that enforces budgets, at priority uxPriority.
+ * The supervisor should be the highest priority task in the system.
+ */
+BaseType_t xCpuBudgetStart( UBaseType_t uxPriority );
+
+/*
+ * Give xTask a budget of ulBudgetUs microseconds of CPU time in every
+ * ulPeriodUs microsecond replenishment period.  If the task exhausts its budget
+ * then eAction is applied.  uxDemotedPriority is only used if eAction is
+ * eCpuBudgetDemote.  pxBudget must remain valid for as long as the task exists.
+ * Must be called before the scheduler is started, or from the supervisor's
+ * priority, so the list of budgets is not modified while it is in use.
+ */
+void vCpuBudgetRegister( CpuBudget_t * pxBudget,
+                         TaskHandle_t xTask,
+                         uint32_t ulBudgetUs,
+                         uint32_t ulPeriodUs,
+                         CpuBudgetAction_t eAction,
+                         UBaseType_t uxDemotedPriority );
+
+/*
+ * Return the number of times the task associated with pxBudget has exhausted
+ * its budget.
+ */
+uint32_t ulCpuBudgetGetOverrunCount( const CpuBudget_t * pxBudget );
+
+/*
+ * Called from the traceTASK_SWITCHED_IN() and traceTASK_SWITCHED_OUT() trace
+ * macros.  Must not be called from anywhere else.
+ */
+void vCpuBudgetTaskSwitchedIn( void );
+void vCpuBudgetTaskSwitchedOut( void );
+
+#endif /* CPU_BUDGET_H */
@@ -0,0 +1,265 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/*
+ * Idle time based CPU load estimator.  See cpu_load.h for a description.
+ *
+ * All the state is written by exactly one task.  The calibrated iterations per
+ * tick and the decay factors are written once by the task that calls
+ * vCpuLoadCalibrate(), everything else is written only by the idle task.  The
+ * published averages are double buffered:  the idle task writes a new set of
+ * averages into the buffer that readers are not using, then increments
+ * ulGeneration to make the new buffer the current one.  A reader that finds
+ * ulGeneration changed while it was copying out a value simply reads again.
+ * The idle task only publishes once per sample window so the retry always
+ * terminates, and readers never need to enter a critical section.
+ */
+
+/* Standard includes. */
+#include <math.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "cpu_load.h"
+
+/* The averages are held as 16.16 fixed point fractions of full load. */
+#define cpuloadFIXED_SHIFT    16
+#define cpuloadFIXED_1        ( 1UL << cpuloadFIXED_SHIFT )
+
+/* The sample window in ticks. */
+#define cpuloadSAMPLE_TICKS   pdMS_TO_TICKS( cpuloadSAMPLE_PERIOD_MS )
+
+/* One published set of averages, and the tick count at which it was
+ * calculated. */
+typedef struct CpuLoadSnapshot
+{
+    uint32_t ulLoad[ eCpuLoadNumPeriods ];
+    TickType_t xTimeStamp;
+} CpuLoadSnapshot_t;
+
+/*
+ * Apply the same load sample ulWindows times to an exponentially weighted
+ * moving average that has the decay factor ulDecay per window.
+ */
+static uint32_t prvDecay( uint32_t ulAverage,
+                          uint32_t ulSample,
+                          uint32_t ulDecay,
+                          uint32_t ulWindows );
+
+/*-----------------------------------------------------------*/
+
+/* The averaging periods, in milliseconds, indexed by CpuLoadPeriod_t. */
+static const uint32_t ulAveragingPeriodsMs[ eCpuLoadNumPeriods ] = { 1000UL, 10000UL, 60000UL };
+
+/* The factor by which each average decays per sample window, in 16.16 fixed
+ * point.  Calculated once by vCpuLoadCalibrate(). */
+static uint32_t ulDecayFactors[ eCpuLoadNumPeriods ];
+
+/* The number of idle hook iterations per tick on an otherwise idle system.  Zero
+ * until calibration has completed. */
+static volatile uint32_t ulIdleIterationsPerTick = 0UL;
+
+/* Free running count of idle hook iterations. */
+static volatile uint32_t ulIdleIterations = 0UL;
+
+/* The published averages, and the count used to select between them. */
+static volatile CpuLoadSnapshot_t xSnapshots[ 2 ];
+static volatile uint32_t ulGeneration = 0UL;
+
+/*-----------------------------------------------------------*/
+
+void vCpuLoadCalibrate( TickType_t xCalibrationTicks )
+{
+    uint32_t ulStartIterations, ulMeasuredIterations;
+    BaseType_t x;
+
+    configASSERT( xCalibrationTicks > 0 );
+
+    /* Start counting on a tick boundary. */
+    vTaskDelay( 1 );
+    ulStartIterations = ulIdleIterations;
+
+    /* Nothing other than the idle task should be able to run while this task
+     * is blocked, so every available cycle is spent in the idle hook. */
+    vTaskDelay( xCalibrationTicks );
+    ulMeasuredIterations = ( ulIdleIterations - ulStartIterations ) / ( uint32_t ) xCalibrationTicks;
+
+    for( x = 0; x < eCpuLoadNumPeriods; x++ )
+    {
+        ulDecayFactors[ x ] = ( uint32_t ) ( exp( -( double ) cpuloadSAMPLE_PERIOD_MS / ( double ) ulAveragingPeriodsMs[ x ] ) * ( double ) cpuloadFIXED_1 );
+    }
+
+    /* Guard against a division by zero in the idle hook. */
+    if( ulMeasuredIterations == 0UL )
+    {
+        ulMeasuredIterations = 1UL;
+    }
+
+    /* Writing the calibrated value enables the idle hook, so it must be done
+     * last. */
+    ulIdleIterationsPerTick = ulMeasuredIterations;
+}
+/*-----------------------------------------------------------*/
+
+void vCpuLoadIdleHook( void )
+{
+    static TickType_t xWindowStartTime;
+    static uint32_t ulWindowStartIterations;
+    static BaseType_t xStarted = pdFALSE;
+    TickType_t xTimeNow, xElapsed;
+    uint64_t ullExpected, ullActual;
+    uint32_t ulSample, ulWindows, ulCurrent;
+    volatile CpuLoadSnapshot_t * pxNext;
+    BaseType_t x;
+
+    /* Every iteration does the same work whether or not calibration has
+     * completed, so an iteration costs the same while it is being calibrated as
+     * it does while it is being measured.  Otherwise an idle system would appear
+     * to be partly loaded. */
+    ulIdleIterations++;
+    xTimeNow = xTaskGetTickCount();
+
+    if( xStarted == pdFALSE )
+    {
+        xWindowStartTime = xTimeNow;
+        ulWindowStartIterations = ulIdleIterations;
+        xSnapshots[ 0 ].xTimeStamp = xTimeNow;
+        xStarted = pdTRUE;
+        return;
+    }
+
+    xElapsed = xTimeNow - xWindowStartTime;
+
+    if( xElapsed >= cpuloadSAMPLE_TICKS )
+    {
+        if( ulIdleIterationsPerTick == 0UL )
+        {
+            /* Still calibrating, so there is nothing to compare against.  Keep
+             * the time stamp current so ulCpuLoadGet() does not mistake the
+             * calibration period for windows in which the idle task was
+             * starved. */
+            xSnapshots[ 0 ].xTimeStamp = xTimeNow;
+            xWindowStartTime = xTimeNow;
+            ulWindowStartIterations = ulIdleIterations;
+            return;
+        }
+
+        /* Compare the idle iterations that actually executed against the number
+         * that would have executed had nothing else been running.  The calibration
+         * is not exact, so clip to 100% idle. */
+        ullExpected = ( uint64_t ) xElapsed * ( uint64_t ) ulIdleIterationsPerTick;
+        ullActual = ( uint64_t ) ( ulIdleIterations - ulWindowStartIterations );
+
+        if( ullActual > ullExpected )
+        {
+            ullActual = ullExpected;
+        }
+
+        ulSample = cpuloadFIXED_1 - ( uint32_t ) ( ( ullActual << cpuloadFIXED_SHIFT ) / ullExpected );
+
+        /* If the idle task was starved for longer than a window then more than
+         * one window has elapsed, and each is treated as having the same load. */
+        ulWindows = ( uint32_t ) ( xElapsed / cpuloadSAMPLE_TICKS );
+
+        /* Build the new averages in the buffer readers are not using... */
+        ulCurrent = ulGeneration;
+        pxNext = &( xSnapshots[ ( ulCurrent + 1UL ) & 1UL ] );
+
+        for( x = 0; x < eCpuLoadNumPeriods; x++ )
+        {
+            pxNext->ulLoad[ x ] = prvDecay( xSnapshots[ ulCurrent & 1UL ].ulLoad[ x ], ulSample, ulDecayFactors[ x ], ulWindows );
+        }
+
+        pxNext->xTimeStamp = xTimeNow;
+
+        /* ...then publish them. */
+        ulGeneration = ulCurrent + 1UL;
+
+        xWindowStartTime = xTimeNow;
+        ulWindowStartIterations = ulIdleIterations;
+    }
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulCpuLoadGet( CpuLoadPeriod_t ePeriod )
+{
+    uint32_t ulGenerationAtStart, ulLoad;
+    TickType_t xTimeStamp, xWindowsMissed;
+
+    configASSERT( ePeriod < eCpuLoadNumPeriods );
+
+    if( ulIdleIterationsPerTick == 0UL )
+    {
+        return 0UL;
+    }
+
+    /* Copy out a consistent average and time stamp. */
+    do
+    {
+        ulGenerationAtStart = ulGeneration;
+        ulLoad = xSnapshots[ ulGenerationAtStart & 1UL ].ulLoad[ ePeriod ];
+        xTimeStamp = xSnapshots[ ulGenerationAtStart & 1UL ].xTimeStamp;
+    } while( ulGenerationAtStart != ulGeneration );
+
+    /* The averages are only updated when the idle task runs.  If more than one
+     * whole window has passed since the last update then the idle task has not
+     * run at all for the windows in between, so those windows were fully loaded.
+     * Account for them here, without writing to the shared state. */
+    xWindowsMissed = ( xTaskGetTickCount() - xTimeStamp ) / cpuloadSAMPLE_TICKS;
+
+    if( xWindowsMissed > 1 )
+    {
+        ulLoad = prvDecay( ulLoad, cpuloadFIXED_1, ulDecayFactors[ ePeriod ], ( uint32_t ) ( xWindowsMissed - 1 ) );
+    }
+
+    /* Convert from 16.16 fixed point to tenths of a percent, rounding. */
+    return ( ulLoad * cpuloadFULL_LOAD + ( cpuloadFIXED_1 / 2UL ) ) >> cpuloadFIXED_SHIFT;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulCpuLoadGetIdleIterationsPerTick( void )
+{
+    return ulIdleIterationsPerTick;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvDecay( uint32_t ulAverage,
+                          uint32_t ulSample,
+                          uint32_t ulDecay,
+                          uint32_t ulWindows )
+{
+    uint32_t ulFactor = cpuloadFIXED_1;
+
+    /* Feeding the same sample into the average n times gives
+     * sample + ( average - sample ) * decay^n.  Stop early once decay^n has
+     * reached zero, which bounds the loop for long periods of starvation. */
+    while( ( ulWindows > 0UL ) && ( ulFactor != 0UL ) )
+    {
+        ulFactor = ( uint32_t ) ( ( ( uint64_t ) ulFactor * ulDecay ) >> cpuloadFIXED_SHIFT );
+        ulWindows--;
+    }
+
+    if( ulAverage >= ulSample )
+    {
+        return ulSample + ( uint32_t ) ( ( ( uint64_t ) ( ulAverage - ulSample ) * ulFactor ) >> cpuloadFIXED_SHIFT );
+    }
+    else
+    {
+        return ulSample - ( uint32_t ) ( ( ( uint64_t ) ( ulSample - ulAverage ) * ulFactor ) >> cpuloadFIXED_SHIFT );
+    }
+}
+/*-----------------------------------------------------------*/
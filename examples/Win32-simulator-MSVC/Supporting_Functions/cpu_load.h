@@ -0,0 +1,80 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef CPU_LOAD_H
+#define CPU_LOAD_H
+
+/*
+ * A CPU load estimator that uses nothing but the idle task hook.
+ *
+ * The idle task only runs when no other task is able to run, so the number of
+ * times the idle hook executes within a period of time is a measure of how much
+ * of that period was left unused by the application.  At boot the number of
+ * idle hook iterations that execute in one tick on an otherwise idle system is
+ * measured (calibrated).  From then on the idle hook compares the number of
+ * iterations it actually managed to execute within each sample window against
+ * the calibrated figure, and feeds the result into three exponentially weighted
+ * moving averages with time constants of 1, 10 and 60 seconds - in the same way
+ * the Unix 'load average' is maintained.
+ *
+ * The averages are published by the idle task and can be read by any task
+ * without entering a critical section and without the overhead of enabling
+ * configGENERATE_RUN_TIME_STATS.
+ */
+
+/* The length of each sample window.  Can be overridden in FreeRTOSConfig.h. */
+#ifndef cpuloadSAMPLE_PERIOD_MS
+    #define cpuloadSAMPLE_PERIOD_MS    100UL
+#endif
+
+/* Load values are returned in tenths of a percent, so 1000 means 100%. */
+#define cpuloadFULL_LOAD               1000UL
+
+/* The averaging periods that can be passed to ulCpuLoadGet(). */
+typedef enum
+{
+    eCpuLoad1Second = 0,
+    eCpuLoad10Seconds,
+    eCpuLoad60Seconds,
+    eCpuLoadNumPeriods
+} CpuLoadPeriod_t;
+
+/*
+ * Measure the number of idle hook iterations that execute per tick.  Must be
+ * called from a task, before any of the application tasks that would otherwise
+ * compete with the idle task have been created.  The calling task is held in
+ * the Blocked state for xCalibrationTicks ticks.
+ */
+void vCpuLoadCalibrate( TickType_t xCalibrationTicks );
+
+/*
+ * Must be called from vApplicationIdleHook().  Counts the idle iterations and
+ * updates the load averages each time a sample window completes.
+ */
+void vCpuLoadIdleHook( void );
+
+/*
+ * Return the CPU load averaged over the requested period, in tenths of a
+ * percent.  Can be called from any task without entering a critical section.
+ * Returns 0 until vCpuLoadCalibrate() has completed.
+ */
+uint32_t ulCpuLoadGet( CpuLoadPeriod_t ePeriod );
+
+/*
+ * Return the number of idle hook iterations per tick measured by
+ * vCpuLoadCalibrate().
+ */
+uint32_t ulCpuLoadGetIdleIterationsPerTick( void );
+
+#endif /* CPU_LOAD_H */
@@ -0,0 +1,332 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/*
+ * Dedicated deferred interrupt processing service.  See deferred_work.h for a
+ * description.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "benchmark_timer.h"
+#include "deferred_work.h"
+
+/* One pended function call. */
+typedef struct DeferredWorkItem
+{
+    DeferredWorkFunction_t pxFunction;
+    void * pvParameter1;
+    uint32_t ulParameter2;
+    uint64_t ullPendedNs;
+
+    /* The number of the pend that wrote the entry plus one, written after the
+     * rest of the entry.  The entry for pend number n is ready to execute when
+     * this is n + 1. */
+    volatile UBaseType_t uxSequence;
+} DeferredWorkItem_t;
+
+typedef struct DeferredWork
+{
+    DeferredWorkItem_t * pxItems;
+    UBaseType_t uxIndexMask; /* The length of the ring minus one. */
+    UBaseType_t uxBatchSize;
+    TaskHandle_t xTask;
+
+    /* The head and tail count the entries ever removed and claimed
+     * respectively, as per spsc_ring.c.  Only the task writes uxHead.  uxTail
+     * is written by whichever task or interrupt is claiming a slot, with
+     * interrupts masked.  An entry can be claimed but not yet written, so the
+     * task checks each entry's sequence number rather than uxTail. */
+    volatile UBaseType_t uxHead;
+    volatile UBaseType_t uxTail;
+
+    /* Producers update the pending statistics when they claim a slot, and the
+     * task updates the execution statistics in a critical section once per
+     * batch. */
+    DeferredWorkStats_t xStats;
+} DeferredWork_t;
+
+/* The task that executes the pended functions. */
+static void prvDeferredWorkTask( void * pvParameters );
+
+/* Claim the next slot in the ring, writing its pend number to *puxIndex.  Must
+ * be called with interrupts masked.  Returns pdFAIL if the ring is full. */
+static BaseType_t prvClaimSlot( DeferredWork_t * pxWork,
+                                UBaseType_t * puxIndex );
+
+/* Write an entry into the slot claimed by prvClaimSlot() and publish it to the
+ * task.  Returns pdTRUE if the task needs to be notified. */
+static BaseType_t prvPublish( DeferredWork_t * pxWork,
+                              UBaseType_t uxIndex,
+                              DeferredWorkFunction_t pxFunction,
+                              void * pvParameter1,
+                              uint32_t ulParameter2,
+                              uint64_t ullPendedNs );
+
+/*-----------------------------------------------------------*/
+
+DeferredWorkHandle_t xDeferredWorkCreate( const char * pcName,
+                                          UBaseType_t uxLength,
+                                          UBaseType_t uxPriority,
+                                          UBaseType_t uxBatchSize )
+{
+    DeferredWork_t * pxWork;
+    UBaseType_t ux;
+
+    configASSERT( uxLength > 0 );
+    configASSERT( ( uxLength & ( uxLength - 1 ) ) == 0 );
+    configASSERT( uxBatchSize > 0 );
+
+    /* The structure and the ring are allocated together. */
+    pxWork = ( DeferredWork_t * ) pvPortMalloc( sizeof( DeferredWork_t ) + ( ( size_t ) uxLength * sizeof( DeferredWorkItem_t ) ) );
+
+    if( pxWork != NULL )
+    {
+        pxWork->pxItems = ( DeferredWorkItem_t * ) ( pxWork + 1 );
+        pxWork->uxIndexMask = uxLength - 1;
+        pxWork->uxBatchSize = uxBatchSize;
+        pxWork->uxHead = 0;
+        pxWork->uxTail = 0;
+        pxWork->xStats.ulPended = 0;
+        pxWork->xStats.ulExecuted = 0;
+        pxWork->xStats.ulOverflows = 0;
+        pxWork->xStats.ulBatches = 0;
+        pxWork->xStats.uxMaxBatch = 0;
+        pxWork->xStats.uxMaxFill = 0;
+        pxWork->xStats.ullTotalLatencyNs = 0;
+        pxWork->xStats.ullMaxLatencyNs = 0;
+
+        /* No slot has been published yet, so no slot may hold the sequence
+         * number its first entry will be published with. */
+        for( ux = 0; ux < uxLength; ux++ )
+        {
+            pxWork->pxItems[ ux ].uxSequence = 0;
+        }
+
+        if( xTaskCreate( prvDeferredWorkTask, pcName, deferredworkTASK_STACK_SIZE, pxWork, uxPriority, &( pxWork->xTask ) ) != pdPASS )
+        {
+            vPortFree( pxWork );
+            pxWork = NULL;
+        }
+    }
+
+    return pxWork;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xDeferredWorkPend( DeferredWorkHandle_t xWork,
+                              DeferredWorkFunction_t pxFunction,
+                              void * pvParameter1,
+                              uint32_t ulParameter2 )
+{
+    const uint64_t ullPendedNs = ullBenchmarkTimerGetNanoseconds();
+    UBaseType_t uxIndex;
+    BaseType_t xPended;
+
+    taskENTER_CRITICAL();
+    {
+        xPended = prvClaimSlot( xWork, &uxIndex );
+    }
+    taskEXIT_CRITICAL();
+
+    if( xPended != pdFAIL )
+    {
+        if( prvPublish( xWork, uxIndex, pxFunction, pvParameter1, ulParameter2, ullPendedNs ) != pdFALSE )
+        {
+            ( void ) xTaskNotifyGive( xWork->xTask );
+        }
+    }
+
+    return xPended;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xDeferredWorkPendFromISR( DeferredWorkHandle_t xWork,
+                                     DeferredWorkFunction_t pxFunction,
+                                     void * pvParameter1,
+                                     uint32_t ulParameter2,
+                                     BaseType_t * pxHigherPriorityTaskWoken )
+{
+    const uint64_t ullPendedNs = ullBenchmarkTimerGetNanoseconds();
+    UBaseType_t uxSavedInterruptStatus, uxIndex;
+    BaseType_t xPended;
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        xPended = prvClaimSlot( xWork, &uxIndex );
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    if( xPended != pdFAIL )
+    {
+        if( prvPublish( xWork, uxIndex, pxFunction, pvParameter1, ulParameter2, ullPendedNs ) != pdFALSE )
+        {
+            vTaskNotifyGiveFromISR( xWork->xTask, pxHigherPriorityTaskWoken );
+        }
+    }
+
+    return xPended;
+}
+/*-----------------------------------------------------------*/
+
+void vDeferredWorkGetStats( DeferredWorkHandle_t xWork,
+                            DeferredWorkStats_t * pxStats )
+{
+    taskENTER_CRITICAL();
+    {
+        *pxStats = xWork->xStats;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvClaimSlot( DeferredWork_t * pxWork,
+                                UBaseType_t * puxIndex )
+{
+    UBaseType_t uxTail = pxWork->uxTail, uxFill;
+    BaseType_t xReturn = pdFAIL;
+
+    uxFill = uxTail - pxWork->uxHead;
+
+    if( uxFill <= pxWork->uxIndexMask )
+    {
+        *puxIndex = uxTail;
+        pxWork->uxTail = uxTail + 1;
+        pxWork->xStats.ulPended++;
+
+        if( ( uxFill + 1 ) > pxWork->xStats.uxMaxFill )
+        {
+            pxWork->xStats.uxMaxFill = uxFill + 1;
+        }
+
+        xReturn = pdPASS;
+    }
+    else
+    {
+        pxWork->xStats.ulOverflows++;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvPublish( DeferredWork_t * pxWork,
+                              UBaseType_t uxIndex,
+                              DeferredWorkFunction_t pxFunction,
+                              void * pvParameter1,
+                              uint32_t ulParameter2,
+                              uint64_t ullPendedNs )
+{
+    DeferredWorkItem_t * pxItem = &( pxWork->pxItems[ uxIndex & pxWork->uxIndexMask ] );
+
+    pxItem->pxFunction = pxFunction;
+    pxItem->pvParameter1 = pvParameter1;
+    pxItem->ulParameter2 = ulParameter2;
+    pxItem->ullPendedNs = ullPendedNs;
+
+    /* Finish writing the entry before the task can see it is there, and
+     * publish it before checking whether the task is waiting for it. */
+    portMEMORY_BARRIER();
+    pxItem->uxSequence = uxIndex + 1;
+    portMEMORY_BARRIER();
+
+    /* The task stops at the first entry that has not been published, so it can
+     * only be waiting for this entry if this entry is at its head.  If it has
+     * not blocked yet the notification just causes it to check the ring once
+     * more. */
+    return ( pxWork->uxHead == uxIndex ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvDeferredWorkTask( void * pvParameters )
+{
+    DeferredWork_t * pxWork = ( DeferredWork_t * ) pvParameters;
+    DeferredWorkItem_t xItem, * pxItem;
+    UBaseType_t uxHead, uxExecuted;
+    uint64_t ullLatency, ullTotalLatency, ullMaxLatency;
+
+    for( ; ; )
+    {
+        uxHead = pxWork->uxHead;
+
+        if( pxWork->pxItems[ uxHead & pxWork->uxIndexMask ].uxSequence != ( uxHead + 1 ) )
+        {
+            /* Nothing to do until the entry at the head of the ring is
+             * published. */
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+            continue;
+        }
+
+        uxExecuted = 0;
+        ullTotalLatency = 0;
+        ullMaxLatency = 0;
+
+        while( uxExecuted < pxWork->uxBatchSize )
+        {
+            pxItem = &( pxWork->pxItems[ uxHead & pxWork->uxIndexMask ] );
+
+            /* Entries are executed in the order they were claimed, so stop at
+             * the first one that has not been published yet. */
+            if( pxItem->uxSequence != ( uxHead + 1 ) )
+            {
+                break;
+            }
+
+            /* Read the sequence number before the entry, and finish reading
+             * the entry before the slot is freed for reuse. */
+            portMEMORY_BARRIER();
+            xItem = *pxItem;
+            portMEMORY_BARRIER();
+            uxHead++;
+            pxWork->uxHead = uxHead;
+
+            ullLatency = ullBenchmarkTimerGetNanoseconds() - xItem.ullPendedNs;
+            ullTotalLatency += ullLatency;
+
+            if( ullLatency > ullMaxLatency )
+            {
+                ullMaxLatency = ullLatency;
+            }
+
+            xItem.pxFunction( xItem.pvParameter1, xItem.ulParameter2 );
+            uxExecuted++;
+        }
+
+        taskENTER_CRITICAL();
+        {
+            pxWork->xStats.ulExecuted += ( uint32_t ) uxExecuted;
+            pxWork->xStats.ulBatches++;
+            pxWork->xStats.ullTotalLatencyNs += ullTotalLatency;
+
+            if( uxExecuted > pxWork->xStats.uxMaxBatch )
+            {
+                pxWork->xStats.uxMaxBatch = uxExecuted;
+            }
+
+            if( ullMaxLatency > pxWork->xStats.ullMaxLatencyNs )
+            {
+                pxWork->xStats.ullMaxLatencyNs = ullMaxLatency;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /* Let other tasks of the same priority run between batches.  The ring
+         * is checked again when this task next runs. */
+        taskYIELD();
+    }
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,128 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef DEFERRED_WORK_H
+#define DEFERRED_WORK_H
+
+/*
+ * A dedicated service for deferring interrupt processing to a task.
+ *
+ * xTimerPendFunctionCallFromISR(), as used in Example018, sends the function
+ * to execute through the timer command queue, so pended calls share the queue
+ * and the timer service task with every software timer.  During a burst of
+ * interrupts the pended calls and the timer commands compete for space in the
+ * queue, and whichever is sent last is lost when it is full.  Each pended call
+ * is also a full queue send, with its own critical section and check for tasks
+ * to unblock.
+ *
+ * A deferred work service has its own ring of { function, parameter 1,
+ * parameter 2 } entries and its own task, created at whatever priority the
+ * application chooses, which executes the functions in the order they were
+ * pended.  The functions have the same prototype as those passed to
+ * xTimerPendFunctionCallFromISR(), so existing deferred handlers can be moved
+ * to a deferred work service unchanged.
+ *
+ * Pending a function only masks interrupts for long enough to claim the next
+ * slot in the ring and count it in the statistics, which is necessary because
+ * interrupts of different priorities can pend to the same service.  The time
+ * stamp is taken before interrupts are masked, and the entry is written into
+ * its slot and published with a per slot sequence number after they are
+ * unmasked.  The task never enters a critical section to remove entries, and
+ * executes them in the order their slots were claimed, stopping at the first
+ * slot that has been claimed but not yet published.  The task is only notified
+ * by the producer that publishes the entry it is waiting for, so during a
+ * burst it is notified once, then executes up to uxBatchSize functions before
+ * yielding to other tasks of the same priority, and continues until it reaches
+ * a slot that has not been published.
+ *
+ * The service counts the entries that could not be pended because the ring was
+ * full, and records the time from each function being pended to it starting
+ * to execute.  Times are measured with the benchmark timer, so
+ * vBenchmarkTimerInit() must be called before a service is created.
+ *
+ * The ring relies on the interrupts and the task executing on the same core,
+ * as they always do in a single core FreeRTOS application.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The stack size of each service's task.  Can be overridden in
+ * FreeRTOSConfig.h. */
+#ifndef deferredworkTASK_STACK_SIZE
+    #define deferredworkTASK_STACK_SIZE    1000
+#endif
+
+/* The prototype of a deferred function, which is the same as that of the
+ * functions passed to xTimerPendFunctionCallFromISR(). */
+typedef void (* DeferredWorkFunction_t)( void * pvParameter1,
+                                         uint32_t ulParameter2 );
+
+/* Statistics gathered by each service. */
+typedef struct DeferredWorkStats
+{
+    uint32_t ulPended;          /* Functions successfully pended. */
+    uint32_t ulExecuted;        /* Functions that have been executed. */
+    uint32_t ulOverflows;       /* Functions not pended because the ring was full. */
+    uint32_t ulBatches;         /* Batches of functions executed by the task. */
+    UBaseType_t uxMaxBatch;     /* Most functions executed in one batch. */
+    UBaseType_t uxMaxFill;      /* Most entries ever in the ring at once. */
+    uint64_t ullTotalLatencyNs; /* Total time from pending to execution. */
+    uint64_t ullMaxLatencyNs;   /* Longest time from pending to execution. */
+} DeferredWorkStats_t;
+
+typedef struct DeferredWork * DeferredWorkHandle_t;
+
+/*
+ * Create a service with a ring of uxLength entries, and a task of priority
+ * uxPriority that executes at most uxBatchSize functions before yielding.
+ * uxLength must be a power of two.  Returns NULL if there was insufficient heap
+ * memory.
+ */
+DeferredWorkHandle_t xDeferredWorkCreate( const char * pcName,
+                                          UBaseType_t uxLength,
+                                          UBaseType_t uxPriority,
+                                          UBaseType_t uxBatchSize );
+
+/*
+ * Pend pxFunction to the service, to be called with pvParameter1 and
+ * ulParameter2 by the service's task.  Never blocks.  Returns pdPASS if the
+ * function was pended, or pdFAIL if the ring was full.  Can only be called from
+ * a task.
+ */
+BaseType_t xDeferredWorkPend( DeferredWorkHandle_t xWork,
+                              DeferredWorkFunction_t pxFunction,
+                              void * pvParameter1,
+                              uint32_t ulParameter2 );
+
+/*
+ * A version of xDeferredWorkPend() that can be called from an interrupt
+ * service routine.  *pxHigherPriorityTaskWoken is set to pdTRUE if unblocking
+ * the service's task means a context switch should be requested before the
+ * interrupt exits, as per xTimerPendFunctionCallFromISR().
+ */
+BaseType_t xDeferredWorkPendFromISR( DeferredWorkHandle_t xWork,
+                                     DeferredWorkFunction_t pxFunction,
+                                     void * pvParameter1,
+                                     uint32_t ulParameter2,
+                                     BaseType_t * pxHigherPriorityTaskWoken );
+
+/*
+ * Copy out the statistics gathered by a service so far.
+ */
+void vDeferredWorkGetStats( DeferredWorkHandle_t xWork,
+                            DeferredWorkStats_t * pxStats );
+
+#endif /* DEFERRED_WORK_H */
@@ -0,0 +1,493 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/*
+ * Simulated interrupt sources.  See interrupt_source.h for a description.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <windows.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "benchmark_timer.h"
+#include "interrupt_source.h"
+
+/* A source that is waiting for its next interrupt sleeps, rather than busy
+ * waits, if the interrupt is more than this far in the future.  Sleep() can
+ * overshoot by a Windows timer period, which is up to 16ms, so the thread wakes
+ * that long before the interrupt is due and busy waits for the remainder. */
+#define interruptsourceSLEEP_THRESHOLD_NS    20000000ULL
+#define interruptsourceSLEEP_MARGIN_MS       16UL
+
+/* The longest the thread sleeps before checking whether the source has been
+ * stopped or restarted, so a restart is seen promptly even when interrupts are
+ * seconds apart. */
+#define interruptsourceMAX_SLEEP_MS          100UL
+
+typedef struct InterruptSource
+{
+    InterruptSourceParameters_t xParameters;
+    uint32_t * pulReplayTimesUs;
+    uint32_t ulNumReplayTimes;
+
+    /* Written by tasks, read by the source's thread.  lGeneration is
+     * incremented each time the source is started, so the thread restarts the
+     * sequence even if the source was stopped and started again while the
+     * thread was sleeping or busy waiting. */
+    volatile LONG lEnabled;
+    volatile LONG lGeneration;
+    volatile uint32_t ulIntervalUs;
+
+    /* Only accessed by the source's thread. */
+    uint64_t ullDueNs;
+    uint64_t ullSequenceStartNs; /* The start of the current burst or replay sequence. */
+    uint32_t ulIndex;            /* The position within the current burst or replay sequence. */
+    uint32_t ulRandom;
+
+    /* Set by the thread when it raises an interrupt that is not already
+     * pending, and cleared by the handler.  ullPendingSinceNs is only written
+     * while lPending is clear, and only read while it is set. */
+    volatile LONG lPending;
+    volatile uint64_t ullPendingSinceNs;
+
+    /* Statistics written by the thread. */
+    volatile LONG lRaised;
+    volatile LONG lCoalesced;
+    volatile LONG lMaxLagUs;
+
+    /* Statistics written by the handler.  Simulated interrupts do not nest, and
+     * are not processed while a task is in a critical section. */
+    uint32_t ulHandled;
+    uint32_t ulMeasured;
+    uint64_t ullTotalLatencyNs;
+    uint32_t ulMaxLatencyNs;
+} InterruptSource_t;
+
+/* The Windows thread that raises each source's interrupts. */
+static DWORD WINAPI prvInterruptSourceThread( LPVOID pvParameter );
+
+/* Set ullDueNs to the time of the first interrupt of the sequence. */
+static void prvStartSequence( InterruptSource_t * pxSource,
+                              uint64_t ullTimeNowNs );
+
+/* Move ullDueNs on to the time of the next interrupt.  Returns pdFALSE if the
+ * sequence has ended. */
+static BaseType_t prvAdvance( InterruptSource_t * pxSource );
+
+/* Read the times of a replay sequence from pcFileName. */
+static BaseType_t prvReadReplayFile( InterruptSource_t * pxSource,
+                                     const char * pcFileName );
+
+/* Return the next value from a xorshift pseudo random number generator. */
+static uint32_t prvRandom( uint32_t * pulState );
+
+/*-----------------------------------------------------------*/
+
+InterruptSourceHandle_t xInterruptSourceCreate( const InterruptSourceParameters_t * pxParameters )
+{
+    InterruptSource_t * pxSource;
+    HANDLE xThread;
+
+    configASSERT( pxParameters != NULL );
+    configASSERT( pxParameters->ulInterruptNumber >= 3 );
+    configASSERT( ( pxParameters->eModel != eInterruptSourcePoisson ) || ( pxParameters->ulSeed != 0UL ) );
+    configASSERT( ( pxParameters->eModel != eInterruptSourceBursty ) || ( pxParameters->ulBurstLength > 0UL ) );
+    configASSERT( ( pxParameters->eModel == eInterruptSourceReplay ) || ( pxParameters->ulIntervalUs > 0UL ) );
+
+    pxSource = ( InterruptSource_t * ) pvPortMalloc( sizeof( InterruptSource_t ) );
+
+    if( pxSource != NULL )
+    {
+        memset( pxSource, 0x00, sizeof( InterruptSource_t ) );
+        pxSource->xParameters = *pxParameters;
+        pxSource->ulIntervalUs = pxParameters->ulIntervalUs;
+
+        if( ( pxParameters->eModel == eInterruptSourceReplay ) &&
+            ( prvReadReplayFile( pxSource, pxParameters->pcReplayFile ) == pdFAIL ) )
+        {
+            vPortFree( pxSource );
+            return NULL;
+        }
+
+        xThread = CreateThread( NULL, 0, prvInterruptSourceThread, pxSource, 0, NULL );
+
+        if( xThread == NULL )
+        {
+            vPortFree( pxSource->pulReplayTimesUs );
+            vPortFree( pxSource );
+            return NULL;
+        }
+
+        /* Raise interrupts promptly, and keep the thread off the core the
+         * FreeRTOS threads run on, if there is more than one core, so a busy
+         * waiting source does not slow the application down. */
+        SetThreadPriority( xThread, THREAD_PRIORITY_ABOVE_NORMAL );
+        SetThreadAffinityMask( xThread, ~( ( uintptr_t ) 0x01 ) );
+        CloseHandle( xThread );
+    }
+
+    return pxSource;
+}
+/*-----------------------------------------------------------*/
+
+void vInterruptSourceStart( InterruptSourceHandle_t xSource )
+{
+    configASSERT( xSource != NULL );
+
+    /* The new generation is visible before the source is enabled, so the
+     * thread never continues the old sequence once it sees the source is
+     * enabled. */
+    InterlockedIncrement( &( xSource->lGeneration ) );
+    xSource->lEnabled = 1;
+}
+/*-----------------------------------------------------------*/
+
+void vInterruptSourceStop( InterruptSourceHandle_t xSource )
+{
+    configASSERT( xSource != NULL );
+    xSource->lEnabled = 0;
+}
+/*-----------------------------------------------------------*/
+
+void vInterruptSourceSetInterval( InterruptSourceHandle_t xSource,
+                                  uint32_t ulIntervalUs )
+{
+    configASSERT( xSource != NULL );
+    configASSERT( ( ulIntervalUs > 0UL ) || ( xSource->xParameters.eModel == eInterruptSourceReplay ) );
+    xSource->ulIntervalUs = ulIntervalUs;
+}
+/*-----------------------------------------------------------*/
+
+void vInterruptSourceISREntry( InterruptSourceHandle_t xSource )
+{
+    uint64_t ullTimeNowNs = ullBenchmarkTimerGetNanoseconds();
+    uint32_t ulLatency;
+
+    xSource->ulHandled++;
+
+    /* The pending flag is already clear if this execution is for an interrupt
+     * that was counted as coalesced, but was raised too late to be merged into
+     * the previous execution of this handler.  Its latency is included in the
+     * latency measured by the previous execution. */
+    if( xSource->lPending != 0 )
+    {
+        ulLatency = ( uint32_t ) ( ullTimeNowNs - xSource->ullPendingSinceNs );
+        xSource->ulMeasured++;
+        xSource->ullTotalLatencyNs += ulLatency;
+
+        if( ulLatency > xSource->ulMaxLatencyNs )
+        {
+            xSource->ulMaxLatencyNs = ulLatency;
+        }
+
+        MemoryBarrier();
+        xSource->lPending = 0;
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vInterruptSourceGetStats( InterruptSourceHandle_t xSource,
+                               InterruptSourceStats_t * pxStats,
+                               BaseType_t xClear )
+{
+    configASSERT( xSource != NULL );
+
+    /* Simulated interrupts are not processed during the critical section, so
+     * the statistics written by the handler are consistent. */
+    taskENTER_CRITICAL();
+    {
+        pxStats->ulHandled = xSource->ulHandled;
+        pxStats->ulMeasured = xSource->ulMeasured;
+        pxStats->ullTotalLatencyNs = xSource->ullTotalLatencyNs;
+        pxStats->ulMaxLatencyNs = xSource->ulMaxLatencyNs;
+
+        if( xClear != pdFALSE )
+        {
+            xSource->ulHandled = 0;
+            xSource->ulMeasured = 0;
+            xSource->ullTotalLatencyNs = 0;
+            xSource->ulMaxLatencyNs = 0;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if( xClear != pdFALSE )
+    {
+        pxStats->ulRaised = ( uint32_t ) InterlockedExchange( &( xSource->lRaised ), 0 );
+        pxStats->ulCoalesced = ( uint32_t ) InterlockedExchange( &( xSource->lCoalesced ), 0 );
+        pxStats->ulMaxLagUs = ( uint32_t ) InterlockedExchange( &( xSource->lMaxLagUs ), 0 );
+    }
+    else
+    {
+        pxStats->ulRaised = ( uint32_t ) xSource->lRaised;
+        pxStats->ulCoalesced = ( uint32_t ) xSource->lCoalesced;
+        pxStats->ulMaxLagUs = ( uint32_t ) xSource->lMaxLagUs;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static DWORD WINAPI prvInterruptSourceThread( LPVOID pvParameter )
+{
+    InterruptSource_t * pxSource = ( InterruptSource_t * ) pvParameter;
+    BaseType_t xRunning = pdFALSE;
+    uint64_t ullTimeNowNs;
+    LONG lLagUs, lGeneration = 0;
+    DWORD dwSleepMs;
+
+    /* This is a Windows thread, not a FreeRTOS task, so it must not call any
+     * FreeRTOS API function other than
+     * vPortGenerateSimulatedInterruptFromWindowsThread(). */
+    for( ; ; )
+    {
+        if( pxSource->lEnabled == 0 )
+        {
+            Sleep( 1 );
+            continue;
+        }
+
+        ullTimeNowNs = ullBenchmarkTimerGetNanoseconds();
+
+        /* The source has been started since the current sequence started, so
+         * start the sequence again from the beginning. */
+        if( pxSource->lGeneration != lGeneration )
+        {
+            lGeneration = pxSource->lGeneration;
+            xRunning = pdTRUE;
+            prvStartSequence( pxSource, ullTimeNowNs );
+        }
+
+        if( xRunning == pdFALSE )
+        {
+            /* A replay sequence that does not repeat has finished, so nothing
+             * more is raised until the source is started again. */
+            Sleep( 1 );
+            continue;
+        }
+
+        /* Wait until the next interrupt is due, or the source is stopped or
+         * restarted. */
+        while( ( ullTimeNowNs < pxSource->ullDueNs ) &&
+               ( pxSource->lEnabled != 0 ) &&
+               ( pxSource->lGeneration == lGeneration ) )
+        {
+            if( ( pxSource->ullDueNs - ullTimeNowNs ) > interruptsourceSLEEP_THRESHOLD_NS )
+            {
+                dwSleepMs = ( DWORD ) ( ( pxSource->ullDueNs - ullTimeNowNs ) / 1000000ULL ) - interruptsourceSLEEP_MARGIN_MS;
+
+                if( dwSleepMs > interruptsourceMAX_SLEEP_MS )
+                {
+                    dwSleepMs = interruptsourceMAX_SLEEP_MS;
+                }
+
+                Sleep( dwSleepMs );
+            }
+
+            ullTimeNowNs = ullBenchmarkTimerGetNanoseconds();
+        }
+
+        if( ( pxSource->lEnabled == 0 ) || ( pxSource->lGeneration != lGeneration ) )
+        {
+            continue;
+        }
+
+        lLagUs = ( LONG ) ( ( ullTimeNowNs - pxSource->ullDueNs ) / 1000ULL );
+
+        if( lLagUs > pxSource->lMaxLagUs )
+        {
+            pxSource->lMaxLagUs = lLagUs;
+        }
+
+        /* Only the first of the interrupts raised before the handler executes
+         * is timed. */
+        if( pxSource->lPending == 0 )
+        {
+            pxSource->ullPendingSinceNs = ullTimeNowNs;
+            MemoryBarrier();
+            pxSource->lPending = 1;
+        }
+        else
+        {
+            InterlockedIncrement( &( pxSource->lCoalesced ) );
+        }
+
+        InterlockedIncrement( &( pxSource->lRaised ) );
+        vPortGenerateSimulatedInterruptFromWindowsThread( pxSource->xParameters.ulInterruptNumber );
+
+        if( prvAdvance( pxSource ) == pdFALSE )
+        {
+            /* A replay sequence that does not repeat has finished.  lEnabled is
+             * only written by tasks, so a start that happens at the same time
+             * is not lost. */
+            xRunning = pdFALSE;
+        }
+    }
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartSequence( InterruptSource_t * pxSource,
+                              uint64_t ullTimeNowNs )
+{
+    pxSource->ullSequenceStartNs = ullTimeNowNs;
+    pxSource->ulIndex = 0;
+    pxSource->ulRandom = pxSource->xParameters.ulSeed;
+
+    switch( pxSource->xParameters.eModel )
+    {
+        case eInterruptSourceBursty:
+            /* The first burst starts straight away. */
+            pxSource->ullDueNs = ullTimeNowNs;
+            break;
+
+        case eInterruptSourceReplay:
+            pxSource->ullDueNs = ullTimeNowNs + ( ( uint64_t ) pxSource->pulReplayTimesUs[ 0 ] * 1000ULL );
+            break;
+
+        case eInterruptSourceFixed:
+        case eInterruptSourcePoisson:
+        default:
+            /* The first interval is the same as any other. */
+            pxSource->ullDueNs = ullTimeNowNs;
+            ( void ) prvAdvance( pxSource );
+            break;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvAdvance( InterruptSource_t * pxSource )
+{
+    const uint32_t ulIntervalUs = pxSource->ulIntervalUs;
+    double dUniform;
+
+    switch( pxSource->xParameters.eModel )
+    {
+        case eInterruptSourcePoisson:
+            /* Inverse transform sampling, using a uniform value in (0, 1], as
+             * per workload.c. */
+            dUniform = ( ( double ) prvRandom( &( pxSource->ulRandom ) ) + 1.0 ) / 4294967296.0;
+            pxSource->ullDueNs += ( uint64_t ) ( -( double ) ulIntervalUs * 1000.0 * log( dUniform ) );
+            break;
+
+        case eInterruptSourceBursty:
+            pxSource->ulIndex++;
+
+            if( pxSource->ulIndex < pxSource->xParameters.ulBurstLength )
+            {
+                pxSource->ullDueNs += ( uint64_t ) pxSource->xParameters.ulBurstSpacingUs * 1000ULL;
+            }
+            else
+            {
+                pxSource->ulIndex = 0;
+                pxSource->ullSequenceStartNs += ( uint64_t ) ulIntervalUs * 1000ULL;
+                pxSource->ullDueNs = pxSource->ullSequenceStartNs;
+            }
+
+            break;
+
+        case eInterruptSourceReplay:
+            pxSource->ulIndex++;
+
+            if( pxSource->ulIndex >= pxSource->ulNumReplayTimes )
+            {
+                if( ulIntervalUs == 0UL )
+                {
+                    return pdFALSE;
+                }
+
+                pxSource->ulIndex = 0;
+                pxSource->ullSequenceStartNs += ( ( uint64_t ) pxSource->pulReplayTimesUs[ pxSource->ulNumReplayTimes - 1 ] + ulIntervalUs ) * 1000ULL;
+            }
+
+            pxSource->ullDueNs = pxSource->ullSequenceStartNs + ( ( uint64_t ) pxSource->pulReplayTimesUs[ pxSource->ulIndex ] * 1000ULL );
+            break;
+
+        case eInterruptSourceFixed:
+        default:
+            pxSource->ullDueNs += ( uint64_t ) ulIntervalUs * 1000ULL;
+            break;
+    }
+
+    return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvReadReplayFile( InterruptSource_t * pxSource,
+                                     const char * pcFileName )
+{
+    FILE * pxFile;
+    unsigned long ulTimeUs;
+    uint32_t ulPrevious = 0;
+
+    configASSERT( pcFileName != NULL );
+
+    pxSource->pulReplayTimesUs = ( uint32_t * ) pvPortMalloc( interruptsourceMAX_REPLAY_TIMES * sizeof( uint32_t ) );
+
+    if( pxSource->pulReplayTimesUs == NULL )
+    {
+        return pdFAIL;
+    }
+
+    pxFile = fopen( pcFileName, "r" );
+
+    if( pxFile != NULL )
+    {
+        while( ( pxSource->ulNumReplayTimes < interruptsourceMAX_REPLAY_TIMES ) &&
+               ( fscanf( pxFile, "%lu", &ulTimeUs ) == 1 ) )
+        {
+            /* Times that go backwards are raised straight after the time
+             * before them. */
+            if( ( uint32_t ) ulTimeUs < ulPrevious )
+            {
+                ulTimeUs = ulPrevious;
+            }
+
+            pxSource->pulReplayTimesUs[ pxSource->ulNumReplayTimes ] = ( uint32_t ) ulTimeUs;
+            pxSource->ulNumReplayTimes++;
+            ulPrevious = ( uint32_t ) ulTimeUs;
+        }
+
+        fclose( pxFile );
+    }
+
+    if( pxSource->ulNumReplayTimes == 0 )
+    {
+        vPortFree( pxSource->pulReplayTimesUs );
+        pxSource->pulReplayTimesUs = NULL;
+        return pdFAIL;
+    }
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( uint32_t * pulState )
+{
+    uint32_t ulState = *pulState;
+
+    ulState ^= ulState << 13;
+    ulState ^= ulState >> 17;
+    ulState ^= ulState << 5;
+    *pulState = ulState;
+
+    return ulState;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,141 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef INTERRUPT_SOURCE_H
+#define INTERRUPT_SOURCE_H
+
+/*
+ * Simulated interrupt sources for stress testing interrupt handling in the
+ * Windows port.
+ *
+ * Example016 to Example019 generate one simulated interrupt every 500ms by
+ * calling vPortGenerateSimulatedInterrupt() from a task, so interrupts can
+ * only occur when that task runs, and never at the rates a real peripheral
+ * generates them.  Each interrupt source created by this module is a Windows
+ * thread, independent of the FreeRTOS scheduler, that raises a simulated
+ * interrupt with vPortGenerateSimulatedInterruptFromWindowsThread() at times
+ * chosen by one of these rate models:
+ *
+ *  + Fixed - one interrupt every ulIntervalUs microseconds.
+ *  + Poisson - intervals exponentially distributed with a mean of ulIntervalUs,
+ *    as generated by independent events such as packets arriving.
+ *  + Bursty - a burst of ulBurstLength interrupts ulBurstSpacingUs apart
+ *    starting every ulIntervalUs.
+ *  + Replay - the times read from a text file that contains one time per line,
+ *    in microseconds from the start of the sequence, in ascending order.  Once
+ *    the last time is reached the sequence repeats ulIntervalUs microseconds
+ *    later, or the source stops if ulIntervalUs is 0.
+ *
+ * Interrupt times are absolute, so a source that falls behind raises the
+ * interrupts it missed as quickly as it can rather than drifting.  How far
+ * behind it fell is reported so the accuracy of the source can be checked.
+ *
+ * The handler installed with vPortSetInterruptHandler() must call
+ * vInterruptSourceISREntry() first, which records the time from the interrupt
+ * being raised to the handler starting to execute.  The Windows port holds one
+ * pending flag per interrupt number, so interrupts raised while one is already
+ * pending are merged into a single execution of the handler, as happens with
+ * an edge triggered interrupt on real hardware.  Such interrupts are counted as
+ * coalesced, and the latency is measured from the first of them.  Each source
+ * must use its own interrupt number.
+ *
+ * Sources must be created before the scheduler is started, as creating a
+ * Windows thread is a Windows system call, which must not be made from a
+ * FreeRTOS task.  A source does not raise interrupts until it is started.
+ * Between interrupts the thread sleeps if the next interrupt is far enough in
+ * the future, and otherwise busy waits, so high rates occupy a host core.
+ * vBenchmarkTimerInit() must be called before a source is created.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+
+/* The maximum number of times read from a replay file.  Can be overridden in
+ * FreeRTOSConfig.h. */
+#ifndef interruptsourceMAX_REPLAY_TIMES
+    #define interruptsourceMAX_REPLAY_TIMES    1024
+#endif
+
+/* How the times at which interrupts are raised are chosen. */
+typedef enum
+{
+    eInterruptSourceFixed = 0,
+    eInterruptSourcePoisson,
+    eInterruptSourceBursty,
+    eInterruptSourceReplay
+} InterruptSourceModel_t;
+
+/* The parameters of one source. */
+typedef struct InterruptSourceParameters
+{
+    const char * pcName;
+    uint32_t ulInterruptNumber;    /* 3 or above, as 0 to 2 are used by the port. */
+    InterruptSourceModel_t eModel;
+    uint32_t ulIntervalUs;         /* See the description of each model above. */
+    uint32_t ulBurstLength;        /* Only used by eInterruptSourceBursty. */
+    uint32_t ulBurstSpacingUs;     /* Only used by eInterruptSourceBursty. */
+    const char * pcReplayFile;     /* Only used by eInterruptSourceReplay. */
+    uint32_t ulSeed;               /* Seed for the Poisson model, must not be 0. */
+} InterruptSourceParameters_t;
+
+/* Statistics gathered by each source. */
+typedef struct InterruptSourceStats
+{
+    uint32_t ulRaised;             /* Interrupts raised by the source. */
+    uint32_t ulHandled;            /* Executions of the handler. */
+    uint32_t ulCoalesced;          /* Interrupts merged with one already pending. */
+    uint32_t ulMeasured;           /* Executions of the handler whose latency was measured. */
+    uint64_t ullTotalLatencyNs;    /* Total time from raising to handler entry. */
+    uint32_t ulMaxLatencyNs;       /* Longest time from raising to handler entry. */
+    uint32_t ulMaxLagUs;           /* Furthest the source fell behind its schedule. */
+} InterruptSourceStats_t;
+
+typedef struct InterruptSource * InterruptSourceHandle_t;
+
+/*
+ * Create a source, initially stopped.  Must be called before the scheduler is
+ * started.  Returns NULL if there was insufficient heap memory, the Windows
+ * thread could not be created, or the replay file could not be read.
+ */
+InterruptSourceHandle_t xInterruptSourceCreate( const InterruptSourceParameters_t * pxParameters );
+
+/*
+ * Start or stop raising interrupts.  A source that is started again restarts
+ * its sequence from the beginning, even if it was stopped and started again
+ * before its thread noticed it had been stopped.  Can be called from a task.
+ */
+void vInterruptSourceStart( InterruptSourceHandle_t xSource );
+void vInterruptSourceStop( InterruptSourceHandle_t xSource );
+
+/*
+ * Change ulIntervalUs while the source is running, so the interrupt rate can be
+ * swept.  Takes effect from the next interval.
+ */
+void vInterruptSourceSetInterval( InterruptSourceHandle_t xSource,
+                                  uint32_t ulIntervalUs );
+
+/*
+ * Must be called at the start of the source's interrupt handler.
+ */
+void vInterruptSourceISREntry( InterruptSourceHandle_t xSource );
+
+/*
+ * Copy out, and optionally clear, the statistics gathered by a source.  Can be
+ * called from a task.
+ */
+void vInterruptSourceGetStats( InterruptSourceHandle_t xSource,
+                               InterruptSourceStats_t * pxStats,
+                               BaseType_t xClear );
+
+#endif /* INTERRUPT_SOURCE_H */
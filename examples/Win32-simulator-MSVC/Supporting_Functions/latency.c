@@ -0,0 +1,133 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/*
+ * Decade histograms and tick interrupt times.  See latency.h for a
+ * description.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "latency.h"
+
+/*-----------------------------------------------------------*/
+
+/* The time of each recent tick interrupt, indexed by the tick count.  Only
+ * written by the tick interrupt. */
+static volatile uint32_t ulTickTimes[ latencyTICK_TIMES ];
+
+/*-----------------------------------------------------------*/
+
+void vLatencyHistogramAdd( uint32_t * pulHistogram,
+                           UBaseType_t uxNumBuckets,
+                           uint32_t ulTimeUs )
+{
+    UBaseType_t uxBucket = 0;
+    uint32_t ulBound = 10UL;
+
+    configASSERT( uxNumBuckets > 0 );
+
+    while( ( uxBucket < ( uxNumBuckets - 1 ) ) && ( ulTimeUs >= ulBound ) )
+    {
+        uxBucket++;
+        ulBound *= 10UL;
+    }
+
+    pulHistogram[ uxBucket ]++;
+}
+/*-----------------------------------------------------------*/
+
+void vLatencyHistogramPrint( const char * pcLabel,
+                             const uint32_t * pulHistogram,
+                             UBaseType_t uxNumBuckets )
+{
+    UBaseType_t uxBucket;
+    uint32_t ulBound = 10UL;
+    size_t xLength;
+    char cBuffer[ 200 ];
+
+    xLength = ( size_t ) snprintf( cBuffer, sizeof( cBuffer ), "    %-17s", pcLabel );
+
+    for( uxBucket = 0; ( uxBucket < uxNumBuckets ) && ( xLength < sizeof( cBuffer ) ); uxBucket++ )
+    {
+        if( uxBucket == ( uxNumBuckets - 1 ) )
+        {
+            /* The last bucket has no upper bound, so is labelled with the
+             * bound of the bucket before it. */
+            ulBound /= 10UL;
+            xLength += ( size_t ) snprintf( &( cBuffer[ xLength ] ), sizeof( cBuffer ) - xLength, "  >=" );
+        }
+        else
+        {
+            xLength += ( size_t ) snprintf( &( cBuffer[ xLength ] ), sizeof( cBuffer ) - xLength, "  <" );
+        }
+
+        if( xLength >= sizeof( cBuffer ) )
+        {
+            break;
+        }
+
+        if( ulBound >= 1000000UL )
+        {
+            xLength += ( size_t ) snprintf( &( cBuffer[ xLength ] ), sizeof( cBuffer ) - xLength, "%lus %lu", ( unsigned long ) ( ulBound / 1000000UL ), ( unsigned long ) pulHistogram[ uxBucket ] );
+        }
+        else if( ulBound >= 1000UL )
+        {
+            xLength += ( size_t ) snprintf( &( cBuffer[ xLength ] ), sizeof( cBuffer ) - xLength, "%lums %lu", ( unsigned long ) ( ulBound / 1000UL ), ( unsigned long ) pulHistogram[ uxBucket ] );
+        }
+        else
+        {
+            xLength += ( size_t ) snprintf( &( cBuffer[ xLength ] ), sizeof( cBuffer ) - xLength, "%luus %lu", ( unsigned long ) ulBound, ( unsigned long ) pulHistogram[ uxBucket ] );
+        }
+
+        ulBound *= 10UL;
+    }
+
+    vPrintString( cBuffer );
+    vPrintString( "\r\n" );
+}
+/*-----------------------------------------------------------*/
+
+void vLatencyTickHook( uint32_t ulTickCount )
+{
+    /* traceTASK_INCREMENT_TICK() is called before the tick count is
+     * incremented, so this is the time of tick ulTickCount + 1. */
+    ulTickTimes[ ( ulTickCount + 1UL ) & ( latencyTICK_TIMES - 1UL ) ] = ulBenchmarkTimerGetMicroseconds();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xLatencyGetTickTime( TickType_t xTick,
+                                uint32_t * pulTimeUs )
+{
+    BaseType_t xReturn = pdFAIL;
+
+    /* The subtraction wraps if xTick is in the future, so that case is caught
+     * by the same comparison as a tick that is too old. */
+    if( ( xTaskGetTickCount() - xTick ) < ( TickType_t ) latencyTICK_TIMES )
+    {
+        *pulTimeUs = ulTickTimes[ xTick & ( latencyTICK_TIMES - 1UL ) ];
+        xReturn = pdPASS;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
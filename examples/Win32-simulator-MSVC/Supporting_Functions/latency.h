@@ -0,0 +1,81 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+/*
+ * Helpers shared by the modules and examples that measure how long things
+ * take in microseconds.
+ *
+ * A decade histogram counts times in buckets whose upper bounds are 10us,
+ * 100us, 1ms and so on, with the last bucket counting everything at or above
+ * the bound of the bucket before it.  A handful of buckets therefore covers
+ * everything from a context switch to a task that was starved for seconds, and
+ * adding a time takes at most one comparison per bucket.  The histogram is an
+ * array of uint32_t owned by the caller, so it can be embedded in whatever
+ * structure holds the rest of the caller's statistics.
+ *
+ * The tick time ring remembers the benchmark timer value at each of the last
+ * latencyTICK_TIMES tick interrupts, indexed by tick count.  Software timers,
+ * and tasks delayed with vTaskDelayUntil(), become due on a tick, so the time
+ * from that tick interrupt to the timer's callback, or the task, executing is
+ * the latency introduced by the kernel and the application.  The ring is only
+ * recorded when FreeRTOSConfig.h contains:
+ *
+ *  #define traceTASK_INCREMENT_TICK( xTickCount )  vLatencyTickHook( xTickCount )
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+
+/* The number of recent tick interrupt times remembered.  Must be a power of 2.
+ * Can be overridden in FreeRTOSConfig.h. */
+#ifndef latencyTICK_TIMES
+    #define latencyTICK_TIMES    1024
+#endif
+
+/*
+ * Count ulTimeUs in the decade histogram pointed to by pulHistogram, which has
+ * uxNumBuckets buckets.  Does not enter a critical section, so the caller must
+ * prevent the histogram being updated from two places at once.
+ */
+void vLatencyHistogramAdd( uint32_t * pulHistogram,
+                           UBaseType_t uxNumBuckets,
+                           uint32_t ulTimeUs );
+
+/*
+ * Print the decade histogram pointed to by pulHistogram on one line, after
+ * pcLabel, labelling each bucket with its upper bound.
+ */
+void vLatencyHistogramPrint( const char * pcLabel,
+                             const uint32_t * pulHistogram,
+                             UBaseType_t uxNumBuckets );
+
+/*
+ * Record the time of the tick interrupt.  Must only be called from
+ * traceTASK_INCREMENT_TICK(), as shown above.
+ */
+void vLatencyTickHook( uint32_t ulTickCount );
+
+/*
+ * Write the benchmark timer value, in microseconds, at which the tick interrupt
+ * that set the tick count to xTick occurred to *pulTimeUs.  Returns pdFAIL if
+ * xTick has not occurred yet, or occurred so long ago that its time has been
+ * overwritten, in which case the caller can only measure from the tick count.
+ */
+BaseType_t xLatencyGetTickTime( TickType_t xTick,
+                                uint32_t * pulTimeUs );
+
+#endif /* LATENCY_H */
@@ -0,0 +1,350 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/*
+ * Variable length message queue.  See message_queue.h for a description.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* Demo includes. */
+#include "message_queue.h"
+
+/* Each message in the ring starts with a header. */
+typedef struct MessageHeader
+{
+    uint32_t ulTag;
+    uint32_t ulLength; /* Length of the payload that follows the header. */
+} MessageHeader_t;
+
+typedef struct MessageQueue
+{
+    uint8_t * pucStorage;
+    size_t xStorageSize;
+    size_t xReadIndex;  /* Where the oldest message starts. */
+    size_t xWriteIndex; /* Where the next message will be written. */
+    size_t xBytesUsed;
+    UBaseType_t uxMessagesWaiting;
+    UBaseType_t uxSendersWaiting;   /* Tasks blocked because their message did not fit. */
+    UBaseType_t uxReceiversWaiting; /* Tasks blocked because the ring was empty. */
+
+    /* Given once for each waiting receiver when a message is sent, and once
+     * for each waiting sender when a message is received.  Every waiting task
+     * is unblocked and re-checks the ring, so a sender whose message still does
+     * not fit cannot hold up a shorter message that would.  A task that times
+     * out just before it is given a semaphore only costs another task an extra
+     * check. */
+    SemaphoreHandle_t xMessageSent;
+    SemaphoreHandle_t xMessageReceived;
+} MessageQueue_t;
+
+/* The maximum count of the semaphores used to unblock waiting tasks.  It only
+ * needs to be at least the number of tasks that can wait at once. */
+#define messagequeueMAX_WAKE_COUNT    ( ( UBaseType_t ) 0xffffUL )
+
+/* Copy bytes into or out of the ring starting at xIndex, wrapping around the
+ * end of the ring if necessary.  Both return the index after the last byte
+ * copied. */
+static size_t prvCopyToRing( MessageQueue_t * pxQueue,
+                             size_t xIndex,
+                             const void * pvData,
+                             size_t xLength );
+static size_t prvCopyFromRing( const MessageQueue_t * pxQueue,
+                               size_t xIndex,
+                               void * pvData,
+                               size_t xLength );
+
+/* Give xSemaphore once for each of uxNumTasks waiting tasks. */
+static void prvWake( SemaphoreHandle_t xSemaphore,
+                     UBaseType_t uxNumTasks );
+
+/*-----------------------------------------------------------*/
+
+MessageQueueHandle_t xMessageQueueCreate( size_t xStorageSize )
+{
+    MessageQueue_t * pxQueue;
+
+    configASSERT( xStorageSize >= sizeof( MessageHeader_t ) );
+
+    /* The structure and the ring are allocated together. */
+    pxQueue = ( MessageQueue_t * ) pvPortMalloc( sizeof( MessageQueue_t ) + xStorageSize );
+
+    if( pxQueue != NULL )
+    {
+        pxQueue->pucStorage = ( uint8_t * ) ( pxQueue + 1 );
+        pxQueue->xStorageSize = xStorageSize;
+        pxQueue->xReadIndex = 0;
+        pxQueue->xWriteIndex = 0;
+        pxQueue->xBytesUsed = 0;
+        pxQueue->uxMessagesWaiting = 0;
+        pxQueue->uxSendersWaiting = 0;
+        pxQueue->uxReceiversWaiting = 0;
+        pxQueue->xMessageSent = xSemaphoreCreateCounting( messagequeueMAX_WAKE_COUNT, 0 );
+        pxQueue->xMessageReceived = xSemaphoreCreateCounting( messagequeueMAX_WAKE_COUNT, 0 );
+
+        if( ( pxQueue->xMessageSent == NULL ) || ( pxQueue->xMessageReceived == NULL ) )
+        {
+            if( pxQueue->xMessageSent != NULL )
+            {
+                vSemaphoreDelete( pxQueue->xMessageSent );
+            }
+
+            if( pxQueue->xMessageReceived != NULL )
+            {
+                vSemaphoreDelete( pxQueue->xMessageReceived );
+            }
+
+            vPortFree( pxQueue );
+            pxQueue = NULL;
+        }
+    }
+
+    return pxQueue;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xMessageQueueSend( MessageQueueHandle_t xQueue,
+                              uint32_t ulTag,
+                              const void * pvPayload,
+                              size_t xLength,
+                              TickType_t xTicksToWait )
+{
+    MessageQueue_t * pxQueue = xQueue;
+    const size_t xMessageSize = sizeof( MessageHeader_t ) + xLength;
+    MessageHeader_t xHeader;
+    TimeOut_t xTimeOut;
+    BaseType_t xReturn = errQUEUE_FULL, xWaiting = pdFALSE;
+    UBaseType_t uxToWake = 0;
+    size_t xIndex;
+
+    configASSERT( pxQueue != NULL );
+    configASSERT( ( pvPayload != NULL ) || ( xLength == 0 ) );
+
+    /* A message that is larger than the ring could never be sent. */
+    configASSERT( xMessageSize <= pxQueue->xStorageSize );
+
+    xHeader.ulTag = ulTag;
+    xHeader.ulLength = ( uint32_t ) xLength;
+    vTaskSetTimeOutState( &xTimeOut );
+
+    for( ; ; )
+    {
+        vTaskSuspendAll();
+        {
+            if( xWaiting != pdFALSE )
+            {
+                pxQueue->uxSendersWaiting--;
+                xWaiting = pdFALSE;
+            }
+
+            if( ( pxQueue->xStorageSize - pxQueue->xBytesUsed ) >= xMessageSize )
+            {
+                xIndex = prvCopyToRing( pxQueue, pxQueue->xWriteIndex, &xHeader, sizeof( xHeader ) );
+                pxQueue->xWriteIndex = prvCopyToRing( pxQueue, xIndex, pvPayload, xLength );
+                pxQueue->xBytesUsed += xMessageSize;
+                pxQueue->uxMessagesWaiting++;
+                uxToWake = pxQueue->uxReceiversWaiting;
+                xReturn = pdPASS;
+            }
+            else if( xTicksToWait != 0 )
+            {
+                /* Registering as a waiter in the same scheduler locked section
+                 * as finding the ring full means a receive that makes space
+                 * before this task blocks still gives the semaphore. */
+                pxQueue->uxSendersWaiting++;
+                xWaiting = pdTRUE;
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        if( xWaiting == pdFALSE )
+        {
+            break;
+        }
+
+        /* Wait for a receiving task to make space, then check again.
+         * xTaskCheckForTimeOut() sets xTicksToWait to 0 once the block time has
+         * expired, so the ring is checked one last time without blocking. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            ( void ) xSemaphoreTake( pxQueue->xMessageReceived, xTicksToWait );
+        }
+    }
+
+    /* Unblock every task waiting to receive. */
+    prvWake( pxQueue->xMessageSent, uxToWake );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xMessageQueueReceive( MessageQueueHandle_t xQueue,
+                                 uint32_t * pulTag,
+                                 void * pvBuffer,
+                                 size_t xBufferLength,
+                                 size_t * pxReceivedLength,
+                                 TickType_t xTicksToWait )
+{
+    MessageQueue_t * pxQueue = xQueue;
+    MessageHeader_t xHeader;
+    TimeOut_t xTimeOut;
+    BaseType_t xReturn = errQUEUE_EMPTY, xWaiting = pdFALSE;
+    UBaseType_t uxToWake = 0;
+    size_t xIndex;
+
+    configASSERT( pxQueue != NULL );
+    configASSERT( pulTag != NULL );
+    configASSERT( pxReceivedLength != NULL );
+    configASSERT( ( pvBuffer != NULL ) || ( xBufferLength == 0 ) );
+
+    *pxReceivedLength = 0;
+    vTaskSetTimeOutState( &xTimeOut );
+
+    for( ; ; )
+    {
+        vTaskSuspendAll();
+        {
+            if( xWaiting != pdFALSE )
+            {
+                pxQueue->uxReceiversWaiting--;
+                xWaiting = pdFALSE;
+            }
+
+            if( pxQueue->uxMessagesWaiting > 0 )
+            {
+                xIndex = prvCopyFromRing( pxQueue, pxQueue->xReadIndex, &xHeader, sizeof( xHeader ) );
+                *pxReceivedLength = ( size_t ) xHeader.ulLength;
+
+                /* Leave the message in the queue if it does not fit in the
+                 * buffer, so the caller can try again with a larger buffer. */
+                if( xHeader.ulLength <= xBufferLength )
+                {
+                    pxQueue->xReadIndex = prvCopyFromRing( pxQueue, xIndex, pvBuffer, xHeader.ulLength );
+                    pxQueue->xBytesUsed -= sizeof( xHeader ) + xHeader.ulLength;
+                    pxQueue->uxMessagesWaiting--;
+                    uxToWake = pxQueue->uxSendersWaiting;
+                    *pulTag = xHeader.ulTag;
+                    xReturn = pdPASS;
+                }
+            }
+            else if( xTicksToWait != 0 )
+            {
+                pxQueue->uxReceiversWaiting++;
+                xWaiting = pdTRUE;
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        if( xWaiting == pdFALSE )
+        {
+            /* The message was received, was too long for the buffer, or the
+             * block time expired. */
+            break;
+        }
+
+        /* Wait for a sending task to send a message, then check again. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            ( void ) xSemaphoreTake( pxQueue->xMessageSent, xTicksToWait );
+        }
+    }
+
+    /* Unblock every task waiting to send, as the space freed may be enough for
+     * any of their messages. */
+    prvWake( pxQueue->xMessageReceived, uxToWake );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxMessageQueueMessagesWaiting( MessageQueueHandle_t xQueue )
+{
+    return xQueue->uxMessagesWaiting;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCopyToRing( MessageQueue_t * pxQueue,
+                             size_t xIndex,
+                             const void * pvData,
+                             size_t xLength )
+{
+    size_t xFirstPart = pxQueue->xStorageSize - xIndex;
+
+    if( xFirstPart > xLength )
+    {
+        xFirstPart = xLength;
+    }
+
+    if( xLength > 0 )
+    {
+        memcpy( &( pxQueue->pucStorage[ xIndex ] ), pvData, xFirstPart );
+        memcpy( pxQueue->pucStorage, ( ( const uint8_t * ) pvData ) + xFirstPart, xLength - xFirstPart );
+    }
+
+    xIndex += xLength;
+
+    if( xIndex >= pxQueue->xStorageSize )
+    {
+        xIndex -= pxQueue->xStorageSize;
+    }
+
+    return xIndex;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCopyFromRing( const MessageQueue_t * pxQueue,
+                               size_t xIndex,
+                               void * pvData,
+                               size_t xLength )
+{
+    size_t xFirstPart = pxQueue->xStorageSize - xIndex;
+
+    if( xFirstPart > xLength )
+    {
+        xFirstPart = xLength;
+    }
+
+    if( xLength > 0 )
+    {
+        memcpy( pvData, &( pxQueue->pucStorage[ xIndex ] ), xFirstPart );
+        memcpy( ( ( uint8_t * ) pvData ) + xFirstPart, pxQueue->pucStorage, xLength - xFirstPart );
+    }
+
+    xIndex += xLength;
+
+    if( xIndex >= pxQueue->xStorageSize )
+    {
+        xIndex -= pxQueue->xStorageSize;
+    }
+
+    return xIndex;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWake( SemaphoreHandle_t xSemaphore,
+                     UBaseType_t uxNumTasks )
+{
+    while( uxNumTasks > 0 )
+    {
+        ( void ) xSemaphoreGive( xSemaphore );
+        uxNumTasks--;
+    }
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,99 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef MESSAGE_QUEUE_H
+#define MESSAGE_QUEUE_H
+
+/*
+ * A queue of variable length messages.
+ *
+ * Section 5.5.2 of the book describes how FreeRTOS+TCP sends IPStackEvent_t
+ * structures to its task - each structure holds an event type and a pointer
+ * that either holds a value directly or points to a separately allocated
+ * buffer that holds the event's data.  Every event that has data therefore
+ * costs a heap allocation and a heap free in addition to the queue operations.
+ *
+ * A message queue instead stores each message, an event tag followed by any
+ * number of bytes of payload, directly in a ring buffer of bytes.  The payload
+ * is copied into the ring by the sender and out of the ring by the receiver,
+ * so no allocation is needed, and short messages only occupy as many bytes of
+ * the ring as they need.  Messages are received in the order they were sent.
+ * Sending blocks while there is not enough space in the ring for the message,
+ * and receiving blocks while the ring is empty, with the same semantics as
+ * xQueueSend() and xQueueReceive().  Any number of tasks can send to and
+ * receive from the same message queue.
+ *
+ * Messages are copied with the scheduler suspended, rather than in a critical
+ * section, so interrupts are not disabled while long messages are copied.
+ * Consequently the functions below must not be called from an interrupt.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Each message occupies this many bytes of the ring in addition to its
+ * payload. */
+#define messagequeueMESSAGE_OVERHEAD    ( sizeof( uint32_t ) * 2 )
+
+/* The ring size needed to hold uxNumMessages messages of xPayloadLength
+ * bytes. */
+#define messagequeueSTORAGE_SIZE( uxNumMessages, xPayloadLength ) \
+    ( ( size_t ) ( uxNumMessages ) * ( messagequeueMESSAGE_OVERHEAD + ( size_t ) ( xPayloadLength ) ) )
+
+typedef struct MessageQueue * MessageQueueHandle_t;
+
+/*
+ * Create a message queue whose ring holds xStorageSize bytes.  The largest
+ * payload that can be sent is xStorageSize - messagequeueMESSAGE_OVERHEAD bytes.
+ * Returns NULL if there was insufficient heap memory.
+ */
+MessageQueueHandle_t xMessageQueueCreate( size_t xStorageSize );
+
+/*
+ * Send a message with tag ulTag and the xLength byte payload pointed to by
+ * pvPayload.  pvPayload can be NULL if xLength is 0.  If there is not enough
+ * space in the ring the calling task is held in the Blocked state for at most
+ * xTicksToWait ticks waiting for space to become available.  Returns pdPASS if
+ * the message was sent, or errQUEUE_FULL if the block time expired first.
+ */
+BaseType_t xMessageQueueSend( MessageQueueHandle_t xQueue,
+                              uint32_t ulTag,
+                              const void * pvPayload,
+                              size_t xLength,
+                              TickType_t xTicksToWait );
+
+/*
+ * Receive the oldest message.  The tag is written to *pulTag, the payload to
+ * the xBufferLength byte buffer pointed to by pvBuffer, and the length of the
+ * payload to *pxReceivedLength.  If the queue is empty the calling task is held
+ * in the Blocked state for at most xTicksToWait ticks waiting for a message to
+ * arrive.  Returns pdPASS if a message was received.  Otherwise returns
+ * errQUEUE_EMPTY, with *pxReceivedLength set to 0 if the block time expired or
+ * to the payload length if the payload was too long for the buffer, in which
+ * case the message is left in the queue.
+ */
+BaseType_t xMessageQueueReceive( MessageQueueHandle_t xQueue,
+                                 uint32_t * pulTag,
+                                 void * pvBuffer,
+                                 size_t xBufferLength,
+                                 size_t * pxReceivedLength,
+                                 TickType_t xTicksToWait );
+
+/*
+ * Return the number of messages in the queue.
+ */
+UBaseType_t uxMessageQueueMessagesWaiting( MessageQueueHandle_t xQueue );
+
+#endif /* MESSAGE_QUEUE_H */
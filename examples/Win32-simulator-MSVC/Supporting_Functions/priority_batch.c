@@ -0,0 +1,53 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/*
+ * Batched priority changes.  See priority_batch.h for a description.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "priority_batch.h"
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xPriorityBatchApply( const PriorityUpdate_t * pxUpdates,
+                                size_t xNumUpdates )
+{
+    size_t x;
+
+    configASSERT( ( pxUpdates != NULL ) || ( xNumUpdates == 0 ) );
+    configASSERT( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING );
+
+    /* vTaskPrioritySet() never blocks, so can be called while the scheduler is
+     * suspended.  A yield it requests while the scheduler is suspended only
+     * marks a yield as pending, so the calling task keeps running until every
+     * change has been made.  Interrupts are only masked within each call, so
+     * the length of the batch does not affect interrupt latency. */
+    vTaskSuspendAll();
+    {
+        for( x = 0; x < xNumUpdates; x++ )
+        {
+            configASSERT( pxUpdates[ x ].uxNewPriority < configMAX_PRIORITIES );
+            vTaskPrioritySet( pxUpdates[ x ].xTask, pxUpdates[ x ].uxNewPriority );
+        }
+    }
+
+    /* Perform the single pending context switch, if there is one. */
+    return xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,54 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef PRIORITY_BATCH_H
+#define PRIORITY_BATCH_H
+
+/*
+ * Apply a set of priority changes as a single operation.
+ *
+ * Each call to vTaskPrioritySet() that raises a task above the calling task,
+ * or lowers the calling task below another Ready state task, causes an
+ * immediate context switch.  A task that rebalances the priorities of many
+ * other tasks one call at a time can therefore cause a context switch per
+ * change, and the tasks that run in between observe a half applied set of
+ * priorities.
+ *
+ * xPriorityBatchApply() makes all the changes with the scheduler suspended.
+ * Any context switch requested by an individual change is held pending until
+ * the scheduler is resumed, at which point the highest priority Ready state
+ * task runs - so there is at most one context switch however many priorities
+ * are changed.  Interrupts remain enabled throughout.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* A single priority change. */
+typedef struct PriorityUpdate
+{
+    TaskHandle_t xTask;        /* The task to change, or NULL for the calling task. */
+    UBaseType_t uxNewPriority;
+} PriorityUpdate_t;
+
+/*
+ * Apply the xNumUpdates priority changes in the array pointed to by pxUpdates,
+ * in array order.  Must not be called with the scheduler suspended.  Returns
+ * pdTRUE if applying the changes caused a context switch, otherwise pdFALSE.
+ */
+BaseType_t xPriorityBatchApply( const PriorityUpdate_t * pxUpdates,
+                                size_t xNumUpdates );
+
+#endif /* PRIORITY_BATCH_H */
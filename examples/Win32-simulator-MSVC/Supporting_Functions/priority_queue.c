@@ -0,0 +1,335 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/*
+ * Multi level priority message queue.  See priority_queue.h for a description.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "semphr.h"
+
+/* Demo includes. */
+#include "priority_queue.h"
+
+/* The state kept for each priority level. */
+typedef struct PriorityQueueLevel
+{
+    QueueHandle_t xItems;
+    UBaseType_t uxCount; /* Items sent to xItems and not yet claimed by a receiver. */
+} PriorityQueueLevel_t;
+
+typedef struct PriorityQueue
+{
+    /* Given once for each item sent, after the item has been recorded in the
+     * bitmap, and taken once for each item received, before the item is
+     * removed, so a task holding a count is guaranteed to find an item. */
+    SemaphoreHandle_t xItemCount;
+
+    /* Bit n is set when level n is not empty. */
+    uint32_t ulNonEmptyLevels;
+
+    UBaseType_t uxNumLevels;
+    PriorityQueueLevel_t * pxLevels;
+} PriorityQueue_t;
+
+/* Claim an item from the highest priority level that is not empty, and return
+ * that level.  Must be called from a critical section, by a task or interrupt
+ * that has taken the item count.  The claimed item is then received from the
+ * level outside the critical section. */
+static UBaseType_t prvClaimHighestPriorityLevel( PriorityQueue_t * pxQueue );
+
+/* Return the position of the most significant bit that is set in ulWord. */
+static UBaseType_t prvHighestSetBit( uint32_t ulWord );
+
+/*-----------------------------------------------------------*/
+
+PriorityQueueHandle_t xPriorityQueueCreate( UBaseType_t uxNumLevels,
+                                            UBaseType_t uxLengthPerLevel,
+                                            UBaseType_t uxItemSize )
+{
+    PriorityQueue_t * pxQueue;
+    UBaseType_t ux;
+    BaseType_t xCreated = pdTRUE;
+
+    configASSERT( ( uxNumLevels > 0 ) && ( uxNumLevels <= priorityqueueMAX_LEVELS ) );
+    configASSERT( uxLengthPerLevel > 0 );
+
+    /* The structure and the array of levels are allocated together. */
+    pxQueue = ( PriorityQueue_t * ) pvPortMalloc( sizeof( PriorityQueue_t ) + ( uxNumLevels * sizeof( PriorityQueueLevel_t ) ) );
+
+    if( pxQueue != NULL )
+    {
+        pxQueue->ulNonEmptyLevels = 0;
+        pxQueue->uxNumLevels = uxNumLevels;
+        pxQueue->pxLevels = ( PriorityQueueLevel_t * ) ( pxQueue + 1 );
+        pxQueue->xItemCount = xSemaphoreCreateCounting( uxNumLevels * uxLengthPerLevel, 0 );
+
+        if( pxQueue->xItemCount == NULL )
+        {
+            xCreated = pdFALSE;
+        }
+
+        for( ux = 0; ux < uxNumLevels; ux++ )
+        {
+            pxQueue->pxLevels[ ux ].uxCount = 0;
+            pxQueue->pxLevels[ ux ].xItems = xQueueCreate( uxLengthPerLevel, uxItemSize );
+
+            if( pxQueue->pxLevels[ ux ].xItems == NULL )
+            {
+                xCreated = pdFALSE;
+            }
+        }
+
+        if( xCreated == pdFALSE )
+        {
+            /* Free whatever was created before memory ran out. */
+            if( pxQueue->xItemCount != NULL )
+            {
+                vSemaphoreDelete( pxQueue->xItemCount );
+            }
+
+            for( ux = 0; ux < uxNumLevels; ux++ )
+            {
+                if( pxQueue->pxLevels[ ux ].xItems != NULL )
+                {
+                    vQueueDelete( pxQueue->pxLevels[ ux ].xItems );
+                }
+            }
+
+            vPortFree( pxQueue );
+            pxQueue = NULL;
+        }
+    }
+
+    return pxQueue;
+}
+/*-----------------------------------------------------------*/
+
+void vPriorityQueueDelete( PriorityQueueHandle_t xQueue )
+{
+    UBaseType_t ux;
+
+    vSemaphoreDelete( xQueue->xItemCount );
+
+    for( ux = 0; ux < xQueue->uxNumLevels; ux++ )
+    {
+        vQueueDelete( xQueue->pxLevels[ ux ].xItems );
+    }
+
+    vPortFree( xQueue );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPriorityQueueSend( PriorityQueueHandle_t xQueue,
+                               const void * pvItem,
+                               UBaseType_t uxPriority,
+                               TickType_t xTicksToWait )
+{
+    PriorityQueueLevel_t * pxLevel;
+    BaseType_t xReturn;
+
+    configASSERT( uxPriority < xQueue->uxNumLevels );
+    pxLevel = &( xQueue->pxLevels[ uxPriority ] );
+
+    xReturn = xQueueSendToBack( pxLevel->xItems, pvItem, xTicksToWait );
+
+    if( xReturn == pdPASS )
+    {
+        taskENTER_CRITICAL();
+        {
+            pxLevel->uxCount++;
+            xQueue->ulNonEmptyLevels |= ( 1UL << uxPriority );
+        }
+        taskEXIT_CRITICAL();
+
+        /* Only now can a receiver be given the item.  The count cannot be full
+         * as it can count every item the levels can hold. */
+        xSemaphoreGive( xQueue->xItemCount );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPriorityQueueSendFromISR( PriorityQueueHandle_t xQueue,
+                                      const void * pvItem,
+                                      UBaseType_t uxPriority,
+                                      BaseType_t * pxHigherPriorityTaskWoken )
+{
+    PriorityQueueLevel_t * pxLevel;
+    UBaseType_t uxSavedInterruptStatus;
+    BaseType_t xReturn;
+
+    configASSERT( uxPriority < xQueue->uxNumLevels );
+    pxLevel = &( xQueue->pxLevels[ uxPriority ] );
+
+    /* Sending to a level cannot unblock a task, as tasks only block on the item
+     * count when receiving. */
+    xReturn = xQueueSendToBackFromISR( pxLevel->xItems, pvItem, NULL );
+
+    if( xReturn == pdPASS )
+    {
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            pxLevel->uxCount++;
+            xQueue->ulNonEmptyLevels |= ( 1UL << uxPriority );
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        xSemaphoreGiveFromISR( xQueue->xItemCount, pxHigherPriorityTaskWoken );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPriorityQueueReceive( PriorityQueueHandle_t xQueue,
+                                  void * pvBuffer,
+                                  UBaseType_t * puxPriority,
+                                  TickType_t xTicksToWait )
+{
+    UBaseType_t uxPriority;
+    BaseType_t xReceived;
+
+    if( xSemaphoreTake( xQueue->xItemCount, xTicksToWait ) != pdPASS )
+    {
+        return errQUEUE_EMPTY;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        uxPriority = prvClaimHighestPriorityLevel( xQueue );
+    }
+    taskEXIT_CRITICAL();
+
+    /* The level holds at least as many items as have been claimed from it, so
+     * the claimed item is there and the receive does not need to block.
+     * Receiving may unblock a task waiting to send to the level. */
+    xReceived = xQueueReceive( xQueue->pxLevels[ uxPriority ].xItems, pvBuffer, 0 );
+    configASSERT( xReceived == pdPASS );
+    ( void ) xReceived;
+
+    if( puxPriority != NULL )
+    {
+        *puxPriority = uxPriority;
+    }
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPriorityQueueReceiveFromISR( PriorityQueueHandle_t xQueue,
+                                         void * pvBuffer,
+                                         UBaseType_t * puxPriority,
+                                         BaseType_t * pxHigherPriorityTaskWoken )
+{
+    UBaseType_t uxPriority, uxSavedInterruptStatus;
+    BaseType_t xReceived;
+
+    if( xSemaphoreTakeFromISR( xQueue->xItemCount, NULL ) != pdPASS )
+    {
+        return errQUEUE_EMPTY;
+    }
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        uxPriority = prvClaimHighestPriorityLevel( xQueue );
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    xReceived = xQueueReceiveFromISR( xQueue->pxLevels[ uxPriority ].xItems, pvBuffer, pxHigherPriorityTaskWoken );
+    configASSERT( xReceived == pdPASS );
+    ( void ) xReceived;
+
+    if( puxPriority != NULL )
+    {
+        *puxPriority = uxPriority;
+    }
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvClaimHighestPriorityLevel( PriorityQueue_t * pxQueue )
+{
+    PriorityQueueLevel_t * pxLevel;
+    UBaseType_t uxPriority;
+
+    uxPriority = prvHighestSetBit( pxQueue->ulNonEmptyLevels );
+    pxLevel = &( pxQueue->pxLevels[ uxPriority ] );
+
+    pxLevel->uxCount--;
+
+    if( pxLevel->uxCount == 0 )
+    {
+        pxQueue->ulNonEmptyLevels &= ~( 1UL << uxPriority );
+    }
+
+    return uxPriority;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPriorityQueueMessagesWaiting( PriorityQueueHandle_t xQueue )
+{
+    return uxSemaphoreGetCount( xQueue->xItemCount );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPriorityQueueAddToSet( PriorityQueueHandle_t xQueue,
+                                   QueueSetHandle_t xQueueSet )
+{
+    return xQueueAddToSet( xQueue->xItemCount, xQueueSet );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPriorityQueueRemoveFromSet( PriorityQueueHandle_t xQueue,
+                                        QueueSetHandle_t xQueueSet )
+{
+    return xQueueRemoveFromSet( xQueue->xItemCount, xQueueSet );
+}
+/*-----------------------------------------------------------*/
+
+QueueSetMemberHandle_t xPriorityQueueGetSetMember( PriorityQueueHandle_t xQueue )
+{
+    return xQueue->xItemCount;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvHighestSetBit( uint32_t ulWord )
+{
+    /* Setting every bit below the most significant set bit then multiplying by
+     * a de Bruijn constant leaves a unique pattern in the top five bits for
+     * each bit position. */
+    static const uint8_t ucBitPositions[ 32 ] =
+    {
+        0,  9,  1,  10, 13, 21, 2,  29, 11, 14, 16, 18, 22, 25, 3,  30,
+        8,  12, 20, 28, 15, 17, 24, 7,  19, 27, 23, 6,  26, 5,  4,  31
+    };
+
+    uint32_t ulHash;
+
+    configASSERT( ulWord != 0 );
+
+    ulWord |= ulWord >> 1;
+    ulWord |= ulWord >> 2;
+    ulWord |= ulWord >> 4;
+    ulWord |= ulWord >> 8;
+    ulWord |= ulWord >> 16;
+    ulHash = ( uint32_t ) ( ulWord * 0x07C4ACDDUL );
+
+    return ( UBaseType_t ) ucBitPositions[ ulHash >> 27 ];
+}
+/*-----------------------------------------------------------*/
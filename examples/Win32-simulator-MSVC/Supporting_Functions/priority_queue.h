@@ -0,0 +1,127 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
+/*
+ * A message queue with multiple priority levels.
+ *
+ * Example021 uses xQueueSendToFrontFromISR() to send messages that must be
+ * output before those already in the queue.  That only provides two levels of
+ * priority, and messages sent to the front of a queue come out in the reverse
+ * of the order in which they were sent, so urgent messages overtake each other
+ * as well as the messages they are meant to overtake.  An urgent message cannot
+ * be sent at all if the queue is already full of less urgent messages.
+ *
+ * A priority queue has a fixed number of priority levels, each of which is an
+ * ordinary queue with its own capacity, so a level filling up has no effect on
+ * the other levels.  Receiving from a priority queue returns the oldest item
+ * from the highest priority level that is not empty, so items are first in
+ * first out within each level.  Like task priorities, higher numbers denote
+ * higher priorities.  A bitmap records which levels are not empty, so finding
+ * the highest priority item takes the same time however many levels there are.
+ *
+ * A counting semaphore counts the items in the priority queue.  Receivers block
+ * on the semaphore, so tasks block on a priority queue exactly as they would on
+ * a queue, and the semaphore can be added to a queue set, so a priority queue
+ * can be used with xQueueSelectFromSet() - see xPriorityQueueAddToSet().
+ * Senders block on the level to which they are sending if it is full.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "queue.h"
+
+/* The maximum number of priority levels, which is limited by the number of bits
+ * in the bitmap. */
+#define priorityqueueMAX_LEVELS    32
+
+typedef struct PriorityQueue * PriorityQueueHandle_t;
+
+/*
+ * Create a priority queue with uxNumLevels priority levels, each of which can
+ * hold uxLengthPerLevel items of uxItemSize bytes.  Returns NULL if there was
+ * insufficient heap memory.
+ */
+PriorityQueueHandle_t xPriorityQueueCreate( UBaseType_t uxNumLevels,
+                                            UBaseType_t uxLengthPerLevel,
+                                            UBaseType_t uxItemSize );
+
+/*
+ * Delete a priority queue.  No tasks may be blocked on the priority queue, and
+ * it must not be a member of a queue set.
+ */
+void vPriorityQueueDelete( PriorityQueueHandle_t xQueue );
+
+/*
+ * Send the item pointed to by pvItem to priority level uxPriority, blocking
+ * for up to xTicksToWait ticks if that level is full.  Returns pdPASS if the
+ * item was sent, otherwise errQUEUE_FULL.
+ */
+BaseType_t xPriorityQueueSend( PriorityQueueHandle_t xQueue,
+                               const void * pvItem,
+                               UBaseType_t uxPriority,
+                               TickType_t xTicksToWait );
+
+/*
+ * A version of xPriorityQueueSend() that can be called from an interrupt
+ * service routine.  Never blocks.
+ */
+BaseType_t xPriorityQueueSendFromISR( PriorityQueueHandle_t xQueue,
+                                      const void * pvItem,
+                                      UBaseType_t uxPriority,
+                                      BaseType_t * pxHigherPriorityTaskWoken );
+
+/*
+ * Receive the oldest item from the highest priority level that is not empty
+ * into the buffer pointed to by pvBuffer, blocking for up to xTicksToWait ticks
+ * if the priority queue is empty.  If puxPriority is not NULL the priority
+ * level of the item is written to *puxPriority.  Returns pdPASS if an item was
+ * received, otherwise errQUEUE_EMPTY.
+ */
+BaseType_t xPriorityQueueReceive( PriorityQueueHandle_t xQueue,
+                                  void * pvBuffer,
+                                  UBaseType_t * puxPriority,
+                                  TickType_t xTicksToWait );
+
+/*
+ * A version of xPriorityQueueReceive() that can be called from an interrupt
+ * service routine.  Never blocks.
+ */
+BaseType_t xPriorityQueueReceiveFromISR( PriorityQueueHandle_t xQueue,
+                                         void * pvBuffer,
+                                         UBaseType_t * puxPriority,
+                                         BaseType_t * pxHigherPriorityTaskWoken );
+
+/*
+ * Return the number of items in the priority queue, across all levels.
+ */
+UBaseType_t uxPriorityQueueMessagesWaiting( PriorityQueueHandle_t xQueue );
+
+/*
+ * Add a priority queue to, or remove it from, a queue set.  As with a queue, the
+ * priority queue must be empty when it is added to or removed from a set, and
+ * the set must be long enough to hold an event for every item the priority
+ * queue can hold.  When xQueueSelectFromSet() returns the handle returned by
+ * xPriorityQueueGetSetMember(), xPriorityQueueReceive() must be called with a
+ * block time of 0 to receive the item.
+ */
+BaseType_t xPriorityQueueAddToSet( PriorityQueueHandle_t xQueue,
+                                   QueueSetHandle_t xQueueSet );
+BaseType_t xPriorityQueueRemoveFromSet( PriorityQueueHandle_t xQueue,
+                                        QueueSetHandle_t xQueueSet );
+QueueSetMemberHandle_t xPriorityQueueGetSetMember( PriorityQueueHandle_t xQueue );
+
+#endif /* PRIORITY_QUEUE_H */
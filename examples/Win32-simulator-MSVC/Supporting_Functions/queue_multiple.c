@@ -0,0 +1,392 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/*
+ * Multiple item queue send and receive.  See queue_multiple.h for a
+ * description.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* Demo includes. */
+#include "queue_multiple.h"
+
+/* The maximum count of the semaphores used to unblock waiting tasks.  It only
+ * needs to be at least the number of tasks that can wait at once. */
+#define queuemultipleMAX_WAKE_COUNT    ( ( UBaseType_t ) 0xffffUL )
+
+typedef struct QueueMultiple
+{
+    uint8_t * pucStorage;
+    UBaseType_t uxLength;
+    UBaseType_t uxItemSize;
+    UBaseType_t uxReadIndex;        /* Index of the oldest item. */
+    UBaseType_t uxItemsWaiting;
+    UBaseType_t uxSendersWaiting;   /* Tasks blocked because the queue was full. */
+    UBaseType_t uxReceiversWaiting; /* Tasks blocked because the queue was empty. */
+
+    /* Given once for each waiting receiver when items are sent, and once for
+     * each waiting sender when items are received.  Every waiting task is
+     * unblocked and re-checks the queue, so a task that times out just before
+     * it is given a semaphore only costs another task an extra check. */
+    SemaphoreHandle_t xItemsSent;
+    SemaphoreHandle_t xItemsReceived;
+} QueueMultiple_t;
+
+/* Copy as many items as fit into, or are available from, the queue's storage
+ * and return the number copied.  Must be called from a critical section. */
+static UBaseType_t prvCopyIn( QueueMultiple_t * pxQueue,
+                              const uint8_t * pucItems,
+                              UBaseType_t uxNumItems );
+static UBaseType_t prvCopyOut( QueueMultiple_t * pxQueue,
+                               uint8_t * pucBuffer,
+                               UBaseType_t uxMaxItems );
+
+/* Give xSemaphore once for each of uxNumTasks waiting tasks. */
+static void prvWake( SemaphoreHandle_t xSemaphore,
+                     UBaseType_t uxNumTasks );
+static void prvWakeFromISR( SemaphoreHandle_t xSemaphore,
+                            UBaseType_t uxNumTasks,
+                            BaseType_t * pxHigherPriorityTaskWoken );
+
+/*-----------------------------------------------------------*/
+
+QueueMultipleHandle_t xQueueMultipleCreate( UBaseType_t uxQueueLength,
+                                            UBaseType_t uxItemSize )
+{
+    QueueMultiple_t * pxQueue;
+
+    configASSERT( uxQueueLength > 0 );
+    configASSERT( uxItemSize > 0 );
+
+    /* The structure and the storage are allocated together. */
+    pxQueue = ( QueueMultiple_t * ) pvPortMalloc( sizeof( QueueMultiple_t ) + ( ( size_t ) uxQueueLength * uxItemSize ) );
+
+    if( pxQueue != NULL )
+    {
+        pxQueue->pucStorage = ( uint8_t * ) ( pxQueue + 1 );
+        pxQueue->uxLength = uxQueueLength;
+        pxQueue->uxItemSize = uxItemSize;
+        pxQueue->uxReadIndex = 0;
+        pxQueue->uxItemsWaiting = 0;
+        pxQueue->uxSendersWaiting = 0;
+        pxQueue->uxReceiversWaiting = 0;
+        pxQueue->xItemsSent = xSemaphoreCreateCounting( queuemultipleMAX_WAKE_COUNT, 0 );
+        pxQueue->xItemsReceived = xSemaphoreCreateCounting( queuemultipleMAX_WAKE_COUNT, 0 );
+
+        if( ( pxQueue->xItemsSent == NULL ) || ( pxQueue->xItemsReceived == NULL ) )
+        {
+            if( pxQueue->xItemsSent != NULL )
+            {
+                vSemaphoreDelete( pxQueue->xItemsSent );
+            }
+
+            if( pxQueue->xItemsReceived != NULL )
+            {
+                vSemaphoreDelete( pxQueue->xItemsReceived );
+            }
+
+            vPortFree( pxQueue );
+            pxQueue = NULL;
+        }
+    }
+
+    return pxQueue;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSendMultiple( QueueMultipleHandle_t xQueue,
+                                 const void * pvItems,
+                                 UBaseType_t uxNumItems,
+                                 TickType_t xTicksToWait )
+{
+    QueueMultiple_t * pxQueue = xQueue;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxSent, uxToWake = 0;
+    BaseType_t xWaiting = pdFALSE;
+
+    configASSERT( pxQueue != NULL );
+    configASSERT( ( pvItems != NULL ) || ( uxNumItems == 0 ) );
+
+    vTaskSetTimeOutState( &xTimeOut );
+
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            if( xWaiting != pdFALSE )
+            {
+                pxQueue->uxSendersWaiting--;
+                xWaiting = pdFALSE;
+            }
+
+            uxSent = prvCopyIn( pxQueue, ( const uint8_t * ) pvItems, uxNumItems );
+
+            if( uxSent > 0 )
+            {
+                uxToWake = pxQueue->uxReceiversWaiting;
+            }
+            else if( ( uxNumItems > 0 ) && ( xTicksToWait != 0 ) )
+            {
+                /* Registering as a waiter in the same critical section as
+                 * finding the queue full means a receive that makes space
+                 * before this task blocks still gives the semaphore. */
+                pxQueue->uxSendersWaiting++;
+                xWaiting = pdTRUE;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xWaiting == pdFALSE )
+        {
+            break;
+        }
+
+        /* xTaskCheckForTimeOut() sets xTicksToWait to 0 once the block time
+         * has expired, so the queue is checked one last time without
+         * blocking. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            ( void ) xSemaphoreTake( pxQueue->xItemsReceived, xTicksToWait );
+        }
+    }
+
+    prvWake( pxQueue->xItemsSent, uxToWake );
+
+    return uxSent;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueReceiveMultiple( QueueMultipleHandle_t xQueue,
+                                    void * pvBuffer,
+                                    UBaseType_t uxMaxItems,
+                                    TickType_t xTicksToWait )
+{
+    QueueMultiple_t * pxQueue = xQueue;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxReceived, uxToWake = 0;
+    BaseType_t xWaiting = pdFALSE;
+
+    configASSERT( pxQueue != NULL );
+    configASSERT( ( pvBuffer != NULL ) || ( uxMaxItems == 0 ) );
+
+    vTaskSetTimeOutState( &xTimeOut );
+
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            if( xWaiting != pdFALSE )
+            {
+                pxQueue->uxReceiversWaiting--;
+                xWaiting = pdFALSE;
+            }
+
+            uxReceived = prvCopyOut( pxQueue, ( uint8_t * ) pvBuffer, uxMaxItems );
+
+            if( uxReceived > 0 )
+            {
+                uxToWake = pxQueue->uxSendersWaiting;
+            }
+            else if( ( uxMaxItems > 0 ) && ( xTicksToWait != 0 ) )
+            {
+                pxQueue->uxReceiversWaiting++;
+                xWaiting = pdTRUE;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xWaiting == pdFALSE )
+        {
+            break;
+        }
+
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            ( void ) xSemaphoreTake( pxQueue->xItemsSent, xTicksToWait );
+        }
+    }
+
+    prvWake( pxQueue->xItemsReceived, uxToWake );
+
+    return uxReceived;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSendMultipleFromISR( QueueMultipleHandle_t xQueue,
+                                        const void * pvItems,
+                                        UBaseType_t uxNumItems,
+                                        BaseType_t * pxHigherPriorityTaskWoken )
+{
+    QueueMultiple_t * pxQueue = xQueue;
+    UBaseType_t uxSavedInterruptStatus, uxSent, uxToWake = 0;
+
+    configASSERT( pxQueue != NULL );
+    configASSERT( ( pvItems != NULL ) || ( uxNumItems == 0 ) );
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        uxSent = prvCopyIn( pxQueue, ( const uint8_t * ) pvItems, uxNumItems );
+
+        if( uxSent > 0 )
+        {
+            uxToWake = pxQueue->uxReceiversWaiting;
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    prvWakeFromISR( pxQueue->xItemsSent, uxToWake, pxHigherPriorityTaskWoken );
+
+    return uxSent;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueReceiveMultipleFromISR( QueueMultipleHandle_t xQueue,
+                                           void * pvBuffer,
+                                           UBaseType_t uxMaxItems,
+                                           BaseType_t * pxHigherPriorityTaskWoken )
+{
+    QueueMultiple_t * pxQueue = xQueue;
+    UBaseType_t uxSavedInterruptStatus, uxReceived, uxToWake = 0;
+
+    configASSERT( pxQueue != NULL );
+    configASSERT( ( pvBuffer != NULL ) || ( uxMaxItems == 0 ) );
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        uxReceived = prvCopyOut( pxQueue, ( uint8_t * ) pvBuffer, uxMaxItems );
+
+        if( uxReceived > 0 )
+        {
+            uxToWake = pxQueue->uxSendersWaiting;
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    prvWakeFromISR( pxQueue->xItemsReceived, uxToWake, pxHigherPriorityTaskWoken );
+
+    return uxReceived;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvCopyIn( QueueMultiple_t * pxQueue,
+                              const uint8_t * pucItems,
+                              UBaseType_t uxNumItems )
+{
+    UBaseType_t uxWriteIndex, uxFirstPart;
+
+    if( uxNumItems > ( pxQueue->uxLength - pxQueue->uxItemsWaiting ) )
+    {
+        uxNumItems = pxQueue->uxLength - pxQueue->uxItemsWaiting;
+    }
+
+    uxWriteIndex = pxQueue->uxReadIndex + pxQueue->uxItemsWaiting;
+
+    if( uxWriteIndex >= pxQueue->uxLength )
+    {
+        uxWriteIndex -= pxQueue->uxLength;
+    }
+
+    /* The items are copied in at most two parts - up to the end of the
+     * storage, then from the start of the storage. */
+    uxFirstPart = pxQueue->uxLength - uxWriteIndex;
+
+    if( uxFirstPart > uxNumItems )
+    {
+        uxFirstPart = uxNumItems;
+    }
+
+    if( uxNumItems > 0 )
+    {
+        memcpy( &( pxQueue->pucStorage[ uxWriteIndex * pxQueue->uxItemSize ] ), pucItems, ( size_t ) uxFirstPart * pxQueue->uxItemSize );
+        memcpy( pxQueue->pucStorage, pucItems + ( uxFirstPart * pxQueue->uxItemSize ), ( size_t ) ( uxNumItems - uxFirstPart ) * pxQueue->uxItemSize );
+        pxQueue->uxItemsWaiting += uxNumItems;
+    }
+
+    return uxNumItems;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvCopyOut( QueueMultiple_t * pxQueue,
+                               uint8_t * pucBuffer,
+                               UBaseType_t uxMaxItems )
+{
+    UBaseType_t uxNumItems = pxQueue->uxItemsWaiting, uxFirstPart;
+
+    if( uxNumItems > uxMaxItems )
+    {
+        uxNumItems = uxMaxItems;
+    }
+
+    uxFirstPart = pxQueue->uxLength - pxQueue->uxReadIndex;
+
+    if( uxFirstPart > uxNumItems )
+    {
+        uxFirstPart = uxNumItems;
+    }
+
+    if( uxNumItems > 0 )
+    {
+        memcpy( pucBuffer, &( pxQueue->pucStorage[ pxQueue->uxReadIndex * pxQueue->uxItemSize ] ), ( size_t ) uxFirstPart * pxQueue->uxItemSize );
+        memcpy( pucBuffer + ( uxFirstPart * pxQueue->uxItemSize ), pxQueue->pucStorage, ( size_t ) ( uxNumItems - uxFirstPart ) * pxQueue->uxItemSize );
+        pxQueue->uxItemsWaiting -= uxNumItems;
+        pxQueue->uxReadIndex += uxNumItems;
+
+        if( pxQueue->uxReadIndex >= pxQueue->uxLength )
+        {
+            pxQueue->uxReadIndex -= pxQueue->uxLength;
+        }
+    }
+
+    return uxNumItems;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWake( SemaphoreHandle_t xSemaphore,
+                     UBaseType_t uxNumTasks )
+{
+    while( uxNumTasks > 0 )
+    {
+        ( void ) xSemaphoreGive( xSemaphore );
+        uxNumTasks--;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakeFromISR( SemaphoreHandle_t xSemaphore,
+                            UBaseType_t uxNumTasks,
+                            BaseType_t * pxHigherPriorityTaskWoken )
+{
+    BaseType_t xTaskWoken = pdFALSE;
+
+    while( uxNumTasks > 0 )
+    {
+        ( void ) xSemaphoreGiveFromISR( xSemaphore, &xTaskWoken );
+        uxNumTasks--;
+    }
+
+    /* Only ever set the caller's variable to pdTRUE, as the caller may have
+     * used the same variable with other interrupt safe API functions. */
+    if( ( xTaskWoken != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+    {
+        *pxHigherPriorityTaskWoken = pdTRUE;
+    }
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,94 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef QUEUE_MULTIPLE_H
+#define QUEUE_MULTIPLE_H
+
+/*
+ * A queue that sends and receives several items in one call.
+ *
+ * Sending or receiving items one at a time, as the vIntegerGenerator() task
+ * and the interrupt handler in Example019 do, enters and exits a critical
+ * section, copies the item, and checks whether a task needs to be unblocked,
+ * for every item.  If a higher priority task is waiting for the items then each
+ * item also causes a context switch to that task and back again.
+ *
+ * The queue structure used by the queue API is private to queue.c, so those
+ * costs cannot be shared between items moved through a queue created with
+ * xQueueCreate() without modifying the kernel.  A queue created with
+ * xQueueMultipleCreate() is therefore a separate type with its own storage.
+ * Each call that sends or receives several items enters one critical section,
+ * copies all the items with at most two calls to memcpy() (two when the items
+ * wrap around the end of the storage), and decides once whether any task needs
+ * to be unblocked.  A task waiting for the items is unblocked once and finds
+ * all of them in the queue.  Items are received in the order they were sent,
+ * and any number of tasks and interrupts can send to and receive from the same
+ * queue.
+ *
+ * Interrupts are masked while the items are copied, so the number of items
+ * moved in one call, multiplied by the item size, should be kept small.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+
+typedef struct QueueMultiple * QueueMultipleHandle_t;
+
+/*
+ * Create a queue that can hold uxQueueLength items of uxItemSize bytes.
+ * Returns NULL if there was insufficient heap memory.
+ */
+QueueMultipleHandle_t xQueueMultipleCreate( UBaseType_t uxQueueLength,
+                                            UBaseType_t uxItemSize );
+
+/*
+ * Send up to uxNumItems items from the array pointed to by pvItems to the back
+ * of the queue.  The calling task only enters the Blocked state, for at most
+ * xTicksToWait ticks, if the queue is full, and then only until there is space
+ * for one item - so fewer than uxNumItems items may be sent.  Returns the
+ * number of items sent.
+ */
+UBaseType_t uxQueueSendMultiple( QueueMultipleHandle_t xQueue,
+                                 const void * pvItems,
+                                 UBaseType_t uxNumItems,
+                                 TickType_t xTicksToWait );
+
+/*
+ * Receive up to uxMaxItems items from the queue into the array pointed to by
+ * pvBuffer.  The calling task only enters the Blocked state, for at most
+ * xTicksToWait ticks, if the queue is empty, and then only until one item
+ * arrives.  Returns the number of items received.
+ */
+UBaseType_t uxQueueReceiveMultiple( QueueMultipleHandle_t xQueue,
+                                    void * pvBuffer,
+                                    UBaseType_t uxMaxItems,
+                                    TickType_t xTicksToWait );
+
+/*
+ * Versions of the above that can be called from an interrupt service routine.
+ * *pxHigherPriorityTaskWoken is set to pdTRUE if moving the items unblocked a
+ * task that has a priority above the interrupted task, in which case
+ * portYIELD_FROM_ISR() should be called before the interrupt exits.
+ */
+UBaseType_t uxQueueSendMultipleFromISR( QueueMultipleHandle_t xQueue,
+                                        const void * pvItems,
+                                        UBaseType_t uxNumItems,
+                                        BaseType_t * pxHigherPriorityTaskWoken );
+
+UBaseType_t uxQueueReceiveMultipleFromISR( QueueMultipleHandle_t xQueue,
+                                           void * pvBuffer,
+                                           UBaseType_t uxMaxItems,
+                                           BaseType_t * pxHigherPriorityTaskWoken );
+
+#endif /* QUEUE_MULTIPLE_H */
@@ -0,0 +1,528 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/*
+ * Queue occupancy, blocking time and throughput instrumentation.  See
+ * queue_stats.h for a description.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "latency.h"
+#include "queue_stats.h"
+
+#if ( configQUEUE_REGISTRY_SIZE == 0 ) || ( configNUM_THREAD_LOCAL_STORAGE_POINTERS <= queuestatsTLS_INDEX )
+    #error queue_stats.c requires configQUEUE_REGISTRY_SIZE to be above 0 and configNUM_THREAD_LOCAL_STORAGE_POINTERS to be above queuestatsTLS_INDEX in FreeRTOSConfig.h
+#endif
+
+/* The state kept for each registered queue. */
+typedef struct QueueStatsEntry
+{
+    QueueHandle_t xQueue; /* NULL if the entry is not in use. */
+    const char * pcName;
+    UBaseType_t uxLength;
+
+    /* The time each item in the queue was sent, in the order the items were
+     * sent, so the time each spends in the queue can be calculated when it is
+     * received. */
+    uint32_t * pulSendTimes;
+    UBaseType_t uxHead;
+    UBaseType_t uxMessagesWaiting;
+
+    UBaseType_t uxHighWaterMark;
+    uint32_t ulSends;
+    uint32_t ulReceives;
+    uint32_t ulSendFailures;
+    uint32_t ulReceiveFailures;
+    uint64_t ullSendBlockedUs;
+    uint64_t ullReceiveBlockedUs;
+    uint32_t ulResidencyHistogram[ queuestatsHISTOGRAM_BUCKETS ];
+} QueueStatsEntry_t;
+
+/* The task that periodically prints the statistics. */
+static void prvReporterTask( void * pvParameters );
+
+/* Return the entry for the queue pvQueue, or NULL if the queue is not
+ * registered.  Must be called from a critical section. */
+static QueueStatsEntry_t * prvFindEntry( const void * pvQueue );
+
+/* If the calling task blocked during the API call that is completing, return
+ * how long ago it first blocked and clear its start time, otherwise return 0. */
+static uint32_t prvEndBlocking( uint32_t ulNow );
+
+/* Update the statistics of an entry for an item being sent or received.  Must
+ * be called from a critical section. */
+static void prvRecordSend( QueueStatsEntry_t * pxEntry,
+                           uint32_t ulNow );
+static void prvRecordReceive( QueueStatsEntry_t * pxEntry,
+                              uint32_t ulNow );
+
+/* Copy the statistics of an entry into a snapshot.  Must be called from a
+ * critical section. */
+static void prvFillSnapshot( const QueueStatsEntry_t * pxEntry,
+                             QueueStatsSnapshot_t * pxSnapshot );
+
+/*-----------------------------------------------------------*/
+
+static QueueStatsEntry_t xEntries[ queuestatsMAX_QUEUES ];
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueStatsRegister( QueueHandle_t xQueue,
+                                const char * pcName )
+{
+    QueueStatsEntry_t * pxEntry = NULL;
+    uint32_t * pulSendTimes;
+    UBaseType_t ux, uxLength, uxMessagesWaiting;
+    uint32_t ulNow;
+    BaseType_t xReturn = pdFAIL;
+
+    configASSERT( xQueue != NULL );
+    configASSERT( pcName != NULL );
+
+    uxLength = uxQueueGetQueueLength( xQueue );
+    pulSendTimes = ( uint32_t * ) pvPortMalloc( uxLength * sizeof( uint32_t ) );
+
+    if( pulSendTimes != NULL )
+    {
+        vQueueAddToRegistry( xQueue, pcName );
+
+        taskENTER_CRITICAL();
+        {
+            for( ux = 0; ux < queuestatsMAX_QUEUES; ux++ )
+            {
+                if( xEntries[ ux ].xQueue == NULL )
+                {
+                    pxEntry = &( xEntries[ ux ] );
+                    break;
+                }
+            }
+
+            if( pxEntry != NULL )
+            {
+                memset( pxEntry, 0x00, sizeof( QueueStatsEntry_t ) );
+                pxEntry->pcName = pcName;
+                pxEntry->uxLength = uxLength;
+                pxEntry->pulSendTimes = pulSendTimes;
+
+                /* Items already in the queue, such as the initial count of a
+                 * semaphore, are treated as having been sent now. */
+                uxMessagesWaiting = uxQueueMessagesWaiting( xQueue );
+                ulNow = ulBenchmarkTimerGetMicroseconds();
+
+                for( ux = 0; ux < uxMessagesWaiting; ux++ )
+                {
+                    pulSendTimes[ ux ] = ulNow;
+                }
+
+                pxEntry->uxHead = uxMessagesWaiting % uxLength;
+                pxEntry->uxMessagesWaiting = uxMessagesWaiting;
+                pxEntry->uxHighWaterMark = uxMessagesWaiting;
+
+                /* Setting the handle last makes the entry visible to the trace
+                 * macros. */
+                pxEntry->xQueue = xQueue;
+                xReturn = pdPASS;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xReturn == pdFAIL )
+        {
+            vQueueUnregisterQueue( xQueue );
+            vPortFree( pulSendTimes );
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vQueueStatsUnregister( QueueHandle_t xQueue )
+{
+    QueueStatsEntry_t * pxEntry;
+    uint32_t * pulSendTimes = NULL;
+
+    taskENTER_CRITICAL();
+    {
+        pxEntry = prvFindEntry( xQueue );
+
+        if( pxEntry != NULL )
+        {
+            pulSendTimes = pxEntry->pulSendTimes;
+            pxEntry->xQueue = NULL;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if( pulSendTimes != NULL )
+    {
+        vQueueUnregisterQueue( xQueue );
+        vPortFree( pulSendTimes );
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueStatsGetSnapshot( const char * pcName,
+                                   QueueStatsSnapshot_t * pxSnapshot )
+{
+    UBaseType_t ux;
+    BaseType_t xReturn = pdFAIL;
+
+    taskENTER_CRITICAL();
+    {
+        for( ux = 0; ux < queuestatsMAX_QUEUES; ux++ )
+        {
+            if( ( xEntries[ ux ].xQueue != NULL ) && ( strcmp( xEntries[ ux ].pcName, pcName ) == 0 ) )
+            {
+                prvFillSnapshot( &( xEntries[ ux ] ), pxSnapshot );
+                xReturn = pdPASS;
+                break;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueStatsStartReporter( TickType_t xPeriod,
+                                     UBaseType_t uxPriority )
+{
+    return xTaskCreate( prvReporterTask, "QStats", 1000, ( void * ) ( size_t ) xPeriod, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReporterTask( void * pvParameters )
+{
+    const TickType_t xPeriod = ( TickType_t ) ( size_t ) pvParameters;
+    QueueStatsSnapshot_t xSnapshot;
+    BaseType_t xInUse;
+    UBaseType_t ux;
+    char cBuffer[ 200 ];
+
+    for( ; ; )
+    {
+        vTaskDelay( xPeriod );
+
+        vPrintString( "Queue         Length  HWM    Sends  Receives  Send fails  Recv fails  Send blocked (ms)  Recv blocked (ms)\r\n" );
+
+        for( ux = 0; ux < queuestatsMAX_QUEUES; ux++ )
+        {
+            taskENTER_CRITICAL();
+            {
+                xInUse = ( xEntries[ ux ].xQueue != NULL ) ? pdTRUE : pdFALSE;
+
+                if( xInUse != pdFALSE )
+                {
+                    prvFillSnapshot( &( xEntries[ ux ] ), &xSnapshot );
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xInUse == pdFALSE )
+            {
+                continue;
+            }
+
+            snprintf( cBuffer, sizeof( cBuffer ), "%-12s  %6lu  %3lu  %7lu  %8lu  %10lu  %10lu  %17lu  %17lu\r\n",
+                      xSnapshot.pcName,
+                      ( unsigned long ) xSnapshot.uxLength,
+                      ( unsigned long ) xSnapshot.uxHighWaterMark,
+                      ( unsigned long ) xSnapshot.ulSends,
+                      ( unsigned long ) xSnapshot.ulReceives,
+                      ( unsigned long ) xSnapshot.ulSendFailures,
+                      ( unsigned long ) xSnapshot.ulReceiveFailures,
+                      ( unsigned long ) ( xSnapshot.ullSendBlockedUs / 1000ULL ),
+                      ( unsigned long ) ( xSnapshot.ullReceiveBlockedUs / 1000ULL ) );
+            vPrintString( cBuffer );
+
+            vLatencyHistogramPrint( "Residency", xSnapshot.ulResidencyHistogram, queuestatsHISTOGRAM_BUCKETS );
+        }
+
+        vPrintString( "\r\n" );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static QueueStatsEntry_t * prvFindEntry( const void * pvQueue )
+{
+    UBaseType_t ux;
+
+    for( ux = 0; ux < queuestatsMAX_QUEUES; ux++ )
+    {
+        if( ( const void * ) xEntries[ ux ].xQueue == pvQueue )
+        {
+            return &( xEntries[ ux ] );
+        }
+    }
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvEndBlocking( uint32_t ulNow )
+{
+    void * pvStartTime;
+    uint32_t ulBlockedUs = 0;
+
+    /* Queues can be used before the first task is created, in which case there
+     * is no thread local storage to check. */
+    if( xTaskGetCurrentTaskHandle() != NULL )
+    {
+        pvStartTime = pvTaskGetThreadLocalStoragePointer( NULL, queuestatsTLS_INDEX );
+
+        if( pvStartTime != NULL )
+        {
+            ulBlockedUs = ulNow - ( uint32_t ) ( uintptr_t ) pvStartTime;
+            vTaskSetThreadLocalStoragePointer( NULL, queuestatsTLS_INDEX, NULL );
+        }
+    }
+
+    return ulBlockedUs;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordSend( QueueStatsEntry_t * pxEntry,
+                           uint32_t ulNow )
+{
+    pxEntry->ulSends++;
+
+    if( pxEntry->uxMessagesWaiting < pxEntry->uxLength )
+    {
+        pxEntry->pulSendTimes[ pxEntry->uxHead ] = ulNow;
+        pxEntry->uxHead = ( pxEntry->uxHead + 1 ) % pxEntry->uxLength;
+        pxEntry->uxMessagesWaiting++;
+
+        if( pxEntry->uxMessagesWaiting > pxEntry->uxHighWaterMark )
+        {
+            pxEntry->uxHighWaterMark = pxEntry->uxMessagesWaiting;
+        }
+    }
+    else
+    {
+        /* Only xQueueOverwrite() can send to a full queue.  It replaces the
+         * most recently sent item. */
+        pxEntry->pulSendTimes[ ( pxEntry->uxHead + pxEntry->uxLength - 1 ) % pxEntry->uxLength ] = ulNow;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordReceive( QueueStatsEntry_t * pxEntry,
+                              uint32_t ulNow )
+{
+    UBaseType_t uxTail;
+    uint32_t ulResidencyUs;
+
+    pxEntry->ulReceives++;
+
+    if( pxEntry->uxMessagesWaiting > 0 )
+    {
+        uxTail = ( pxEntry->uxHead + pxEntry->uxLength - pxEntry->uxMessagesWaiting ) % pxEntry->uxLength;
+        ulResidencyUs = ulNow - pxEntry->pulSendTimes[ uxTail ];
+        pxEntry->uxMessagesWaiting--;
+        vLatencyHistogramAdd( pxEntry->ulResidencyHistogram, queuestatsHISTOGRAM_BUCKETS, ulResidencyUs );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvFillSnapshot( const QueueStatsEntry_t * pxEntry,
+                             QueueStatsSnapshot_t * pxSnapshot )
+{
+    pxSnapshot->pcName = pxEntry->pcName;
+    pxSnapshot->uxLength = pxEntry->uxLength;
+    pxSnapshot->uxMessagesWaiting = pxEntry->uxMessagesWaiting;
+    pxSnapshot->uxHighWaterMark = pxEntry->uxHighWaterMark;
+    pxSnapshot->ulSends = pxEntry->ulSends;
+    pxSnapshot->ulReceives = pxEntry->ulReceives;
+    pxSnapshot->ulSendFailures = pxEntry->ulSendFailures;
+    pxSnapshot->ulReceiveFailures = pxEntry->ulReceiveFailures;
+    pxSnapshot->ullSendBlockedUs = pxEntry->ullSendBlockedUs;
+    pxSnapshot->ullReceiveBlockedUs = pxEntry->ullReceiveBlockedUs;
+    memcpy( pxSnapshot->ulResidencyHistogram, pxEntry->ulResidencyHistogram, sizeof( pxSnapshot->ulResidencyHistogram ) );
+}
+/*-----------------------------------------------------------*/
+
+void vQueueStatsSend( void * pvQueue )
+{
+    uint32_t ulNow = ulBenchmarkTimerGetMicroseconds();
+    uint32_t ulBlockedUs = prvEndBlocking( ulNow );
+    QueueStatsEntry_t * pxEntry;
+
+    taskENTER_CRITICAL();
+    {
+        pxEntry = prvFindEntry( pvQueue );
+
+        if( pxEntry != NULL )
+        {
+            prvRecordSend( pxEntry, ulNow );
+            pxEntry->ullSendBlockedUs += ulBlockedUs;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vQueueStatsSendFailed( void * pvQueue )
+{
+    uint32_t ulBlockedUs = prvEndBlocking( ulBenchmarkTimerGetMicroseconds() );
+    QueueStatsEntry_t * pxEntry;
+
+    taskENTER_CRITICAL();
+    {
+        pxEntry = prvFindEntry( pvQueue );
+
+        if( pxEntry != NULL )
+        {
+            pxEntry->ulSendFailures++;
+            pxEntry->ullSendBlockedUs += ulBlockedUs;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vQueueStatsSendFromISR( void * pvQueue )
+{
+    QueueStatsEntry_t * pxEntry;
+    UBaseType_t uxSavedInterruptStatus;
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        pxEntry = prvFindEntry( pvQueue );
+
+        if( pxEntry != NULL )
+        {
+            prvRecordSend( pxEntry, ulBenchmarkTimerGetMicroseconds() );
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vQueueStatsSendFailedFromISR( void * pvQueue )
+{
+    QueueStatsEntry_t * pxEntry;
+    UBaseType_t uxSavedInterruptStatus;
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        pxEntry = prvFindEntry( pvQueue );
+
+        if( pxEntry != NULL )
+        {
+            pxEntry->ulSendFailures++;
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vQueueStatsReceive( void * pvQueue )
+{
+    uint32_t ulNow = ulBenchmarkTimerGetMicroseconds();
+    uint32_t ulBlockedUs = prvEndBlocking( ulNow );
+    QueueStatsEntry_t * pxEntry;
+
+    taskENTER_CRITICAL();
+    {
+        pxEntry = prvFindEntry( pvQueue );
+
+        if( pxEntry != NULL )
+        {
+            prvRecordReceive( pxEntry, ulNow );
+            pxEntry->ullReceiveBlockedUs += ulBlockedUs;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vQueueStatsReceiveFailed( void * pvQueue )
+{
+    uint32_t ulBlockedUs = prvEndBlocking( ulBenchmarkTimerGetMicroseconds() );
+    QueueStatsEntry_t * pxEntry;
+
+    taskENTER_CRITICAL();
+    {
+        pxEntry = prvFindEntry( pvQueue );
+
+        if( pxEntry != NULL )
+        {
+            pxEntry->ulReceiveFailures++;
+            pxEntry->ullReceiveBlockedUs += ulBlockedUs;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vQueueStatsReceiveFromISR( void * pvQueue )
+{
+    QueueStatsEntry_t * pxEntry;
+    UBaseType_t uxSavedInterruptStatus;
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        pxEntry = prvFindEntry( pvQueue );
+
+        if( pxEntry != NULL )
+        {
+            prvRecordReceive( pxEntry, ulBenchmarkTimerGetMicroseconds() );
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vQueueStatsReceiveFailedFromISR( void * pvQueue )
+{
+    QueueStatsEntry_t * pxEntry;
+    UBaseType_t uxSavedInterruptStatus;
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        pxEntry = prvFindEntry( pvQueue );
+
+        if( pxEntry != NULL )
+        {
+            pxEntry->ulReceiveFailures++;
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vQueueStatsBlocking( void )
+{
+    /* A task can block more than once within one API call, in which case the
+     * time it first blocked is kept.  The time is made odd so it is never
+     * mistaken for NULL. */
+    if( pvTaskGetThreadLocalStoragePointer( NULL, queuestatsTLS_INDEX ) == NULL )
+    {
+        vTaskSetThreadLocalStoragePointer( NULL, queuestatsTLS_INDEX, ( void * ) ( uintptr_t ) ( ulBenchmarkTimerGetMicroseconds() | 1UL ) );
+    }
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,148 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef QUEUE_STATS_H
+#define QUEUE_STATS_H
+
+/*
+ * Queue occupancy, blocking time and throughput instrumentation.
+ *
+ * Choosing the length of a queue is usually guesswork.  This module records,
+ * for each queue registered with it, the information needed to make that
+ * choice from measurements instead:  the most items the queue has ever held,
+ * the number of items sent and received, the number of sends and receives that
+ * failed because the queue was full or empty, the total time tasks spent
+ * blocked waiting to send to and receive from the queue, and a histogram of the
+ * time items spent in the queue.  Queues are identified by the name they are
+ * given in the queue registry (configQUEUE_REGISTRY_SIZE), so the statistics
+ * can be read by name and are printed with the name by the reporter task.
+ *
+ * The statistics are gathered by the queue trace macros, so the code that uses
+ * the queues does not change.  Only queues passed to xQueueStatsRegister() are
+ * instrumented, but the trace macros execute on every queue operation, so
+ * instrumentation should be removed from production builds once the queues are
+ * sized.  Semaphores and mutexes are queues too, and can be registered.
+ *
+ * Blocking time is measured from the point the task first blocks within an API
+ * call to the point the call returns, so includes any time the task spent in the
+ * Ready state after it was unblocked.  The start time is held in a thread local
+ * storage pointer of the blocking task.  Residency time assumes items leave the
+ * queue in the order they were sent, so is approximate for items sent to the
+ * front of a queue.  Peeks are not counted, and queue sets cannot be registered
+ * because items are added to a set without traceQUEUE_SEND() being called.
+ *
+ * FreeRTOSConfig.h must contain:
+ *
+ *  #define configNUM_THREAD_LOCAL_STORAGE_POINTERS  ( queuestatsTLS_INDEX + 1 )
+ *  #define traceQUEUE_SEND( pxQueue )                     vQueueStatsSend( pxQueue )
+ *  #define traceQUEUE_SEND_FAILED( pxQueue )              vQueueStatsSendFailed( pxQueue )
+ *  #define traceQUEUE_SEND_FROM_ISR( pxQueue )            vQueueStatsSendFromISR( pxQueue )
+ *  #define traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue )     vQueueStatsSendFailedFromISR( pxQueue )
+ *  #define traceQUEUE_RECEIVE( pxQueue )                  vQueueStatsReceive( pxQueue )
+ *  #define traceQUEUE_RECEIVE_FAILED( pxQueue )           vQueueStatsReceiveFailed( pxQueue )
+ *  #define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )         vQueueStatsReceiveFromISR( pxQueue )
+ *  #define traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue )  vQueueStatsReceiveFailedFromISR( pxQueue )
+ *  #define traceBLOCKING_ON_QUEUE_SEND( pxQueue )         vQueueStatsBlocking()
+ *  #define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )      vQueueStatsBlocking()
+ *
+ * Times are measured with the benchmark timer, so vBenchmarkTimerInit() must be
+ * called before any queue is used.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "queue.h"
+
+/* The maximum number of queues that can be registered at once.  Can be
+ * overridden in FreeRTOSConfig.h. */
+#ifndef queuestatsMAX_QUEUES
+    #define queuestatsMAX_QUEUES          configQUEUE_REGISTRY_SIZE
+#endif
+
+/* The thread local storage pointer used to hold the time at which a task
+ * started to block on a queue.  Can be overridden in FreeRTOSConfig.h. */
+#ifndef queuestatsTLS_INDEX
+    #define queuestatsTLS_INDEX           0
+#endif
+
+/* The number of buckets in the residency histogram.  Bucket 0 counts items that
+ * spent less than 10us in the queue, and each subsequent bucket has an upper
+ * bound ten times that of the one before, apart from the last bucket, which
+ * counts everything else.  The default of 7 therefore makes the last bucket
+ * count items that spent 1 second or more in the queue. */
+#ifndef queuestatsHISTOGRAM_BUCKETS
+    #define queuestatsHISTOGRAM_BUCKETS   7
+#endif
+
+/* The statistics of one queue, as returned by xQueueStatsGetSnapshot(). */
+typedef struct QueueStatsSnapshot
+{
+    const char * pcName;
+    UBaseType_t uxLength;
+    UBaseType_t uxMessagesWaiting;
+    UBaseType_t uxHighWaterMark;     /* The most items the queue has held at once. */
+    uint32_t ulSends;
+    uint32_t ulReceives;
+    uint32_t ulSendFailures;         /* Sends that returned errQUEUE_FULL. */
+    uint32_t ulReceiveFailures;      /* Receives that returned errQUEUE_EMPTY. */
+    uint64_t ullSendBlockedUs;       /* Total time tasks spent blocked waiting to send. */
+    uint64_t ullReceiveBlockedUs;    /* Total time tasks spent blocked waiting to receive. */
+    uint32_t ulResidencyHistogram[ queuestatsHISTOGRAM_BUCKETS ];
+} QueueStatsSnapshot_t;
+
+/*
+ * Add xQueue to the queue registry under the name pcName, and start gathering
+ * its statistics.  pcName is not copied, so must remain valid for as long as the
+ * queue is registered.  Items already in the queue are treated as having been
+ * sent when the queue was registered.  Returns pdFAIL if queuestatsMAX_QUEUES
+ * queues are already registered or there was insufficient heap memory.
+ */
+BaseType_t xQueueStatsRegister( QueueHandle_t xQueue,
+                                const char * pcName );
+
+/*
+ * Stop gathering statistics for xQueue and remove it from the queue registry.
+ * Must be called before a registered queue is deleted.
+ */
+void vQueueStatsUnregister( QueueHandle_t xQueue );
+
+/*
+ * Copy out the statistics of the queue registered under the name pcName.
+ * Returns pdFAIL if no such queue is registered.
+ */
+BaseType_t xQueueStatsGetSnapshot( const char * pcName,
+                                   QueueStatsSnapshot_t * pxSnapshot );
+
+/*
+ * Create a task, at priority uxPriority, that prints the statistics of every
+ * registered queue once every xPeriod ticks.
+ */
+BaseType_t xQueueStatsStartReporter( TickType_t xPeriod,
+                                     UBaseType_t uxPriority );
+
+/*
+ * Called from the trace macros listed above.  Must not be called from anywhere
+ * else.
+ */
+void vQueueStatsSend( void * pvQueue );
+void vQueueStatsSendFailed( void * pvQueue );
+void vQueueStatsSendFromISR( void * pvQueue );
+void vQueueStatsSendFailedFromISR( void * pvQueue );
+void vQueueStatsReceive( void * pvQueue );
+void vQueueStatsReceiveFailed( void * pvQueue );
+void vQueueStatsReceiveFromISR( void * pvQueue );
+void vQueueStatsReceiveFailedFromISR( void * pvQueue );
+void vQueueStatsBlocking( void );
+
+#endif /* QUEUE_STATS_H */
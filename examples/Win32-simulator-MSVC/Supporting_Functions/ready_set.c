@@ -0,0 +1,238 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/*
+ * Ready set, an alternative to queue sets.  See ready_set.h for a
+ * description.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "ready_set.h"
+
+/* The number of bits in each bitmap word. */
+#define readysetBITS_PER_WORD    32
+
+typedef struct ReadySet
+{
+    UBaseType_t uxNumMembers;
+    TaskHandle_t xSelectingTask;        /* The task waiting in xReadySetSelect(), if any. */
+    uint32_t ulSummary;                 /* Bit n is set if ulReadyBits[ n ] is not zero. */
+    uint32_t * pulReadyBits;            /* Bit m % 32 of word m / 32 is set if member m has a non-zero count. */
+    UBaseType_t * puxPendingCounts;     /* The number of unselected signals for each member. */
+} ReadySet_t;
+
+/* Record a signal.  Must be called from within a critical section.  Returns
+ * the task to notify, if any. */
+static TaskHandle_t prvSignal( ReadySet_t * pxSet,
+                               UBaseType_t uxMember );
+
+/* Return the index of the least significant set bit in a non-zero word. */
+static UBaseType_t prvLowestSetBit( uint32_t ulWord );
+
+/* The number of bitmap words needed for uxNumMembers members. */
+#define readysetNUM_WORDS( uxNumMembers )    ( ( ( uxNumMembers ) + readysetBITS_PER_WORD - 1 ) / readysetBITS_PER_WORD )
+
+/*-----------------------------------------------------------*/
+
+size_t xReadySetGetRequiredSize( UBaseType_t uxNumMembers )
+{
+    return sizeof( ReadySet_t ) +
+           ( readysetNUM_WORDS( uxNumMembers ) * sizeof( uint32_t ) ) +
+           ( uxNumMembers * sizeof( UBaseType_t ) );
+}
+/*-----------------------------------------------------------*/
+
+ReadySetHandle_t xReadySetCreate( UBaseType_t uxNumMembers )
+{
+    ReadySet_t * pxSet;
+    UBaseType_t ux;
+
+    configASSERT( ( uxNumMembers > 0 ) && ( uxNumMembers <= readysetMAX_MEMBERS ) );
+
+    /* The structure, bitmap and counts are allocated together.  The bitmap
+     * follows the structure so is correctly aligned for uint32_t. */
+    pxSet = ( ReadySet_t * ) pvPortMalloc( xReadySetGetRequiredSize( uxNumMembers ) );
+
+    if( pxSet != NULL )
+    {
+        pxSet->uxNumMembers = uxNumMembers;
+        pxSet->xSelectingTask = NULL;
+        pxSet->ulSummary = 0;
+        pxSet->pulReadyBits = ( uint32_t * ) ( pxSet + 1 );
+        pxSet->puxPendingCounts = ( UBaseType_t * ) ( pxSet->pulReadyBits + readysetNUM_WORDS( uxNumMembers ) );
+
+        for( ux = 0; ux < readysetNUM_WORDS( uxNumMembers ); ux++ )
+        {
+            pxSet->pulReadyBits[ ux ] = 0;
+        }
+
+        for( ux = 0; ux < uxNumMembers; ux++ )
+        {
+            pxSet->puxPendingCounts[ ux ] = 0;
+        }
+    }
+
+    return pxSet;
+}
+/*-----------------------------------------------------------*/
+
+void vReadySetDelete( ReadySetHandle_t xSet )
+{
+    vPortFree( xSet );
+}
+/*-----------------------------------------------------------*/
+
+void vReadySetSignal( ReadySetHandle_t xSet,
+                      UBaseType_t uxMember )
+{
+    TaskHandle_t xTaskToNotify;
+
+    taskENTER_CRITICAL();
+    {
+        xTaskToNotify = prvSignal( xSet, uxMember );
+    }
+    taskEXIT_CRITICAL();
+
+    if( xTaskToNotify != NULL )
+    {
+        ( void ) xTaskNotifyGive( xTaskToNotify );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vReadySetSignalFromISR( ReadySetHandle_t xSet,
+                             UBaseType_t uxMember,
+                             BaseType_t * pxHigherPriorityTaskWoken )
+{
+    TaskHandle_t xTaskToNotify;
+    UBaseType_t uxSavedInterruptStatus;
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        xTaskToNotify = prvSignal( xSet, uxMember );
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    if( xTaskToNotify != NULL )
+    {
+        vTaskNotifyGiveFromISR( xTaskToNotify, pxHigherPriorityTaskWoken );
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xReadySetSelect( ReadySetHandle_t xSet,
+                            UBaseType_t * puxMember,
+                            TickType_t xTicksToWait )
+{
+    ReadySet_t * pxSet = xSet;
+    BaseType_t xReturn = pdFAIL;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxWord, uxMember;
+
+    vTaskSetTimeOutState( &xTimeOut );
+
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            if( pxSet->ulSummary != 0 )
+            {
+                /* Find the lowest numbered member that has been signalled. */
+                uxWord = prvLowestSetBit( pxSet->ulSummary );
+                uxMember = ( uxWord * readysetBITS_PER_WORD ) + prvLowestSetBit( pxSet->pulReadyBits[ uxWord ] );
+
+                pxSet->puxPendingCounts[ uxMember ]--;
+
+                if( pxSet->puxPendingCounts[ uxMember ] == 0 )
+                {
+                    pxSet->pulReadyBits[ uxWord ] &= ~( 1UL << ( uxMember % readysetBITS_PER_WORD ) );
+
+                    if( pxSet->pulReadyBits[ uxWord ] == 0 )
+                    {
+                        pxSet->ulSummary &= ~( 1UL << uxWord );
+                    }
+                }
+
+                pxSet->xSelectingTask = NULL;
+                *puxMember = uxMember;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                /* Ask to be notified by the next signal.  Setting this inside
+                 * the critical section means a signal cannot be missed between
+                 * checking the bitmap and blocking. */
+                pxSet->xSelectingTask = xTaskGetCurrentTaskHandle();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( ( xReturn == pdPASS ) || ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE ) )
+        {
+            break;
+        }
+
+        ( void ) ulTaskNotifyTake( pdTRUE, xTicksToWait );
+    }
+
+    pxSet->xSelectingTask = NULL;
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t prvSignal( ReadySet_t * pxSet,
+                               UBaseType_t uxMember )
+{
+    TaskHandle_t xTaskToNotify;
+
+    configASSERT( uxMember < pxSet->uxNumMembers );
+
+    pxSet->puxPendingCounts[ uxMember ]++;
+    pxSet->pulReadyBits[ uxMember / readysetBITS_PER_WORD ] |= ( 1UL << ( uxMember % readysetBITS_PER_WORD ) );
+    pxSet->ulSummary |= ( 1UL << ( uxMember / readysetBITS_PER_WORD ) );
+
+    /* Only notify the selecting task once, however many signals arrive before
+     * it runs. */
+    xTaskToNotify = pxSet->xSelectingTask;
+    pxSet->xSelectingTask = NULL;
+
+    return xTaskToNotify;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvLowestSetBit( uint32_t ulWord )
+{
+    /* Isolating the lowest set bit then multiplying by a de Bruijn constant
+     * leaves a unique pattern in the top five bits for each bit position. */
+    static const uint8_t ucBitPositions[ 32 ] =
+    {
+        0,  1,  28, 2,  29, 14, 24, 3,  30, 22, 20, 15, 25, 17, 4,  8,
+        31, 27, 13, 23, 21, 19, 16, 7,  26, 12, 18, 6,  11, 5,  10, 9
+    };
+
+    uint32_t ulLowestBit, ulHash;
+
+    configASSERT( ulWord != 0 );
+
+    ulLowestBit = ulWord & ( ( ~ulWord ) + 1U );
+    ulHash = ( uint32_t ) ( ulLowestBit * 0x077CB531UL );
+
+    return ( UBaseType_t ) ucBitPositions[ ulHash >> 27 ];
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,100 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef READY_SET_H
+#define READY_SET_H
+
+/*
+ * An alternative to queue sets for blocking on many queues and semaphores.
+ *
+ * A queue set is itself a queue, which holds the handle of a member every time
+ * an item is sent to that member.  It must therefore be created with a length
+ * equal to the sum of the lengths of all its members, as described in section
+ * 5.6, so its size grows with both the number of members and their lengths.
+ *
+ * A ready set instead records, for each member, the number of items sent to
+ * that member that have not yet been selected, and keeps a two level bitmap of
+ * the members that have a non-zero count.  Its size only depends on the number
+ * of members.  Selecting a member finds the lowest numbered member that is
+ * ready using two find-first-set operations, so takes the same time however
+ * many members there are - members should therefore be numbered in order of
+ * importance.
+ *
+ * Members are identified by number, from 0 to one less than the number of
+ * members the set was created with, rather than by handle.  The kernel does not
+ * know about ready sets, so the task or interrupt that sends to a member must
+ * call vReadySetSignal() or vReadySetSignalFromISR() after each successful send
+ * or give, as shown below.  Only one task can select from a ready set.
+ *
+ *     if( xQueueSend( xQueues[ uxMember ], &xItem, 0 ) == pdPASS )
+ *     {
+ *         vReadySetSignal( xReadySet, uxMember );
+ *     }
+ *
+ * Just as for a queue set, the selecting task must then receive exactly one
+ * item from the member returned by xReadySetSelect().
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The largest number of members a ready set can have. */
+#define readysetMAX_MEMBERS    1024
+
+typedef struct ReadySet * ReadySetHandle_t;
+
+/*
+ * Create a ready set that has uxNumMembers members, numbered from 0.  Returns
+ * NULL if there was insufficient heap memory.
+ */
+ReadySetHandle_t xReadySetCreate( UBaseType_t uxNumMembers );
+
+/*
+ * Delete a ready set.  Any task that selects from the set must have been
+ * deleted, or must no longer use the set, first.
+ */
+void vReadySetDelete( ReadySetHandle_t xSet );
+
+/*
+ * Return the number of bytes of heap used by a ready set with uxNumMembers
+ * members.
+ */
+size_t xReadySetGetRequiredSize( UBaseType_t uxNumMembers );
+
+/*
+ * Record that an item has been sent to, or a semaphore has been given to,
+ * member uxMember, and unblock the selecting task if it is waiting.
+ */
+void vReadySetSignal( ReadySetHandle_t xSet,
+                      UBaseType_t uxMember );
+
+/*
+ * A version of vReadySetSignal() that can be called from an interrupt service
+ * routine.
+ */
+void vReadySetSignalFromISR( ReadySetHandle_t xSet,
+                             UBaseType_t uxMember,
+                             BaseType_t * pxHigherPriorityTaskWoken );
+
+/*
+ * Wait for at most xTicksToWait ticks for a member to be signalled, then write
+ * the number of the lowest numbered signalled member to *puxMember.  Returns
+ * pdPASS if a member was selected, or pdFAIL if the block time expired.
+ */
+BaseType_t xReadySetSelect( ReadySetHandle_t xSet,
+                            UBaseType_t * puxMember,
+                            TickType_t xTicksToWait );
+
+#endif /* READY_SET_H */
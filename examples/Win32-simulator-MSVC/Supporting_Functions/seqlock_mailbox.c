@@ -0,0 +1,115 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/*
+ * Sequence lock mailbox.  See seqlock_mailbox.h for a description.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+
+/* Demo includes. */
+#include "seqlock_mailbox.h"
+
+typedef struct SeqlockMailbox
+{
+    /* Incremented each time an item is published.  The published item is in
+     * copy ( ulSequence & 1 ), and 0 means nothing has been published yet. */
+    volatile uint32_t ulSequence;
+    size_t xItemSize;
+    uint8_t * pucCopies[ 2 ];
+} SeqlockMailbox_t;
+
+/*-----------------------------------------------------------*/
+
+SeqlockMailboxHandle_t xSeqlockMailboxCreate( size_t xItemSize )
+{
+    SeqlockMailbox_t * pxMailbox;
+
+    configASSERT( xItemSize > 0 );
+
+    /* The structure and both copies are allocated together. */
+    pxMailbox = ( SeqlockMailbox_t * ) pvPortMalloc( sizeof( SeqlockMailbox_t ) + ( xItemSize * 2 ) );
+
+    if( pxMailbox != NULL )
+    {
+        pxMailbox->ulSequence = 0;
+        pxMailbox->xItemSize = xItemSize;
+        pxMailbox->pucCopies[ 0 ] = ( uint8_t * ) ( pxMailbox + 1 );
+        pxMailbox->pucCopies[ 1 ] = pxMailbox->pucCopies[ 0 ] + xItemSize;
+    }
+
+    return pxMailbox;
+}
+/*-----------------------------------------------------------*/
+
+void vSeqlockMailboxWrite( SeqlockMailboxHandle_t xMailbox,
+                           const void * pvItem )
+{
+    SeqlockMailbox_t * pxMailbox = xMailbox;
+    uint32_t ulNextSequence = pxMailbox->ulSequence + 1;
+
+    /* Write to the copy that is not published, then publish it.  The copy is
+     * complete before the sequence number changes. */
+    memcpy( pxMailbox->pucCopies[ ulNextSequence & 1 ], pvItem, pxMailbox->xItemSize );
+    portMEMORY_BARRIER();
+    pxMailbox->ulSequence = ulNextSequence;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSeqlockMailboxRead( SeqlockMailboxHandle_t xMailbox,
+                                void * pvBuffer,
+                                uint32_t * pulRetries )
+{
+    SeqlockMailbox_t * pxMailbox = xMailbox;
+    uint32_t ulSequence, ulRetries = 0;
+    BaseType_t xReturn = pdTRUE;
+
+    for( ; ; )
+    {
+        ulSequence = pxMailbox->ulSequence;
+
+        if( ulSequence == 0 )
+        {
+            xReturn = pdFALSE;
+            break;
+        }
+
+        portMEMORY_BARRIER();
+        memcpy( pvBuffer, pxMailbox->pucCopies[ ulSequence & 1 ], pxMailbox->xItemSize );
+        portMEMORY_BARRIER();
+
+        /* If the sequence number has not changed then the writer did not start
+         * writing to the copy that was read while it was being read. */
+        if( pxMailbox->ulSequence == ulSequence )
+        {
+            break;
+        }
+
+        ulRetries++;
+    }
+
+    /* The retries are counted locally and only written to the caller's
+     * counter, as other readers may be reading at the same time. */
+    if( pulRetries != NULL )
+    {
+        *pulRetries += ulRetries;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,73 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef SEQLOCK_MAILBOX_H
+#define SEQLOCK_MAILBOX_H
+
+/*
+ * A mailbox that many tasks can read without locking.
+ *
+ * Section 5.7 of the book implements a mailbox as a queue of length one that
+ * is written with xQueueOverwrite() and read with xQueuePeek().  Each read then
+ * copies the data inside a critical section, so readers are serialised with
+ * each other and with interrupts.
+ *
+ * A sequence lock mailbox holds two copies of the data and a sequence number.
+ * The writer writes to the copy that is not currently published, then
+ * publishes it with a single increment of the sequence number.  A reader notes
+ * the sequence number, copies the published data, then checks the sequence
+ * number again - if it changed, the writer may have started overwriting the
+ * copy being read, so the reader tries again.  Readers therefore never disable
+ * interrupts or block each other, and the writer is never held up by readers.
+ * A reader can only be delayed if the writer publishes twice while it is
+ * copying, which requires the writer to write much more often than the reader
+ * is able to run.
+ *
+ * There can only be one writer at a time, which can be a task or an interrupt.
+ * Any number of tasks and interrupts can read.  As with spsc_ring.c, the
+ * readers and writer must execute on the same core, and portMEMORY_BARRIER()
+ * stops the compiler reordering accesses to the mailbox.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+
+typedef struct SeqlockMailbox * SeqlockMailboxHandle_t;
+
+/*
+ * Create a mailbox that holds an item of xItemSize bytes.  Returns NULL if
+ * there was insufficient heap memory.
+ */
+SeqlockMailboxHandle_t xSeqlockMailboxCreate( size_t xItemSize );
+
+/*
+ * Overwrite the item in the mailbox.  Never blocks.  Must not be called by more
+ * than one task or interrupt at a time.
+ */
+void vSeqlockMailboxWrite( SeqlockMailboxHandle_t xMailbox,
+                           const void * pvItem );
+
+/*
+ * Copy the item out of the mailbox into the buffer pointed to by pvBuffer.
+ * Returns pdFALSE, without writing to the buffer, if nothing has been written
+ * to the mailbox yet, otherwise pdTRUE.  Never blocks.  If pulRetries is not
+ * NULL, the number of times the read was retried because the writer updated
+ * the mailbox while it was in progress is added to *pulRetries.  Readers share
+ * nothing but the mailbox, so each reader should count its own retries.
+ */
+BaseType_t xSeqlockMailboxRead( SeqlockMailboxHandle_t xMailbox,
+                                void * pvBuffer,
+                                uint32_t * pulRetries );
+
+#endif /* SEQLOCK_MAILBOX_H */
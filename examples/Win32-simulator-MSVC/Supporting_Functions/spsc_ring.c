@@ -0,0 +1,206 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/*
+ * Single producer, single consumer ring buffer.  See spsc_ring.h for a
+ * description.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "spsc_ring.h"
+
+typedef struct SpscRing
+{
+    uint8_t * pucStorage;
+    UBaseType_t uxIndexMask; /* The length of the ring minus one. */
+    UBaseType_t uxItemSize;
+
+    /* The head and tail count the items ever popped and pushed respectively,
+     * and are only reduced to an index into the storage when the storage is
+     * accessed, so the difference between them is always the number of items
+     * in the ring, even when they wrap.  Only the consumer writes uxHead and
+     * only the producer writes uxTail. */
+    volatile UBaseType_t uxHead;
+    volatile UBaseType_t uxTail;
+
+    /* Set by the consumer before it blocks, and cleared by whichever of the
+     * producer and consumer clears it first once an item is available. */
+    volatile BaseType_t xConsumerWaiting;
+    TaskHandle_t xConsumerTask;
+} SpscRing_t;
+
+/* Copy an item into the ring.  Returns pdTRUE if the consumer needs to be
+ * notified. */
+static BaseType_t prvPush( SpscRing_t * pxRing,
+                           const void * pvItem,
+                           BaseType_t * pxPushed );
+
+/*-----------------------------------------------------------*/
+
+SpscRingHandle_t xSpscRingCreate( UBaseType_t uxLength,
+                                  UBaseType_t uxItemSize )
+{
+    SpscRing_t * pxRing;
+
+    configASSERT( uxLength > 0 );
+    configASSERT( ( uxLength & ( uxLength - 1 ) ) == 0 );
+    configASSERT( uxItemSize > 0 );
+
+    /* The structure and the storage are allocated together. */
+    pxRing = ( SpscRing_t * ) pvPortMalloc( sizeof( SpscRing_t ) + ( ( size_t ) uxLength * uxItemSize ) );
+
+    if( pxRing != NULL )
+    {
+        pxRing->pucStorage = ( uint8_t * ) ( pxRing + 1 );
+        pxRing->uxIndexMask = uxLength - 1;
+        pxRing->uxItemSize = uxItemSize;
+        pxRing->uxHead = 0;
+        pxRing->uxTail = 0;
+        pxRing->xConsumerWaiting = pdFALSE;
+        pxRing->xConsumerTask = NULL;
+    }
+
+    return pxRing;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscRingPush( SpscRingHandle_t xRing,
+                          const void * pvItem )
+{
+    BaseType_t xPushed;
+
+    if( prvPush( xRing, pvItem, &xPushed ) != pdFALSE )
+    {
+        ( void ) xTaskNotifyGiveIndexed( xRing->xConsumerTask, spscringNOTIFICATION_INDEX );
+    }
+
+    return xPushed;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscRingPushFromISR( SpscRingHandle_t xRing,
+                                 const void * pvItem,
+                                 BaseType_t * pxHigherPriorityTaskWoken )
+{
+    BaseType_t xPushed;
+
+    if( prvPush( xRing, pvItem, &xPushed ) != pdFALSE )
+    {
+        vTaskNotifyGiveIndexedFromISR( xRing->xConsumerTask, spscringNOTIFICATION_INDEX, pxHigherPriorityTaskWoken );
+    }
+
+    return xPushed;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscRingPop( SpscRingHandle_t xRing,
+                         void * pvItem )
+{
+    SpscRing_t * pxRing = xRing;
+    UBaseType_t uxHead = pxRing->uxHead;
+    BaseType_t xReturn = errQUEUE_EMPTY;
+
+    if( pxRing->uxTail != uxHead )
+    {
+        /* Read the tail before the item, and finish reading the item before
+         * the producer is told the slot is free. */
+        portMEMORY_BARRIER();
+        memcpy( pvItem, &( pxRing->pucStorage[ ( uxHead & pxRing->uxIndexMask ) * pxRing->uxItemSize ] ), pxRing->uxItemSize );
+        portMEMORY_BARRIER();
+        pxRing->uxHead = uxHead + 1;
+        xReturn = pdPASS;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscRingReceive( SpscRingHandle_t xRing,
+                             void * pvItem,
+                             TickType_t xTicksToWait )
+{
+    SpscRing_t * pxRing = xRing;
+    BaseType_t xReturn;
+    TimeOut_t xTimeOut;
+
+    pxRing->xConsumerTask = xTaskGetCurrentTaskHandle();
+    vTaskSetTimeOutState( &xTimeOut );
+
+    for( ; ; )
+    {
+        xReturn = xSpscRingPop( xRing, pvItem );
+
+        if( ( xReturn == pdPASS ) || ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE ) )
+        {
+            break;
+        }
+
+        /* Tell the producer to send a notification, then check the ring again
+         * in case an item was pushed before the producer saw the flag. */
+        pxRing->xConsumerWaiting = pdTRUE;
+        portMEMORY_BARRIER();
+
+        if( pxRing->uxTail == pxRing->uxHead )
+        {
+            ( void ) ulTaskNotifyTakeIndexed( spscringNOTIFICATION_INDEX, pdTRUE, xTicksToWait );
+        }
+
+        /* A notification may be left pending if the producer sent one after the
+         * ring was checked.  It only causes the next wait to end early, after
+         * which the ring is checked again. */
+        pxRing->xConsumerWaiting = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvPush( SpscRing_t * pxRing,
+                           const void * pvItem,
+                           BaseType_t * pxPushed )
+{
+    UBaseType_t uxTail = pxRing->uxTail;
+    BaseType_t xNotify = pdFALSE;
+
+    if( ( uxTail - pxRing->uxHead ) <= pxRing->uxIndexMask )
+    {
+        /* Finish writing the item before the consumer is told it is there. */
+        memcpy( &( pxRing->pucStorage[ ( uxTail & pxRing->uxIndexMask ) * pxRing->uxItemSize ] ), pvItem, pxRing->uxItemSize );
+        portMEMORY_BARRIER();
+        pxRing->uxTail = uxTail + 1;
+        portMEMORY_BARRIER();
+
+        if( pxRing->xConsumerWaiting != pdFALSE )
+        {
+            pxRing->xConsumerWaiting = pdFALSE;
+            xNotify = pdTRUE;
+        }
+
+        *pxPushed = pdPASS;
+    }
+    else
+    {
+        *pxPushed = errQUEUE_FULL;
+    }
+
+    return xNotify;
+}
+/*-----------------------------------------------------------*/
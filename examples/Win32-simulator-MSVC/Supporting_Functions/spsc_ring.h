@@ -0,0 +1,97 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+/*
+ * A ring buffer for passing fixed size items from exactly one producer to
+ * exactly one consumer.
+ *
+ * A queue allows any number of tasks and interrupts to send and receive, so
+ * every queue operation enters a critical section, and every send checks for
+ * tasks that need to be unblocked.  When there is exactly one producer, such as
+ * the interrupt in Example019, and exactly one consumer, the producer only ever
+ * writes the tail index and the consumer only ever writes the head index, so
+ * items can be pushed and popped without a critical section, in a bounded
+ * number of steps, however the two interleave.
+ *
+ * The consumer can be a task that blocks waiting for items to arrive, in which
+ * case it waits on a direct to task notification, and the producer only
+ * notifies it if it is actually waiting.  Alternatively the consumer can be an
+ * interrupt, which polls with xSpscRingPop().
+ *
+ * The ring relies on the producer and consumer executing on the same core, as
+ * they always do in a single core FreeRTOS application.  portMEMORY_BARRIER()
+ * is used to stop the compiler reordering accesses to the ring.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The index of the task notification used to unblock the consumer.  Can be
+ * overridden in FreeRTOSConfig.h if the consumer uses index 0 for another
+ * purpose. */
+#ifndef spscringNOTIFICATION_INDEX
+    #define spscringNOTIFICATION_INDEX    0
+#endif
+
+typedef struct SpscRing * SpscRingHandle_t;
+
+/*
+ * Create a ring that holds uxLength items of uxItemSize bytes.  uxLength must
+ * be a power of two.  Returns NULL if there was insufficient heap memory.
+ */
+SpscRingHandle_t xSpscRingCreate( UBaseType_t uxLength,
+                                  UBaseType_t uxItemSize );
+
+/*
+ * Copy an item into the ring, and unblock the consumer if it is waiting for
+ * an item.  Never blocks.  Returns pdPASS if the item was pushed, or
+ * errQUEUE_FULL if the ring was full.  Only the producer can call this
+ * function, and only from a task.
+ */
+BaseType_t xSpscRingPush( SpscRingHandle_t xRing,
+                          const void * pvItem );
+
+/*
+ * A version of xSpscRingPush() that can be called from an interrupt service
+ * routine.  *pxHigherPriorityTaskWoken is set to pdTRUE if unblocking the
+ * consumer means a context switch should be requested before the interrupt
+ * exits.
+ */
+BaseType_t xSpscRingPushFromISR( SpscRingHandle_t xRing,
+                                 const void * pvItem,
+                                 BaseType_t * pxHigherPriorityTaskWoken );
+
+/*
+ * Copy the oldest item out of the ring without blocking.  Returns pdPASS if an
+ * item was popped, or errQUEUE_EMPTY if the ring was empty.  Only the consumer
+ * can call this function, from either a task or an interrupt.
+ */
+BaseType_t xSpscRingPop( SpscRingHandle_t xRing,
+                         void * pvItem );
+
+/*
+ * Copy the oldest item out of the ring, waiting in the Blocked state for at
+ * most xTicksToWait ticks for an item to arrive if the ring is empty.  Returns
+ * pdPASS if an item was received, or errQUEUE_EMPTY if the block time expired
+ * first.  Only the consumer can call this function, and only from a task.
+ */
+BaseType_t xSpscRingReceive( SpscRingHandle_t xRing,
+                             void * pvItem,
+                             TickType_t xTicksToWait );
+
+#endif /* SPSC_RING_H */
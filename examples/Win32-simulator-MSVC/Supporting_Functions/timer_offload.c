@@ -0,0 +1,310 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/*
+ * Software timer callback offload to a pool of worker tasks.  See
+ * timer_offload.h for a description.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+
+/* Demo includes. */
+#include "timer_offload.h"
+
+#if ( configUSE_TIMERS == 0 )
+    #error timer_offload.c requires configUSE_TIMERS to be 1 in FreeRTOSConfig.h
+#endif
+
+typedef struct TimerOffloadPool
+{
+    QueueHandle_t xJobQueue; /* Holds pointers to the entries of the timers whose callbacks are to execute. */
+    TimerOffloadPoolStats_t xStats;
+} TimerOffloadPool_t;
+
+/* The state kept for each offloaded timer. */
+typedef struct TimerOffloadEntry
+{
+    TimerHandle_t xTimer; /* NULL if the entry is not in use. */
+    TimerCallbackFunction_t pxCallbackFunction;
+    TimerOffloadPool_t * pxPool;
+    BaseType_t xBusy;     /* pdTRUE while the callback is queued or executing, during which the entry cannot be reused. */
+    BaseType_t xReserved; /* pdTRUE while the timer is being created or its delete command is being sent, during which the entry cannot be reused. */
+} TimerOffloadEntry_t;
+
+/* The callback used by every offloaded timer, which executes in the timer
+ * service task and queues the timer's real callback to its pool. */
+static void prvDispatchCallback( TimerHandle_t xTimer );
+
+/* The worker tasks, which execute the queued callbacks. */
+static void prvWorkerTask( void * pvParameters );
+
+/* Return the entry for the timer xTimer, or NULL if the timer is not
+ * offloaded.  Must be called from a critical section. */
+static TimerOffloadEntry_t * prvFindEntry( TimerHandle_t xTimer );
+
+/*-----------------------------------------------------------*/
+
+static TimerOffloadEntry_t xEntries[ timeroffloadMAX_TIMERS ];
+
+/*-----------------------------------------------------------*/
+
+TimerOffloadPoolHandle_t xTimerOffloadCreatePool( const char * const pcName,
+                                                  UBaseType_t uxNumWorkers,
+                                                  UBaseType_t uxPriority,
+                                                  UBaseType_t uxQueueLength )
+{
+    TimerOffloadPool_t * pxPool;
+    UBaseType_t ux;
+
+    configASSERT( uxNumWorkers > 0 );
+    configASSERT( uxQueueLength > 0 );
+
+    pxPool = ( TimerOffloadPool_t * ) pvPortMalloc( sizeof( TimerOffloadPool_t ) );
+
+    if( pxPool != NULL )
+    {
+        pxPool->xStats.ulDispatched = 0;
+        pxPool->xStats.ulCompleted = 0;
+        pxPool->xStats.ulOverruns = 0;
+        pxPool->xStats.ulQueueFull = 0;
+        pxPool->xJobQueue = xQueueCreate( uxQueueLength, sizeof( TimerOffloadEntry_t * ) );
+
+        if( pxPool->xJobQueue == NULL )
+        {
+            vPortFree( pxPool );
+            pxPool = NULL;
+        }
+        else
+        {
+            /* A pool is never deleted, so the workers are not tracked. */
+            for( ux = 0; ux < uxNumWorkers; ux++ )
+            {
+                if( xTaskCreate( prvWorkerTask, pcName, timeroffloadWORKER_STACK_SIZE, pxPool, uxPriority, NULL ) != pdPASS )
+                {
+                    break;
+                }
+            }
+
+            configASSERT( ux > 0 );
+        }
+    }
+
+    return pxPool;
+}
+/*-----------------------------------------------------------*/
+
+TimerHandle_t xTimerOffloadCreate( const char * const pcTimerName,
+                                   const TickType_t xTimerPeriodInTicks,
+                                   const BaseType_t xAutoReload,
+                                   void * const pvTimerID,
+                                   TimerCallbackFunction_t pxCallbackFunction,
+                                   TimerOffloadPoolHandle_t xPool )
+{
+    TimerOffloadEntry_t * pxEntry = NULL;
+    TimerHandle_t xTimer = NULL;
+    UBaseType_t ux;
+
+    configASSERT( pxCallbackFunction != NULL );
+    configASSERT( xPool != NULL );
+
+    /* The entry is reserved before the timer is created, so there is never a
+     * timer that has to be deleted again because there was no free entry. */
+    taskENTER_CRITICAL();
+    {
+        for( ux = 0; ux < timeroffloadMAX_TIMERS; ux++ )
+        {
+            if( ( xEntries[ ux ].xTimer == NULL ) &&
+                ( xEntries[ ux ].xBusy == pdFALSE ) &&
+                ( xEntries[ ux ].xReserved == pdFALSE ) )
+            {
+                pxEntry = &( xEntries[ ux ] );
+                pxEntry->xReserved = pdTRUE;
+                break;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if( pxEntry != NULL )
+    {
+        pxEntry->pxCallbackFunction = pxCallbackFunction;
+        pxEntry->pxPool = xPool;
+
+        xTimer = xTimerCreate( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, prvDispatchCallback );
+
+        /* Setting the handle makes the entry visible to the dispatcher.  If the
+         * timer could not be created the handle is NULL, which frees the entry
+         * again. */
+        taskENTER_CRITICAL();
+        {
+            pxEntry->xTimer = xTimer;
+            pxEntry->xReserved = pdFALSE;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    return xTimer;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerOffloadDelete( TimerHandle_t xTimer,
+                                TickType_t xTicksToWait )
+{
+    TimerOffloadEntry_t * pxEntry;
+    BaseType_t xReturn;
+
+    /* The entry must stop referencing the timer before the delete command is
+     * sent, as the timer service task frees the timer as soon as it processes
+     * the command, which can be before this task runs again.  From now on the
+     * dispatcher ignores the timer's expiries, and a worker that receives a
+     * queued callback for the timer discards it. */
+    taskENTER_CRITICAL();
+    {
+        pxEntry = prvFindEntry( xTimer );
+        configASSERT( pxEntry != NULL );
+        pxEntry->xTimer = NULL;
+        pxEntry->xReserved = pdTRUE;
+    }
+    taskEXIT_CRITICAL();
+
+    xReturn = xTimerDelete( xTimer, xTicksToWait );
+
+    taskENTER_CRITICAL();
+    {
+        /* If the command could not be sent then the timer still exists, so
+         * is given back its entry and keeps working. */
+        if( xReturn != pdPASS )
+        {
+            pxEntry->xTimer = xTimer;
+        }
+
+        pxEntry->xReserved = pdFALSE;
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTimerOffloadGetPoolStats( TimerOffloadPoolHandle_t xPool,
+                                TimerOffloadPoolStats_t * pxStats )
+{
+    taskENTER_CRITICAL();
+    {
+        *pxStats = xPool->xStats;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvDispatchCallback( TimerHandle_t xTimer )
+{
+    TimerOffloadEntry_t * pxEntry;
+    BaseType_t xQueue = pdFALSE;
+
+    taskENTER_CRITICAL();
+    {
+        pxEntry = prvFindEntry( xTimer );
+
+        if( pxEntry != NULL )
+        {
+            if( pxEntry->xBusy != pdFALSE )
+            {
+                pxEntry->pxPool->xStats.ulOverruns++;
+            }
+            else
+            {
+                pxEntry->xBusy = pdTRUE;
+                xQueue = pdTRUE;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if( xQueue != pdFALSE )
+    {
+        /* Callbacks executing in the timer service task must not block, so the
+         * block time is 0. */
+        if( xQueueSendToBack( pxEntry->pxPool->xJobQueue, &pxEntry, 0 ) == pdPASS )
+        {
+            taskENTER_CRITICAL();
+            {
+                pxEntry->pxPool->xStats.ulDispatched++;
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            taskENTER_CRITICAL();
+            {
+                pxEntry->pxPool->xStats.ulQueueFull++;
+                pxEntry->xBusy = pdFALSE;
+            }
+            taskEXIT_CRITICAL();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void * pvParameters )
+{
+    TimerOffloadPool_t * pxPool = ( TimerOffloadPool_t * ) pvParameters;
+    TimerOffloadEntry_t * pxEntry;
+    TimerHandle_t xTimer;
+
+    for( ; ; )
+    {
+        xQueueReceive( pxPool->xJobQueue, &pxEntry, portMAX_DELAY );
+
+        taskENTER_CRITICAL();
+        {
+            xTimer = pxEntry->xTimer;
+        }
+        taskEXIT_CRITICAL();
+
+        if( xTimer != NULL )
+        {
+            pxEntry->pxCallbackFunction( xTimer );
+        }
+
+        /* The callback can be queued again once it has completed. */
+        taskENTER_CRITICAL();
+        {
+            pxEntry->xBusy = pdFALSE;
+            pxPool->xStats.ulCompleted++;
+        }
+        taskEXIT_CRITICAL();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static TimerOffloadEntry_t * prvFindEntry( TimerHandle_t xTimer )
+{
+    UBaseType_t ux;
+
+    for( ux = 0; ux < timeroffloadMAX_TIMERS; ux++ )
+    {
+        if( xEntries[ ux ].xTimer == xTimer )
+        {
+            return &( xEntries[ ux ] );
+        }
+    }
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,104 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef TIMER_OFFLOAD_H
+#define TIMER_OFFLOAD_H
+
+/*
+ * Software timer callback offload to a pool of worker tasks.
+ *
+ * Software timer callbacks execute one at a time in the context of the timer
+ * service task, so must be short and must not block:  a callback that takes a
+ * long time delays every other timer that expires while it executes.  A timer
+ * created with xTimerOffloadCreate() is an ordinary kernel timer, but its
+ * callback only sends the callback passed to xTimerOffloadCreate() to a pool of
+ * worker tasks, so the timer service task does no more than the bookkeeping.
+ * The callback then executes in the context of a worker, at the priority of the
+ * pool, and is free to take as long as it needs, or to block.
+ *
+ * Each pool has its own priority, number of workers and job queue, so work of
+ * different importance can be offloaded to different pools.  The callback of
+ * one timer never executes in more than one worker at once.  If a timer expires
+ * again before its callback has completed, the expiry is counted as an overrun
+ * and the callback is not queued again, so a callback that takes longer than its
+ * period executes as often as it can rather than building up a backlog.  An
+ * expiry is also lost, and counted, if the pool's job queue is full.
+ *
+ * Every other timer API function is used as normal, apart from xTimerDelete():
+ * an offloaded timer must be deleted with xTimerOffloadDelete(), and not while
+ * its callback is executing.  A callback that is still queued when its timer is
+ * deleted is discarded.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "timers.h"
+
+/* The maximum number of offloaded timers that can exist at once.  Can be
+ * overridden in FreeRTOSConfig.h. */
+#ifndef timeroffloadMAX_TIMERS
+    #define timeroffloadMAX_TIMERS          16
+#endif
+
+/* The stack size of each worker task.  Can be overridden in FreeRTOSConfig.h. */
+#ifndef timeroffloadWORKER_STACK_SIZE
+    #define timeroffloadWORKER_STACK_SIZE   1000
+#endif
+
+typedef struct TimerOffloadPool * TimerOffloadPoolHandle_t;
+
+/* The statistics of one pool, as returned by vTimerOffloadGetPoolStats(). */
+typedef struct TimerOffloadPoolStats
+{
+    uint32_t ulDispatched;   /* Expiries queued to the pool. */
+    uint32_t ulCompleted;    /* Callbacks that have completed. */
+    uint32_t ulOverruns;     /* Expiries that occurred while the timer's callback was still queued or executing. */
+    uint32_t ulQueueFull;    /* Expiries lost because the job queue was full. */
+} TimerOffloadPoolStats_t;
+
+/*
+ * Create a pool of uxNumWorkers worker tasks at priority uxPriority, with a job
+ * queue that can hold uxQueueLength callbacks.  pcName is used to name the
+ * worker tasks.  Returns NULL if there was insufficient heap memory.
+ */
+TimerOffloadPoolHandle_t xTimerOffloadCreatePool( const char * const pcName,
+                                                  UBaseType_t uxNumWorkers,
+                                                  UBaseType_t uxPriority,
+                                                  UBaseType_t uxQueueLength );
+
+/*
+ * Create a timer, as per xTimerCreate(), whose callback executes in a worker
+ * of xPool.  Returns NULL if timeroffloadMAX_TIMERS offloaded timers already
+ * exist or there was insufficient heap memory.
+ */
+TimerHandle_t xTimerOffloadCreate( const char * const pcTimerName,
+                                   const TickType_t xTimerPeriodInTicks,
+                                   const BaseType_t xAutoReload,
+                                   void * const pvTimerID,
+                                   TimerCallbackFunction_t pxCallbackFunction,
+                                   TimerOffloadPoolHandle_t xPool );
+
+/*
+ * Delete an offloaded timer, as per xTimerDelete(), and free its entry.
+ */
+BaseType_t xTimerOffloadDelete( TimerHandle_t xTimer,
+                                TickType_t xTicksToWait );
+
+/*
+ * Copy out the statistics of xPool.
+ */
+void vTimerOffloadGetPoolStats( TimerOffloadPoolHandle_t xPool,
+                                TimerOffloadPoolStats_t * pxStats );
+
+#endif /* TIMER_OFFLOAD_H */
@@ -0,0 +1,551 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/*
+ * Software timer dispatch latency instrumentation.  See timer_stats.h for a
+ * description.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/* Demo includes. */
+#include "supporting_functions.h"
+#include "benchmark_timer.h"
+#include "latency.h"
+#include "timer_stats.h"
+
+#if ( configUSE_TIMERS == 0 )
+    #error timer_stats.c requires configUSE_TIMERS to be 1 in FreeRTOSConfig.h
+#endif
+
+#define timerstatsNUM_METRICS    3
+
+/* The state kept for each instrumented timer. */
+typedef struct TimerStatsEntry
+{
+    TimerHandle_t xTimer;  /* NULL if the entry is not in use. */
+    BaseType_t xReserved;  /* pdTRUE while the timer for the entry is being created. */
+    const char * pcName;
+    TimerCallbackFunction_t pxCallbackFunction;
+    BaseType_t xAutoReload;
+
+    /* The tick on which the timer is next due to expire, valid while
+     * xExpiryKnown is pdTRUE. */
+    TickType_t xNextExpiry;
+    BaseType_t xExpiryKnown;
+
+    /* The time each command sent to the timer that has not yet been received
+     * was sent, in the order the commands were sent, and the number of
+     * commands received before the send was recorded. */
+    uint32_t ulSendTimes[ configTIMER_QUEUE_LENGTH ];
+    UBaseType_t uxHead;
+    UBaseType_t uxCommandsWaiting;
+    UBaseType_t uxEarlyReceives;
+
+    uint32_t ulExpiries;
+    uint32_t ulCommands;
+    uint32_t ulMaxUs[ timerstatsNUM_METRICS ];
+    uint64_t ullTotalUs[ timerstatsNUM_METRICS ];
+    uint32_t ulHistogram[ timerstatsNUM_METRICS ][ timerstatsHISTOGRAM_BUCKETS ];
+} TimerStatsEntry_t;
+
+/* The callback used by every instrumented timer, which times the callback
+ * passed to xTimerStatsCreate(). */
+static void prvCallbackWrapper( TimerHandle_t xTimer );
+
+/* The task that periodically prints the statistics. */
+static void prvReporterTask( void * pvParameters );
+
+/* Return the entry for the timer pvTimer, or NULL if the timer is not
+ * instrumented.  Must be called from a critical section. */
+static TimerStatsEntry_t * prvFindEntry( const void * pvTimer );
+
+/* Add one time to the total, maximum and histogram of one of an entry's
+ * metrics.  Must be called from a critical section. */
+static void prvRecordTime( TimerStatsEntry_t * pxEntry,
+                           TimerStatsMetric_t eMetric,
+                           uint32_t ulTimeUs );
+
+/* Copy the statistics of an entry into a snapshot.  Must be called from a
+ * critical section. */
+static void prvFillSnapshot( const TimerStatsEntry_t * pxEntry,
+                             TimerStatsSnapshot_t * pxSnapshot );
+
+/*-----------------------------------------------------------*/
+
+static TimerStatsEntry_t xEntries[ timerstatsMAX_TIMERS ];
+
+/*-----------------------------------------------------------*/
+
+TimerHandle_t xTimerStatsCreate( const char * const pcTimerName,
+                                 const TickType_t xTimerPeriodInTicks,
+                                 const BaseType_t xAutoReload,
+                                 void * const pvTimerID,
+                                 TimerCallbackFunction_t pxCallbackFunction )
+{
+    TimerStatsEntry_t * pxEntry = NULL;
+    TimerHandle_t xTimer = NULL;
+    UBaseType_t ux;
+
+    configASSERT( pxCallbackFunction != NULL );
+
+    /* The entry is reserved before the timer is created, so there is never a
+     * timer that has to be deleted again because there was no free entry. */
+    taskENTER_CRITICAL();
+    {
+        for( ux = 0; ux < timerstatsMAX_TIMERS; ux++ )
+        {
+            if( ( xEntries[ ux ].xTimer == NULL ) && ( xEntries[ ux ].xReserved == pdFALSE ) )
+            {
+                pxEntry = &( xEntries[ ux ] );
+                memset( pxEntry, 0x00, sizeof( TimerStatsEntry_t ) );
+                pxEntry->xReserved = pdTRUE;
+                break;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if( pxEntry != NULL )
+    {
+        pxEntry->pcName = pcTimerName;
+        pxEntry->pxCallbackFunction = pxCallbackFunction;
+        pxEntry->xAutoReload = xAutoReload;
+        pxEntry->xExpiryKnown = pdFALSE;
+
+        xTimer = xTimerCreate( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, prvCallbackWrapper );
+
+        /* The timer has not been started, so no command or expiry can look for
+         * the entry before the handle is written.  If the timer could not be
+         * created the handle is NULL, which frees the entry again. */
+        taskENTER_CRITICAL();
+        {
+            pxEntry->xTimer = xTimer;
+            pxEntry->xReserved = pdFALSE;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    return xTimer;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerStatsGetSnapshot( TimerHandle_t xTimer,
+                                   TimerStatsSnapshot_t * pxSnapshot )
+{
+    TimerStatsEntry_t * pxEntry;
+    BaseType_t xReturn = pdFAIL;
+
+    taskENTER_CRITICAL();
+    {
+        pxEntry = prvFindEntry( xTimer );
+
+        if( pxEntry != NULL )
+        {
+            prvFillSnapshot( pxEntry, pxSnapshot );
+            xReturn = pdPASS;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxTimerStatsGetWorstOffenders( TimerStatsMetric_t eMetric,
+                                           TimerStatsSnapshot_t * pxSnapshots,
+                                           UBaseType_t uxMaxSnapshots )
+{
+    TimerStatsSnapshot_t xSnapshot;
+    UBaseType_t ux, uxPosition, uxCount = 0;
+    BaseType_t xInUse;
+
+    configASSERT( eMetric < timerstatsNUM_METRICS );
+
+    for( ux = 0; ux < timerstatsMAX_TIMERS; ux++ )
+    {
+        taskENTER_CRITICAL();
+        {
+            xInUse = ( xEntries[ ux ].xTimer != NULL ) ? pdTRUE : pdFALSE;
+
+            if( xInUse != pdFALSE )
+            {
+                prvFillSnapshot( &( xEntries[ ux ] ), &xSnapshot );
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xInUse == pdFALSE )
+        {
+            continue;
+        }
+
+        /* Insert the snapshot in order, dropping the snapshot at the end of the
+         * array if it is full. */
+        uxPosition = uxCount;
+
+        while( ( uxPosition > 0 ) && ( pxSnapshots[ uxPosition - 1 ].ulMaxUs[ eMetric ] < xSnapshot.ulMaxUs[ eMetric ] ) )
+        {
+            if( uxPosition < uxMaxSnapshots )
+            {
+                pxSnapshots[ uxPosition ] = pxSnapshots[ uxPosition - 1 ];
+            }
+
+            uxPosition--;
+        }
+
+        if( uxPosition < uxMaxSnapshots )
+        {
+            pxSnapshots[ uxPosition ] = xSnapshot;
+
+            if( uxCount < uxMaxSnapshots )
+            {
+                uxCount++;
+            }
+        }
+    }
+
+    return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerStatsStartReporter( TickType_t xPeriod,
+                                     UBaseType_t uxPriority )
+{
+    return xTaskCreate( prvReporterTask, "TStats", 1000, ( void * ) ( size_t ) xPeriod, uxPriority, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCallbackWrapper( TimerHandle_t xTimer )
+{
+    TimerStatsEntry_t * pxEntry;
+    TimerCallbackFunction_t pxCallbackFunction = NULL;
+    TickType_t xTicksLate;
+    uint32_t ulStart, ulTickTimeUs, ulLatencyUs = 0;
+    BaseType_t xLatencyKnown = pdFALSE;
+
+    ulStart = ulBenchmarkTimerGetMicroseconds();
+
+    taskENTER_CRITICAL();
+    {
+        pxEntry = prvFindEntry( xTimer );
+
+        if( pxEntry != NULL )
+        {
+            pxCallbackFunction = pxEntry->pxCallbackFunction;
+
+            if( pxEntry->xExpiryKnown != pdFALSE )
+            {
+                if( xLatencyGetTickTime( pxEntry->xNextExpiry, &ulTickTimeUs ) != pdFAIL )
+                {
+                    ulLatencyUs = ulStart - ulTickTimeUs;
+                }
+                else
+                {
+                    xTicksLate = xTaskGetTickCount() - pxEntry->xNextExpiry;
+                    ulLatencyUs = ( uint32_t ) xTicksLate * portTICK_PERIOD_MS * 1000UL;
+                }
+
+                xLatencyKnown = pdTRUE;
+
+                /* The kernel calls the callback of an auto-reload timer once for
+                 * every period that has passed, even if it is late. */
+                if( pxEntry->xAutoReload != pdFALSE )
+                {
+                    pxEntry->xNextExpiry += xTimerGetPeriod( xTimer );
+                }
+                else
+                {
+                    pxEntry->xExpiryKnown = pdFALSE;
+                }
+            }
+
+            pxEntry->ulExpiries++;
+
+            if( xLatencyKnown != pdFALSE )
+            {
+                prvRecordTime( pxEntry, eTimerStatsLatency, ulLatencyUs );
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    configASSERT( pxCallbackFunction != NULL );
+
+    pxCallbackFunction( xTimer );
+
+    taskENTER_CRITICAL();
+    {
+        pxEntry = prvFindEntry( xTimer );
+
+        if( pxEntry != NULL )
+        {
+            prvRecordTime( pxEntry, eTimerStatsExecution, ulBenchmarkTimerGetMicroseconds() - ulStart );
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvReporterTask( void * pvParameters )
+{
+    const TickType_t xPeriod = ( TickType_t ) ( size_t ) pvParameters;
+    static const char * const pcMetricNames[ timerstatsNUM_METRICS ] = { "Dispatch latency", "Execution time", "Command wait" };
+    TimerStatsSnapshot_t xSnapshots[ timerstatsWORST_OFFENDERS ];
+    TimerStatsSnapshot_t xSnapshot;
+    BaseType_t xInUse;
+    UBaseType_t ux, uxCount, uxMetric;
+    char cBuffer[ 200 ];
+
+    for( ; ; )
+    {
+        vTaskDelay( xPeriod );
+
+        vPrintString( "Timer         Expiries  Latency mean/max (us)  Execution mean/max (us)  Commands  Wait mean/max (us)\r\n" );
+
+        for( ux = 0; ux < timerstatsMAX_TIMERS; ux++ )
+        {
+            taskENTER_CRITICAL();
+            {
+                xInUse = ( xEntries[ ux ].xTimer != NULL ) ? pdTRUE : pdFALSE;
+
+                if( xInUse != pdFALSE )
+                {
+                    prvFillSnapshot( &( xEntries[ ux ] ), &xSnapshot );
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xInUse == pdFALSE )
+            {
+                continue;
+            }
+
+            snprintf( cBuffer, sizeof( cBuffer ), "%-12s  %8lu  %10lu/%-10lu  %11lu/%-11lu  %8lu  %8lu/%-9lu\r\n",
+                      xSnapshot.pcName,
+                      ( unsigned long ) xSnapshot.ulExpiries,
+                      ( unsigned long ) ( ( xSnapshot.ulExpiries > 0 ) ? ( xSnapshot.ullTotalUs[ eTimerStatsLatency ] / xSnapshot.ulExpiries ) : 0 ),
+                      ( unsigned long ) xSnapshot.ulMaxUs[ eTimerStatsLatency ],
+                      ( unsigned long ) ( ( xSnapshot.ulExpiries > 0 ) ? ( xSnapshot.ullTotalUs[ eTimerStatsExecution ] / xSnapshot.ulExpiries ) : 0 ),
+                      ( unsigned long ) xSnapshot.ulMaxUs[ eTimerStatsExecution ],
+                      ( unsigned long ) xSnapshot.ulCommands,
+                      ( unsigned long ) ( ( xSnapshot.ulCommands > 0 ) ? ( xSnapshot.ullTotalUs[ eTimerStatsCommandWait ] / xSnapshot.ulCommands ) : 0 ),
+                      ( unsigned long ) xSnapshot.ulMaxUs[ eTimerStatsCommandWait ] );
+            vPrintString( cBuffer );
+
+            for( uxMetric = 0; uxMetric < timerstatsNUM_METRICS; uxMetric++ )
+            {
+                vLatencyHistogramPrint( pcMetricNames[ uxMetric ], xSnapshot.ulHistogram[ uxMetric ], timerstatsHISTOGRAM_BUCKETS );
+            }
+        }
+
+        /* List the timers with the longest maximum of each metric. */
+        for( uxMetric = 0; uxMetric < timerstatsNUM_METRICS; uxMetric++ )
+        {
+            uxCount = uxTimerStatsGetWorstOffenders( ( TimerStatsMetric_t ) uxMetric, xSnapshots, timerstatsWORST_OFFENDERS );
+            snprintf( cBuffer, sizeof( cBuffer ), "Worst %s:", pcMetricNames[ uxMetric ] );
+            vPrintString( cBuffer );
+
+            for( ux = 0; ux < uxCount; ux++ )
+            {
+                snprintf( cBuffer, sizeof( cBuffer ), "  %s (%luus)", xSnapshots[ ux ].pcName, ( unsigned long ) xSnapshots[ ux ].ulMaxUs[ uxMetric ] );
+                vPrintString( cBuffer );
+            }
+
+            vPrintString( "\r\n" );
+        }
+
+        vPrintString( "\r\n" );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static TimerStatsEntry_t * prvFindEntry( const void * pvTimer )
+{
+    UBaseType_t ux;
+
+    for( ux = 0; ux < timerstatsMAX_TIMERS; ux++ )
+    {
+        if( ( const void * ) xEntries[ ux ].xTimer == pvTimer )
+        {
+            return &( xEntries[ ux ] );
+        }
+    }
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordTime( TimerStatsEntry_t * pxEntry,
+                           TimerStatsMetric_t eMetric,
+                           uint32_t ulTimeUs )
+{
+    pxEntry->ullTotalUs[ eMetric ] += ulTimeUs;
+
+    if( ulTimeUs > pxEntry->ulMaxUs[ eMetric ] )
+    {
+        pxEntry->ulMaxUs[ eMetric ] = ulTimeUs;
+    }
+
+    vLatencyHistogramAdd( pxEntry->ulHistogram[ eMetric ], timerstatsHISTOGRAM_BUCKETS, ulTimeUs );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFillSnapshot( const TimerStatsEntry_t * pxEntry,
+                             TimerStatsSnapshot_t * pxSnapshot )
+{
+    pxSnapshot->xTimer = pxEntry->xTimer;
+    pxSnapshot->pcName = pxEntry->pcName;
+    pxSnapshot->ulExpiries = pxEntry->ulExpiries;
+    pxSnapshot->ulCommands = pxEntry->ulCommands;
+    memcpy( pxSnapshot->ulMaxUs, pxEntry->ulMaxUs, sizeof( pxSnapshot->ulMaxUs ) );
+    memcpy( pxSnapshot->ullTotalUs, pxEntry->ullTotalUs, sizeof( pxSnapshot->ullTotalUs ) );
+    memcpy( pxSnapshot->ulHistogram, pxEntry->ulHistogram, sizeof( pxSnapshot->ulHistogram ) );
+}
+/*-----------------------------------------------------------*/
+
+void vTimerStatsCommandSent( void * pvTimer,
+                             int32_t lCommandID,
+                             int32_t lReturn )
+{
+    TimerStatsEntry_t * pxEntry;
+    UBaseType_t uxSavedInterruptStatus = 0;
+    uint32_t ulNow = ulBenchmarkTimerGetMicroseconds();
+
+    if( lReturn != pdPASS )
+    {
+        return;
+    }
+
+    /* The interrupt safe API functions send the commands numbered from
+     * tmrFIRST_FROM_ISR_COMMAND. */
+    if( lCommandID >= tmrFIRST_FROM_ISR_COMMAND )
+    {
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    }
+    else
+    {
+        taskENTER_CRITICAL();
+    }
+
+    pxEntry = prvFindEntry( pvTimer );
+
+    if( pxEntry != NULL )
+    {
+        if( pxEntry->uxEarlyReceives > 0 )
+        {
+            /* The command has already been received. */
+            pxEntry->uxEarlyReceives--;
+        }
+        else if( pxEntry->uxCommandsWaiting < configTIMER_QUEUE_LENGTH )
+        {
+            pxEntry->ulSendTimes[ pxEntry->uxHead ] = ulNow;
+            pxEntry->uxHead = ( pxEntry->uxHead + 1 ) % configTIMER_QUEUE_LENGTH;
+            pxEntry->uxCommandsWaiting++;
+        }
+    }
+
+    if( lCommandID >= tmrFIRST_FROM_ISR_COMMAND )
+    {
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    }
+    else
+    {
+        taskEXIT_CRITICAL();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vTimerStatsCommandReceived( void * pvTimer,
+                                 int32_t lCommandID,
+                                 uint32_t ulValue )
+{
+    TimerStatsEntry_t * pxEntry;
+    UBaseType_t uxTail;
+    uint32_t ulWaitUs = 0;
+    uint32_t ulNow = ulBenchmarkTimerGetMicroseconds();
+
+    taskENTER_CRITICAL();
+    {
+        pxEntry = prvFindEntry( pvTimer );
+
+        if( pxEntry != NULL )
+        {
+            pxEntry->ulCommands++;
+
+            if( pxEntry->uxCommandsWaiting > 0 )
+            {
+                uxTail = ( pxEntry->uxHead + configTIMER_QUEUE_LENGTH - pxEntry->uxCommandsWaiting ) % configTIMER_QUEUE_LENGTH;
+                ulWaitUs = ulNow - pxEntry->ulSendTimes[ uxTail ];
+                pxEntry->uxCommandsWaiting--;
+            }
+            else
+            {
+                /* The timer service task preempted the sending task, so this
+                 * command is received before the send is recorded. */
+                pxEntry->uxEarlyReceives++;
+            }
+
+            prvRecordTime( pxEntry, eTimerStatsCommandWait, ulWaitUs );
+
+            /* Track the expiry time the kernel will calculate. */
+            switch( lCommandID )
+            {
+                case tmrCOMMAND_START_DONT_TRACE:
+                case tmrCOMMAND_START:
+                case tmrCOMMAND_START_FROM_ISR:
+                case tmrCOMMAND_RESET:
+                case tmrCOMMAND_RESET_FROM_ISR:
+
+                    /* ulValue is the tick count at the time the command was
+                     * sent. */
+                    pxEntry->xNextExpiry = ( TickType_t ) ulValue + xTimerGetPeriod( pxEntry->xTimer );
+                    pxEntry->xExpiryKnown = pdTRUE;
+                    break;
+
+                case tmrCOMMAND_CHANGE_PERIOD:
+                case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
+
+                    /* ulValue is the new period, which is measured from the
+                     * time the command is processed. */
+                    pxEntry->xNextExpiry = xTaskGetTickCount() + ( TickType_t ) ulValue;
+                    pxEntry->xExpiryKnown = pdTRUE;
+                    break;
+
+                case tmrCOMMAND_STOP:
+                case tmrCOMMAND_STOP_FROM_ISR:
+                    pxEntry->xExpiryKnown = pdFALSE;
+                    break;
+
+                case tmrCOMMAND_DELETE:
+
+                    /* Discard the statistics, as the handle may be reused. */
+                    pxEntry->xTimer = NULL;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
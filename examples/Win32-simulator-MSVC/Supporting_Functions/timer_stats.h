@@ -0,0 +1,155 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef TIMER_STATS_H
+#define TIMER_STATS_H
+
+/*
+ * Software timer dispatch latency instrumentation.
+ *
+ * Software timer callbacks execute one at a time in the context of the timer
+ * service task, so a callback that takes a long time delays every timer that
+ * expires while it executes, and also delays the processing of the commands
+ * sent to the timer service.  This module records, for each timer created with
+ * xTimerStatsCreate():
+ *
+ *  + Dispatch latency - the time from the tick interrupt in which the timer
+ *    expired to its callback starting to execute.
+ *  + Execution time - the time taken by the callback.
+ *  + Command wait time - the time from a command being sent to the timer to the
+ *    timer service task receiving it.
+ *
+ * Each is recorded as a total, a maximum and a histogram, and the timers that
+ * have the longest maximum of each can be listed with
+ * uxTimerStatsGetWorstOffenders().  The reporter task prints all of them.
+ *
+ * xTimerStatsCreate() takes the same parameters as xTimerCreate().  The timer
+ * it creates calls a wrapper that times the callback passed to it.  Every other
+ * timer API function is used as normal.  The expiry time of each timer is
+ * tracked from the commands the timer service task receives, so statistics
+ * are accurate however the timer is started, reset or changed.  A timer's
+ * statistics are discarded when the timer service task processes the command
+ * to delete it.  The auto-reload setting is recorded when the timer is
+ * created, so vTimerSetReloadMode() must not be used on an instrumented timer.
+ * Timers created with xTimerCreate() are ignored, but still pay for a search of
+ * the instrumented timers on every command they are sent.
+ *
+ * Dispatch latency is measured from the time of the tick interrupt, as recorded
+ * by vLatencyTickHook() - see latency.h.  If the tick was more than
+ * latencyTICK_TIMES ticks ago, the latency is calculated from the tick count
+ * alone.  The histograms are decade histograms, also described in latency.h.
+ * When a command is sent from a task with a lower priority than the timer
+ * service task, the timer service task receives it before the sending function
+ * returns.  Such a command is recorded as having waited 0.
+ *
+ * FreeRTOSConfig.h must contain:
+ *
+ *  #define traceTASK_INCREMENT_TICK( xTickCount )  vLatencyTickHook( xTickCount )
+ *  #define traceTIMER_COMMAND_SEND( xTimer, xMessageID, xMessageValueValue, xReturn ) \
+ *      vTimerStatsCommandSent( xTimer, xMessageID, xReturn )
+ *  #define traceTIMER_COMMAND_RECEIVED( pxTimer, xMessageID, xMessageValue ) \
+ *      vTimerStatsCommandReceived( pxTimer, xMessageID, xMessageValue )
+ *
+ * vBenchmarkTimerInit() must be called before the scheduler is started, as
+ * the tick hook reads the benchmark timer on every tick.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "timers.h"
+
+/* The maximum number of timers that can be instrumented at once.  Can be
+ * overridden in FreeRTOSConfig.h. */
+#ifndef timerstatsMAX_TIMERS
+    #define timerstatsMAX_TIMERS          8
+#endif
+
+/* The number of buckets in the histogram of each metric.  The default of 7
+ * gives a last bucket that counts callbacks delayed, or running, for a second
+ * or more.  Can be overridden in FreeRTOSConfig.h. */
+#ifndef timerstatsHISTOGRAM_BUCKETS
+    #define timerstatsHISTOGRAM_BUCKETS   7
+#endif
+
+/* The number of timers listed by the reporter task for each metric. */
+#ifndef timerstatsWORST_OFFENDERS
+    #define timerstatsWORST_OFFENDERS     3
+#endif
+
+/* The statistics that can be used to rank timers. */
+typedef enum
+{
+    eTimerStatsLatency = 0,
+    eTimerStatsExecution,
+    eTimerStatsCommandWait
+} TimerStatsMetric_t;
+
+/* The statistics of one timer, as returned by xTimerStatsGetSnapshot(). */
+typedef struct TimerStatsSnapshot
+{
+    TimerHandle_t xTimer;
+    const char * pcName;
+    uint32_t ulExpiries;
+    uint32_t ulCommands;
+    uint32_t ulMaxUs[ 3 ];     /* Indexed by TimerStatsMetric_t. */
+    uint64_t ullTotalUs[ 3 ];  /* Indexed by TimerStatsMetric_t. */
+    uint32_t ulHistogram[ 3 ][ timerstatsHISTOGRAM_BUCKETS ];
+} TimerStatsSnapshot_t;
+
+/*
+ * Create a timer, as per xTimerCreate(), and start gathering its statistics.
+ * Returns NULL if timerstatsMAX_TIMERS timers are already instrumented or there
+ * was insufficient heap memory.
+ */
+TimerHandle_t xTimerStatsCreate( const char * const pcTimerName,
+                                 const TickType_t xTimerPeriodInTicks,
+                                 const BaseType_t xAutoReload,
+                                 void * const pvTimerID,
+                                 TimerCallbackFunction_t pxCallbackFunction );
+
+/*
+ * Copy out the statistics of xTimer.  Returns pdFAIL if xTimer was not created
+ * by xTimerStatsCreate(), or has been deleted.
+ */
+BaseType_t xTimerStatsGetSnapshot( TimerHandle_t xTimer,
+                                   TimerStatsSnapshot_t * pxSnapshot );
+
+/*
+ * Copy out the statistics of the uxMaxSnapshots timers with the longest maximum
+ * eMetric, longest first.  Returns the number of snapshots written.
+ */
+UBaseType_t uxTimerStatsGetWorstOffenders( TimerStatsMetric_t eMetric,
+                                           TimerStatsSnapshot_t * pxSnapshots,
+                                           UBaseType_t uxMaxSnapshots );
+
+/*
+ * Create a task, at priority uxPriority, that prints the statistics of every
+ * instrumented timer once every xPeriod ticks.
+ */
+BaseType_t xTimerStatsStartReporter( TickType_t xPeriod,
+                                     UBaseType_t uxPriority );
+
+/*
+ * The implementations of traceTIMER_COMMAND_SEND() and
+ * traceTIMER_COMMAND_RECEIVED(), which track each instrumented timer's expiry
+ * time and time its commands.  The application does not call them directly.
+ */
+void vTimerStatsCommandSent( void * pvTimer,
+                             int32_t lCommandID,
+                             int32_t lReturn );
+void vTimerStatsCommandReceived( void * pvTimer,
+                                 int32_t lCommandID,
+                                 uint32_t ulValue );
+
+#endif /* TIMER_STATS_H */
@@ -0,0 +1,778 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/*
+ * Hierarchical timing wheel software timer service.  See timer_wheel.h for a
+ * description.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "timer_wheel.h"
+
+/* The commands sent to the service task.  Resetting a timer is the same as
+ * starting it. */
+#define timerwheelCOMMAND_NONE             ( ( BaseType_t ) -1 )
+#define timerwheelCOMMAND_START            ( ( BaseType_t ) 0 )
+#define timerwheelCOMMAND_STOP             ( ( BaseType_t ) 1 )
+#define timerwheelCOMMAND_CHANGE_PERIOD    ( ( BaseType_t ) 2 )
+#define timerwheelCOMMAND_DELETE           ( ( BaseType_t ) 3 )
+
+#define timerwheelSLOT_MASK                ( timerwheelSLOTS - 1UL )
+
+/* The furthest in the future a timer can be placed directly into a wheel. */
+#define timerwheelMAX_DELTA                ( ( TickType_t ) ( ( 1UL << ( timerwheelSLOT_BITS * timerwheelLEVELS ) ) - 1UL ) )
+
+typedef struct TimerWheelTimer
+{
+    ListItem_t xWheelItem;   /* Referenced from the slot the timer is in while it is active. */
+    ListItem_t xPendingItem; /* Referenced from xPendingTimers while a command is pending. */
+    const char * pcTimerName;
+    TickType_t xPeriod;
+    TickType_t xExpiryTime;  /* The time the timer should expire, before slack is applied. */
+    TickType_t xSlack;
+    BaseType_t xAutoReload;
+    BaseType_t xActive;
+    void * pvTimerID;
+    TimerWheelCallbackFunction_t pxCallbackFunction;
+
+    /* The pending command, accessed from critical sections. */
+    BaseType_t xPendingCommand;
+    TickType_t xPendingTime;   /* The time a pending start or reset was sent. */
+    TickType_t xPendingPeriod; /* A pending new period, or 0 if there is none. */
+} TimerWheelTimer_t;
+
+/* A copy of a timer's pending command, taken by the service task. */
+typedef struct TimerWheelCommand
+{
+    BaseType_t xCommandID;
+    TickType_t xTime;
+    TickType_t xNewPeriod;
+    TimerWheelTimer_t * pxTimer;
+} TimerWheelCommand_t;
+
+/* The service task. */
+static void prvTimerWheelTask( void * pvParameters );
+
+/* Send a command to the service task. */
+static BaseType_t prvSendCommand( TimerWheelTimer_t * pxTimer,
+                                  BaseType_t xCommandID,
+                                  TickType_t xValue );
+static BaseType_t prvSendCommandFromISR( TimerWheelTimer_t * pxTimer,
+                                         BaseType_t xCommandID,
+                                         TickType_t xValue,
+                                         BaseType_t * pxHigherPriorityTaskWoken );
+
+/* Combine a command with any command already pending for the timer.  Must be
+ * called from a critical section.  Returns pdTRUE if the service task needs to
+ * be notified because the timer did not already have a command pending. */
+static BaseType_t prvMergeCommand( TimerWheelTimer_t * pxTimer,
+                                   BaseType_t xCommandID,
+                                   TickType_t xValue );
+
+/* Carry out the commands pending for each timer in xPendingTimers. */
+static void prvProcessPendingCommands( void );
+
+/* Carry out one command taken from a timer by the service task. */
+static void prvProcessCommand( const TimerWheelCommand_t * pxCommand );
+
+/* Place an active timer in the slot that corresponds to its expiry time. */
+static void prvInsertTimer( TimerWheelTimer_t * pxTimer );
+
+/* Return the tick on which a timer that should expire at xExpiryTime will be
+ * expired, given its slack. */
+static TickType_t prvApplySlack( TickType_t xExpiryTime,
+                                 TickType_t xSlack );
+
+/* Take a timer out of the wheel, if it is in it. */
+static void prvRemoveTimer( TimerWheelTimer_t * pxTimer );
+
+/* Cascade the timers in the slot of the wheel at uxLevel that covers the
+ * current time into the wheels below, and return the index of that slot. */
+static UBaseType_t prvCascade( UBaseType_t uxLevel );
+
+/* Expire the timers due at xWheelTime, then move xWheelTime on one tick. */
+static void prvProcessTick( void );
+
+/* Call the callback of a timer that has expired, reloading it first if it is
+ * an auto-reload timer. */
+static void prvExpireTimer( TimerWheelTimer_t * pxTimer );
+
+/* Return the number of ticks from xTimeNow to the next tick on which there is
+ * anything to do. */
+static TickType_t prvGetTicksToNextWork( TickType_t xTimeNow );
+
+/*-----------------------------------------------------------*/
+
+/* The wheels.  Only accessed by the service task. */
+static List_t xWheels[ timerwheelLEVELS ][ timerwheelSLOTS ];
+
+/* The next tick to be processed, and the number of timers in the wheels. */
+static TickType_t xWheelTime = 0;
+static UBaseType_t uxActiveTimers = 0;
+
+/* The timers that have a command pending, in the order the commands were
+ * first sent. */
+static List_t xPendingTimers;
+
+static TaskHandle_t xServiceTask = NULL;
+static TimerWheelStats_t xStats = { 0 };
+
+/* Statistics only written by the service task, so kept out of xStats, which
+ * is written from critical sections. */
+static uint32_t ulWakeups = 0;
+static uint32_t ulExpiryTicks = 0;
+static uint32_t ulSlackedExpiries = 0;
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerWheelServiceStart( UBaseType_t uxPriority )
+{
+    UBaseType_t uxLevel, uxSlot;
+
+    configASSERT( xServiceTask == NULL );
+
+    for( uxLevel = 0; uxLevel < timerwheelLEVELS; uxLevel++ )
+    {
+        for( uxSlot = 0; uxSlot < timerwheelSLOTS; uxSlot++ )
+        {
+            vListInitialise( &( xWheels[ uxLevel ][ uxSlot ] ) );
+        }
+    }
+
+    vListInitialise( &xPendingTimers );
+    xWheelTime = xTaskGetTickCount();
+
+    return xTaskCreate( prvTimerWheelTask, "TmrWheel", 1000, NULL, uxPriority, &xServiceTask );
+}
+/*-----------------------------------------------------------*/
+
+TimerWheelHandle_t xTimerWheelCreate( const char * const pcTimerName,
+                                      const TickType_t xTimerPeriodInTicks,
+                                      const BaseType_t xAutoReload,
+                                      void * const pvTimerID,
+                                      TimerWheelCallbackFunction_t pxCallbackFunction )
+{
+    TimerWheelTimer_t * pxTimer;
+
+    configASSERT( xTimerPeriodInTicks > 0 );
+
+    pxTimer = ( TimerWheelTimer_t * ) pvPortMalloc( sizeof( TimerWheelTimer_t ) );
+
+    if( pxTimer != NULL )
+    {
+        vListInitialiseItem( &( pxTimer->xWheelItem ) );
+        listSET_LIST_ITEM_OWNER( &( pxTimer->xWheelItem ), pxTimer );
+        vListInitialiseItem( &( pxTimer->xPendingItem ) );
+        listSET_LIST_ITEM_OWNER( &( pxTimer->xPendingItem ), pxTimer );
+        pxTimer->pcTimerName = pcTimerName;
+        pxTimer->xPeriod = xTimerPeriodInTicks;
+        pxTimer->xExpiryTime = 0;
+        pxTimer->xSlack = 0;
+        pxTimer->xAutoReload = xAutoReload;
+        pxTimer->xActive = pdFALSE;
+        pxTimer->pvTimerID = pvTimerID;
+        pxTimer->pxCallbackFunction = pxCallbackFunction;
+        pxTimer->xPendingCommand = timerwheelCOMMAND_NONE;
+        pxTimer->xPendingTime = 0;
+        pxTimer->xPendingPeriod = 0;
+    }
+
+    return pxTimer;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerWheelStart( TimerWheelHandle_t xTimer,
+                             TickType_t xTicksToWait )
+{
+    ( void ) xTicksToWait;
+    return prvSendCommand( xTimer, timerwheelCOMMAND_START, xTaskGetTickCount() );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerWheelStop( TimerWheelHandle_t xTimer,
+                            TickType_t xTicksToWait )
+{
+    ( void ) xTicksToWait;
+    return prvSendCommand( xTimer, timerwheelCOMMAND_STOP, 0 );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerWheelReset( TimerWheelHandle_t xTimer,
+                             TickType_t xTicksToWait )
+{
+    ( void ) xTicksToWait;
+    return prvSendCommand( xTimer, timerwheelCOMMAND_START, xTaskGetTickCount() );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerWheelChangePeriod( TimerWheelHandle_t xTimer,
+                                    TickType_t xNewPeriod,
+                                    TickType_t xTicksToWait )
+{
+    configASSERT( xNewPeriod > 0 );
+    ( void ) xTicksToWait;
+    return prvSendCommand( xTimer, timerwheelCOMMAND_CHANGE_PERIOD, xNewPeriod );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerWheelDelete( TimerWheelHandle_t xTimer,
+                              TickType_t xTicksToWait )
+{
+    ( void ) xTicksToWait;
+    return prvSendCommand( xTimer, timerwheelCOMMAND_DELETE, 0 );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerWheelStartFromISR( TimerWheelHandle_t xTimer,
+                                    BaseType_t * pxHigherPriorityTaskWoken )
+{
+    return prvSendCommandFromISR( xTimer, timerwheelCOMMAND_START, xTaskGetTickCountFromISR(), pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerWheelStopFromISR( TimerWheelHandle_t xTimer,
+                                   BaseType_t * pxHigherPriorityTaskWoken )
+{
+    return prvSendCommandFromISR( xTimer, timerwheelCOMMAND_STOP, 0, pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerWheelResetFromISR( TimerWheelHandle_t xTimer,
+                                    BaseType_t * pxHigherPriorityTaskWoken )
+{
+    return prvSendCommandFromISR( xTimer, timerwheelCOMMAND_START, xTaskGetTickCountFromISR(), pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerWheelChangePeriodFromISR( TimerWheelHandle_t xTimer,
+                                           TickType_t xNewPeriod,
+                                           BaseType_t * pxHigherPriorityTaskWoken )
+{
+    configASSERT( xNewPeriod > 0 );
+    return prvSendCommandFromISR( xTimer, timerwheelCOMMAND_CHANGE_PERIOD, xNewPeriod, pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+void * pvTimerWheelGetTimerID( TimerWheelHandle_t xTimer )
+{
+    void * pvReturn;
+
+    taskENTER_CRITICAL();
+    {
+        pvReturn = xTimer->pvTimerID;
+    }
+    taskEXIT_CRITICAL();
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTimerWheelSetTimerID( TimerWheelHandle_t xTimer,
+                            void * pvNewID )
+{
+    taskENTER_CRITICAL();
+    {
+        xTimer->pvTimerID = pvNewID;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTimerWheelIsTimerActive( TimerWheelHandle_t xTimer )
+{
+    BaseType_t xReturn;
+
+    taskENTER_CRITICAL();
+    {
+        xReturn = xTimer->xActive;
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xTimerWheelGetPeriod( TimerWheelHandle_t xTimer )
+{
+    return xTimer->xPeriod;
+}
+/*-----------------------------------------------------------*/
+
+const char * pcTimerWheelGetName( TimerWheelHandle_t xTimer )
+{
+    return xTimer->pcTimerName;
+}
+/*-----------------------------------------------------------*/
+
+void vTimerWheelSetSlack( TimerWheelHandle_t xTimer,
+                          TickType_t xSlack )
+{
+    taskENTER_CRITICAL();
+    {
+        xTimer->xSlack = xSlack;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xTimerWheelGetSlack( TimerWheelHandle_t xTimer )
+{
+    TickType_t xReturn;
+
+    taskENTER_CRITICAL();
+    {
+        xReturn = xTimer->xSlack;
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTimerWheelGetStats( TimerWheelStats_t * pxStats )
+{
+    taskENTER_CRITICAL();
+    {
+        *pxStats = xStats;
+    }
+    taskEXIT_CRITICAL();
+
+    pxStats->ulWakeups = ulWakeups;
+    pxStats->ulExpiryTicks = ulExpiryTicks;
+    pxStats->ulSlackedExpiries = ulSlackedExpiries;
+}
+/*-----------------------------------------------------------*/
+
+void vTimerWheelResetMaxPending( void )
+{
+    taskENTER_CRITICAL();
+    {
+        xStats.uxMaxPending = listCURRENT_LIST_LENGTH( &xPendingTimers );
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSendCommand( TimerWheelTimer_t * pxTimer,
+                                  BaseType_t xCommandID,
+                                  TickType_t xValue )
+{
+    BaseType_t xNotify;
+
+    configASSERT( pxTimer != NULL );
+    configASSERT( xServiceTask != NULL );
+
+    taskENTER_CRITICAL();
+    {
+        xNotify = prvMergeCommand( pxTimer, xCommandID, xValue );
+    }
+    taskEXIT_CRITICAL();
+
+    if( xNotify != pdFALSE )
+    {
+        xTaskNotifyGive( xServiceTask );
+    }
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSendCommandFromISR( TimerWheelTimer_t * pxTimer,
+                                         BaseType_t xCommandID,
+                                         TickType_t xValue,
+                                         BaseType_t * pxHigherPriorityTaskWoken )
+{
+    BaseType_t xNotify;
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT( pxTimer != NULL );
+    configASSERT( xServiceTask != NULL );
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        xNotify = prvMergeCommand( pxTimer, xCommandID, xValue );
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    if( xNotify != pdFALSE )
+    {
+        vTaskNotifyGiveFromISR( xServiceTask, pxHigherPriorityTaskWoken );
+    }
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvMergeCommand( TimerWheelTimer_t * pxTimer,
+                                   BaseType_t xCommandID,
+                                   TickType_t xValue )
+{
+    BaseType_t xNotify = pdFALSE;
+
+    xStats.ulCommandsSent++;
+
+    if( pxTimer->xPendingCommand == timerwheelCOMMAND_NONE )
+    {
+        pxTimer->xPendingPeriod = 0;
+        vListInsertEnd( &xPendingTimers, &( pxTimer->xPendingItem ) );
+        xNotify = pdTRUE;
+
+        if( listCURRENT_LIST_LENGTH( &xPendingTimers ) > xStats.uxMaxPending )
+        {
+            xStats.uxMaxPending = listCURRENT_LIST_LENGTH( &xPendingTimers );
+        }
+    }
+    else
+    {
+        xStats.ulCommandsCoalesced++;
+    }
+
+    /* The later command replaces the earlier one, except that a change of
+     * period made by the earlier command still applies. */
+    pxTimer->xPendingCommand = xCommandID;
+
+    if( xCommandID == timerwheelCOMMAND_CHANGE_PERIOD )
+    {
+        pxTimer->xPendingPeriod = xValue;
+    }
+    else
+    {
+        pxTimer->xPendingTime = xValue;
+    }
+
+    return xNotify;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerWheelTask( void * pvParameters )
+{
+    TickType_t xTimeNow, xTicksToWait;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* Process every tick up to and including the current tick.  If this
+         * task has been kept from running by higher priority tasks there may be
+         * more than one. */
+        xTimeNow = xTaskGetTickCount();
+
+        while( xWheelTime != ( xTimeNow + 1 ) )
+        {
+            prvProcessTick();
+        }
+
+        /* Wait to be notified that a command is pending, or until there is
+         * another tick to process. */
+        xTicksToWait = prvGetTicksToNextWork( xTimeNow );
+        ( void ) ulTaskNotifyTake( pdTRUE, xTicksToWait );
+        ulWakeups++;
+
+        prvProcessPendingCommands();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessPendingCommands( void )
+{
+    TimerWheelCommand_t xCommand;
+
+    for( ; ; )
+    {
+        /* Take the command from the timer, so a command sent while this one is
+         * being processed is pended again. */
+        taskENTER_CRITICAL();
+        {
+            if( listLIST_IS_EMPTY( &xPendingTimers ) != pdFALSE )
+            {
+                xCommand.pxTimer = NULL;
+            }
+            else
+            {
+                xCommand.pxTimer = ( TimerWheelTimer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xPendingTimers );
+                ( void ) uxListRemove( &( xCommand.pxTimer->xPendingItem ) );
+                xCommand.xCommandID = xCommand.pxTimer->xPendingCommand;
+                xCommand.xTime = xCommand.pxTimer->xPendingTime;
+                xCommand.xNewPeriod = xCommand.pxTimer->xPendingPeriod;
+                xCommand.pxTimer->xPendingCommand = timerwheelCOMMAND_NONE;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xCommand.pxTimer == NULL )
+        {
+            break;
+        }
+
+        prvProcessCommand( &xCommand );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessCommand( const TimerWheelCommand_t * pxCommand )
+{
+    TimerWheelTimer_t * pxTimer = pxCommand->pxTimer;
+    TickType_t xTimeNow = xTaskGetTickCount();
+
+    prvRemoveTimer( pxTimer );
+
+    if( pxCommand->xNewPeriod != 0 )
+    {
+        pxTimer->xPeriod = pxCommand->xNewPeriod;
+    }
+
+    switch( pxCommand->xCommandID )
+    {
+        case timerwheelCOMMAND_START:
+
+            /* As per the kernel's timers, the period is measured from the time
+             * the command was sent.  If that time has already passed, because
+             * the service task was kept from running, the timer expires
+             * immediately. */
+            pxTimer->xExpiryTime = pxCommand->xTime + pxTimer->xPeriod;
+
+            if( ( xTimeNow - pxCommand->xTime ) >= pxTimer->xPeriod )
+            {
+                prvExpireTimer( pxTimer );
+            }
+            else
+            {
+                prvInsertTimer( pxTimer );
+            }
+
+            break;
+
+        case timerwheelCOMMAND_CHANGE_PERIOD:
+
+            /* Changing the period also starts the timer, from the time the
+             * command is processed. */
+            pxTimer->xExpiryTime = xTimeNow + pxTimer->xPeriod;
+            prvInsertTimer( pxTimer );
+            break;
+
+        case timerwheelCOMMAND_DELETE:
+            vPortFree( pxTimer );
+            break;
+
+        case timerwheelCOMMAND_STOP:
+        default:
+            /* Already removed from the wheel. */
+            break;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertTimer( TimerWheelTimer_t * pxTimer )
+{
+    TickType_t xSlotTime = prvApplySlack( pxTimer->xExpiryTime, pxTimer->xSlack );
+    TickType_t xDelta = xSlotTime - xWheelTime;
+    UBaseType_t uxLevel = 0;
+
+    if( xDelta > ( portMAX_DELAY / 2 ) )
+    {
+        /* The expiry time has already passed, so expire the timer on the next
+         * tick that is processed. */
+        xSlotTime = xWheelTime;
+    }
+    else if( xDelta > timerwheelMAX_DELTA )
+    {
+        /* Too far in the future to place.  Use the furthest slot of the
+         * coarsest wheel, from which the timer will be cascaded back into the
+         * same wheel until it can be placed. */
+        uxLevel = timerwheelLEVELS - 1;
+        xSlotTime = xWheelTime + timerwheelMAX_DELTA;
+    }
+    else
+    {
+        /* Use the finest wheel that spans the time until the timer expires. */
+        while( xDelta >= ( ( TickType_t ) 1 << ( timerwheelSLOT_BITS * ( uxLevel + 1 ) ) ) )
+        {
+            uxLevel++;
+        }
+    }
+
+    vListInsertEnd( &( xWheels[ uxLevel ][ ( xSlotTime >> ( timerwheelSLOT_BITS * uxLevel ) ) & timerwheelSLOT_MASK ] ), &( pxTimer->xWheelItem ) );
+
+    if( pxTimer->xActive == pdFALSE )
+    {
+        uxActiveTimers++;
+
+        taskENTER_CRITICAL();
+        {
+            pxTimer->xActive = pdTRUE;
+        }
+        taskEXIT_CRITICAL();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvApplySlack( TickType_t xExpiryTime,
+                                 TickType_t xSlack )
+{
+    TickType_t xLimit = xExpiryTime + xSlack;
+    TickType_t xDifference = xExpiryTime ^ xLimit;
+    TickType_t xBit = 1;
+
+    /* Leave the expiry time alone if there is no slack, or if the slack window
+     * wraps past the maximum tick count. */
+    if( ( xDifference == 0 ) || ( xLimit < xExpiryTime ) )
+    {
+        return xExpiryTime;
+    }
+
+    /* Clear the bits of the latest acceptable time below the highest bit in
+     * which it differs from the expiry time.  The result is the multiple of the
+     * largest power of two that falls within the slack window, which timers
+     * with overlapping windows are likely to share. */
+    while( ( xDifference >> 1 ) != 0 )
+    {
+        xDifference >>= 1;
+        xBit <<= 1;
+    }
+
+    return xLimit & ~( xBit - 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveTimer( TimerWheelTimer_t * pxTimer )
+{
+    if( listLIST_ITEM_CONTAINER( &( pxTimer->xWheelItem ) ) != NULL )
+    {
+        ( void ) uxListRemove( &( pxTimer->xWheelItem ) );
+        uxActiveTimers--;
+
+        taskENTER_CRITICAL();
+        {
+            pxTimer->xActive = pdFALSE;
+        }
+        taskEXIT_CRITICAL();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvCascade( UBaseType_t uxLevel )
+{
+    UBaseType_t uxSlot, uxNumTimers;
+    List_t * pxSlot;
+    TimerWheelTimer_t * pxTimer;
+
+    uxSlot = ( UBaseType_t ) ( ( xWheelTime >> ( timerwheelSLOT_BITS * uxLevel ) ) & timerwheelSLOT_MASK );
+    pxSlot = &( xWheels[ uxLevel ][ uxSlot ] );
+
+    /* Each timer in the slot now expires within the span of one slot of this
+     * wheel, so is placed in a finer wheel.  The exception is a timer that is still too
+     * far in the future to place, which can only be in the coarsest wheel.
+     * prvInsertTimer() puts it at xWheelTime + timerwheelMAX_DELTA, and as the
+     * bits of xWheelTime below this wheel's slot index are zero when it
+     * cascades, that is slot uxSlot - 1 - the slot furthest from this one, not
+     * this one.  No timer is put back into pxSlot, and moving only the number
+     * of timers in the slot when the cascade starts bounds the loop anyway. */
+    for( uxNumTimers = listCURRENT_LIST_LENGTH( pxSlot ); uxNumTimers > 0; uxNumTimers-- )
+    {
+        pxTimer = ( TimerWheelTimer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+        ( void ) uxListRemove( &( pxTimer->xWheelItem ) );
+        prvInsertTimer( pxTimer );
+    }
+
+    return uxSlot;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessTick( void )
+{
+    UBaseType_t uxLevel;
+    List_t * pxSlot;
+    TimerWheelTimer_t * pxTimer;
+
+    /* Each time the finest wheel wraps, the timers in the next slot of the
+     * wheel above are moved down, and so on up the wheels. */
+    if( ( xWheelTime & timerwheelSLOT_MASK ) == 0 )
+    {
+        for( uxLevel = 1; uxLevel < timerwheelLEVELS; uxLevel++ )
+        {
+            if( prvCascade( uxLevel ) != 0 )
+            {
+                break;
+            }
+        }
+    }
+
+    /* Every timer in the slot of the finest wheel for this tick has expired. */
+    pxSlot = &( xWheels[ 0 ][ xWheelTime & timerwheelSLOT_MASK ] );
+
+    if( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+    {
+        ulExpiryTicks++;
+    }
+
+    while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+    {
+        pxTimer = ( TimerWheelTimer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+
+        if( ( pxTimer->xSlack != 0 ) && ( pxTimer->xExpiryTime != xWheelTime ) )
+        {
+            ulSlackedExpiries++;
+        }
+
+        prvRemoveTimer( pxTimer );
+        prvExpireTimer( pxTimer );
+    }
+
+    xWheelTime++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvExpireTimer( TimerWheelTimer_t * pxTimer )
+{
+    /* An auto-reload timer's next expiry time is relative to the time it
+     * should have expired, not the time it was processed, so it does not
+     * drift. */
+    if( pxTimer->xAutoReload != pdFALSE )
+    {
+        pxTimer->xExpiryTime += pxTimer->xPeriod;
+        prvInsertTimer( pxTimer );
+    }
+
+    pxTimer->pxCallbackFunction( pxTimer );
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvGetTicksToNextWork( TickType_t xTimeNow )
+{
+    TickType_t xOffset;
+
+    if( uxActiveTimers == 0 )
+    {
+        return portMAX_DELAY;
+    }
+
+    /* Look for the next slot of the finest wheel that contains a timer, but do
+     * not look past the point at which the finest wheel wraps, as a cascade is
+     * due then. */
+    for( xOffset = 0; xOffset < timerwheelSLOTS; xOffset++ )
+    {
+        if( ( ( ( xWheelTime + xOffset ) & timerwheelSLOT_MASK ) == 0 ) ||
+            ( listLIST_IS_EMPTY( &( xWheels[ 0 ][ ( xWheelTime + xOffset ) & timerwheelSLOT_MASK ] ) ) == pdFALSE ) )
+        {
+            break;
+        }
+    }
+
+    return ( xWheelTime + xOffset ) - xTimeNow;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,220 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+/*
+ * A software timer service that keeps active timers in a hierarchical timing
+ * wheel.
+ *
+ * The kernel's timer service task keeps active timers in a list sorted by
+ * expiry time, so starting, resetting or changing the period of a timer takes
+ * time proportional to the number of active timers.  That does not matter for
+ * the handful of timers used in Example013 to Example015, but does when an
+ * application has thousands of timers, such as a timeout for every connection.
+ *
+ * This service provides the same API, with the same semantics, but keeps active
+ * timers in timerwheelLEVELS wheels of timerwheelSLOTS slots each.  A timer that
+ * expires within timerwheelSLOTS ticks is placed in the slot of the first wheel
+ * that corresponds to its expiry tick.  Timers that expire further in the future
+ * are placed in a slot of a coarser wheel, each slot of which covers
+ * timerwheelSLOTS times as many ticks as a slot of the wheel below it, and are
+ * moved down a wheel ("cascaded") when the time covered by their slot is
+ * reached.  Starting, stopping and resetting a timer is therefore an insertion
+ * into or removal from a slot's list, which takes the same time however many
+ * timers are active.  The service task processes each tick in turn, which takes
+ * constant time plus the time taken to move or expire the timers in the slots
+ * concerned.  Timers that expire more than timerwheelSLOTS to the power of
+ * timerwheelLEVELS ticks in the future are cascaded back into the coarsest wheel
+ * until they are close enough to be placed.
+ *
+ * As with the kernel's timers, the API functions send commands to the service
+ * task, and callbacks execute in the context of the service task, so must not
+ * block.  xTimerWheelServiceStart() must be called before the scheduler is
+ * started.
+ *
+ * Unlike the kernel's timers, commands are not sent on a queue.  Each timer
+ * holds at most one pending command, and timers with a pending command are
+ * kept in a list that the service task is notified to process.  A command sent
+ * to a timer that already has a command pending updates the pending command in
+ * place, so a burst of resets to the same timer, such as those sent on every
+ * key press in Example015, costs the service task one command however long the
+ * burst, and sending a command never fails or blocks.  Pending commands are
+ * combined so the result is the same as processing them in order: a pending
+ * change of period is kept if the timer is then started, reset or stopped.
+ *
+ * Each timer can be given a slack with vTimerWheelSetSlack(), which allows its
+ * callback to execute up to that many ticks after its expiry time.  The timer
+ * is placed in the slot of the coarsest power of two boundary that falls
+ * within its slack, so periodic timers that expire at close but different
+ * times are expired on the same tick, and the service task wakes once for
+ * them all rather than once for each.  Each expiry is still relative to the
+ * time the timer should have expired, so auto-reload timers do not drift.
+ * Fewer wake-ups mean less time spent switching to the service task and, when
+ * configUSE_TICKLESS_IDLE is used, longer periods in which the tick can be
+ * suppressed.  A timer has no slack unless one is set.
+ *
+ * Setting timerwheelREPLACE_KERNEL_TIMERS to 1 in FreeRTOSConfig.h maps the
+ * kernel's software timer API onto this service in every file that includes
+ * this header, so an existing application can switch to the timing wheel by
+ * including timer_wheel.h in place of timers.h and starting the service.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The number of bits of the expiry time used to index each wheel, and so the
+ * number of slots in each wheel, and the number of wheels.  Can be overridden in
+ * FreeRTOSConfig.h. */
+#ifndef timerwheelSLOT_BITS
+    #define timerwheelSLOT_BITS           6
+#endif
+
+#ifndef timerwheelLEVELS
+    #define timerwheelLEVELS              4
+#endif
+
+#define timerwheelSLOTS                   ( 1UL << timerwheelSLOT_BITS )
+
+/* Set to 1 in FreeRTOSConfig.h to map the kernel's software timer API onto the
+ * timing wheel. */
+#ifndef timerwheelREPLACE_KERNEL_TIMERS
+    #define timerwheelREPLACE_KERNEL_TIMERS    0
+#endif
+
+typedef struct TimerWheelTimer * TimerWheelHandle_t;
+
+typedef void ( * TimerWheelCallbackFunction_t )( TimerWheelHandle_t xTimer );
+
+/* Counts of the commands sent to the service. */
+typedef struct TimerWheelStats
+{
+    uint32_t ulCommandsSent;      /* Calls to the API functions that send a command. */
+    uint32_t ulCommandsCoalesced; /* Commands that updated a pending command in place. */
+    UBaseType_t uxMaxPending;     /* Most timers that have had a command pending at once. */
+    uint32_t ulWakeups;           /* Times the service task has left the Blocked state. */
+    uint32_t ulExpiryTicks;       /* Ticks on which at least one timer expired. */
+    uint32_t ulSlackedExpiries;   /* Expiries moved to a later tick by the timer's slack. */
+} TimerWheelStats_t;
+
+/*
+ * Create the service task, at priority uxPriority.
+ * Returns pdFAIL if there was insufficient heap memory.
+ */
+BaseType_t xTimerWheelServiceStart( UBaseType_t uxPriority );
+
+/*
+ * The equivalents of xTimerCreate(), xTimerStart(), xTimerStop(),
+ * xTimerReset(), xTimerChangePeriod() and xTimerDelete(), and their interrupt
+ * safe versions.  Sending a command never blocks, so xTicksToWait is ignored
+ * and the functions always return pdPASS.
+ */
+TimerWheelHandle_t xTimerWheelCreate( const char * const pcTimerName,
+                                      const TickType_t xTimerPeriodInTicks,
+                                      const BaseType_t xAutoReload,
+                                      void * const pvTimerID,
+                                      TimerWheelCallbackFunction_t pxCallbackFunction );
+BaseType_t xTimerWheelStart( TimerWheelHandle_t xTimer,
+                             TickType_t xTicksToWait );
+BaseType_t xTimerWheelStop( TimerWheelHandle_t xTimer,
+                            TickType_t xTicksToWait );
+BaseType_t xTimerWheelReset( TimerWheelHandle_t xTimer,
+                             TickType_t xTicksToWait );
+BaseType_t xTimerWheelChangePeriod( TimerWheelHandle_t xTimer,
+                                    TickType_t xNewPeriod,
+                                    TickType_t xTicksToWait );
+BaseType_t xTimerWheelDelete( TimerWheelHandle_t xTimer,
+                              TickType_t xTicksToWait );
+BaseType_t xTimerWheelStartFromISR( TimerWheelHandle_t xTimer,
+                                    BaseType_t * pxHigherPriorityTaskWoken );
+BaseType_t xTimerWheelStopFromISR( TimerWheelHandle_t xTimer,
+                                   BaseType_t * pxHigherPriorityTaskWoken );
+BaseType_t xTimerWheelResetFromISR( TimerWheelHandle_t xTimer,
+                                    BaseType_t * pxHigherPriorityTaskWoken );
+BaseType_t xTimerWheelChangePeriodFromISR( TimerWheelHandle_t xTimer,
+                                           TickType_t xNewPeriod,
+                                           BaseType_t * pxHigherPriorityTaskWoken );
+
+/*
+ * The equivalents of pvTimerGetTimerID(), vTimerSetTimerID(),
+ * xTimerIsTimerActive(), xTimerGetPeriod() and pcTimerGetName().
+ */
+void * pvTimerWheelGetTimerID( TimerWheelHandle_t xTimer );
+void vTimerWheelSetTimerID( TimerWheelHandle_t xTimer,
+                            void * pvNewID );
+BaseType_t xTimerWheelIsTimerActive( TimerWheelHandle_t xTimer );
+TickType_t xTimerWheelGetPeriod( TimerWheelHandle_t xTimer );
+const char * pcTimerWheelGetName( TimerWheelHandle_t xTimer );
+
+/*
+ * Allow xTimer's callback to execute up to xSlack ticks after the timer
+ * expires, so its expiry can be coalesced with those of other timers.  Takes
+ * effect the next time the timer is started, reset or reloaded.
+ */
+void vTimerWheelSetSlack( TimerWheelHandle_t xTimer,
+                          TickType_t xSlack );
+TickType_t xTimerWheelGetSlack( TimerWheelHandle_t xTimer );
+
+/*
+ * Copy out the counts of commands sent to, and work done by, the service so
+ * far.
+ */
+void vTimerWheelGetStats( TimerWheelStats_t * pxStats );
+
+/*
+ * Set the most timers that have had a command pending at once to the number
+ * that have one pending now, so the high water mark can be measured over a new
+ * interval.  The counts are not affected.
+ */
+void vTimerWheelResetMaxPending( void );
+
+#if ( timerwheelREPLACE_KERNEL_TIMERS == 1 )
+
+/* Include the kernel's declarations first, so they are not affected by the
+ * macros below if timers.h is included again. */
+    #include "timers.h"
+
+    #undef xTimerStart
+    #undef xTimerStop
+    #undef xTimerReset
+    #undef xTimerChangePeriod
+    #undef xTimerDelete
+    #undef xTimerStartFromISR
+    #undef xTimerStopFromISR
+    #undef xTimerResetFromISR
+    #undef xTimerChangePeriodFromISR
+
+    #define TimerHandle_t               TimerWheelHandle_t
+    #define TimerCallbackFunction_t     TimerWheelCallbackFunction_t
+    #define xTimerCreate                xTimerWheelCreate
+    #define xTimerStart                 xTimerWheelStart
+    #define xTimerStop                  xTimerWheelStop
+    #define xTimerReset                 xTimerWheelReset
+    #define xTimerChangePeriod          xTimerWheelChangePeriod
+    #define xTimerDelete                xTimerWheelDelete
+    #define xTimerStartFromISR          xTimerWheelStartFromISR
+    #define xTimerStopFromISR           xTimerWheelStopFromISR
+    #define xTimerResetFromISR          xTimerWheelResetFromISR
+    #define xTimerChangePeriodFromISR   xTimerWheelChangePeriodFromISR
+    #define pvTimerGetTimerID           pvTimerWheelGetTimerID
+    #define vTimerSetTimerID            vTimerWheelSetTimerID
+    #define xTimerIsTimerActive         xTimerWheelIsTimerActive
+    #define xTimerGetPeriod             xTimerWheelGetPeriod
+    #define pcTimerGetName              pcTimerWheelGetName
+
+#endif /* timerwheelREPLACE_KERNEL_TIMERS */
+
+#endif /* TIMER_WHEEL_H */
@@ -0,0 +1,218 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef TYPED_QUEUE_HPP
+#define TYPED_QUEUE_HPP
+
+/*
+ * Typed C++ wrappers for FreeRTOS queues.
+ *
+ * The queue API is untyped - items are passed as void pointers, and nothing
+ * checks that the item size given when a queue is created matches the type of
+ * the variables later sent to and received from it.  Queue<T, N> is a queue of
+ * N items of type T.  The item size and length are compile time constants, the
+ * storage is part of the object itself so is allocated with
+ * xQueueCreateStatic() rather than from the FreeRTOS heap, and only variables of
+ * type T can be sent or received.  Queues copy items byte by byte, so T must be
+ * trivially copyable - a static_assert rejects other types.
+ *
+ * Types that cannot be copied, such as those that own memory, can instead be
+ * passed by pointer using Channel<T, N>, which is a queue of pointers to T that
+ * transfers ownership of each item from the sender to the receiver as a
+ * std::unique_ptr<T>.  Items are only ever moved, never copied, so T can be a
+ * move only type.
+ *
+ * The kernel copies items into and out of the queue storage itself, so the
+ * wrappers do not change how items are copied.  For items no bigger than a few
+ * words that copy is a small fraction of the time taken by a send or receive,
+ * as Example041 demonstrates.
+ *
+ * FreeRTOSConfig.h must set configSUPPORT_STATIC_ALLOCATION to 1.  Queues are
+ * created by the constructor and deleted by the destructor, and so must not be
+ * destroyed while a task is blocked on them.
+ */
+
+/* Standard includes. */
+#include <memory>
+#include <type_traits>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#if ( configSUPPORT_STATIC_ALLOCATION != 1 )
+    #error typed_queue.hpp requires configSUPPORT_STATIC_ALLOCATION to be set to 1 in FreeRTOSConfig.h
+#endif
+
+/* The length of a Channel if none is specified.  Can be overridden in
+ * FreeRTOSConfig.h. */
+#ifndef typedqueueDEFAULT_CHANNEL_LENGTH
+    #define typedqueueDEFAULT_CHANNEL_LENGTH    8
+#endif
+
+namespace FreeRTOS
+{
+    template< typename T, UBaseType_t N >
+    class Queue
+    {
+        static_assert( std::is_trivially_copyable< T >::value, "Queue items are copied byte by byte, so must be trivially copyable - use Channel for other types." );
+        static_assert( N > 0, "A queue must be able to hold at least one item." );
+
+        public:
+
+            Queue()
+            {
+                xQueue = xQueueCreateStatic( N, sizeof( T ), ucStorage, &xQueueBuffer );
+                configASSERT( xQueue != NULL );
+            }
+
+            ~Queue()
+            {
+                vQueueDelete( xQueue );
+            }
+
+            /* The queue handle refers to storage inside the object, so the
+             * object cannot be copied or moved. */
+            Queue( const Queue & ) = delete;
+            Queue & operator=( const Queue & ) = delete;
+
+            bool send( const T & xItem,
+                       TickType_t xTicksToWait = 0 )
+            {
+                return xQueueSendToBack( xQueue, &xItem, xTicksToWait ) == pdPASS;
+            }
+
+            bool sendToFront( const T & xItem,
+                              TickType_t xTicksToWait = 0 )
+            {
+                return xQueueSendToFront( xQueue, &xItem, xTicksToWait ) == pdPASS;
+            }
+
+            bool overwrite( const T & xItem )
+            {
+                static_assert( N == 1, "Only a queue of length one can be overwritten." );
+                return xQueueOverwrite( xQueue, &xItem ) == pdPASS;
+            }
+
+            bool sendFromISR( const T & xItem,
+                              BaseType_t * pxHigherPriorityTaskWoken )
+            {
+                return xQueueSendToBackFromISR( xQueue, &xItem, pxHigherPriorityTaskWoken ) == pdPASS;
+            }
+
+            bool receive( T & xItem,
+                          TickType_t xTicksToWait = portMAX_DELAY )
+            {
+                return xQueueReceive( xQueue, &xItem, xTicksToWait ) == pdPASS;
+            }
+
+            bool receiveFromISR( T & xItem,
+                                 BaseType_t * pxHigherPriorityTaskWoken )
+            {
+                return xQueueReceiveFromISR( xQueue, &xItem, pxHigherPriorityTaskWoken ) == pdPASS;
+            }
+
+            bool peek( T & xItem,
+                       TickType_t xTicksToWait = portMAX_DELAY )
+            {
+                return xQueuePeek( xQueue, &xItem, xTicksToWait ) == pdPASS;
+            }
+
+            UBaseType_t messagesWaiting() const
+            {
+                return uxQueueMessagesWaiting( xQueue );
+            }
+
+            /* For use with the parts of the C API that are not wrapped, such as
+             * queue sets and the queue registry. */
+            QueueHandle_t handle() const
+            {
+                return xQueue;
+            }
+
+        private:
+
+            StaticQueue_t xQueueBuffer;
+            alignas( T ) uint8_t ucStorage[ N * sizeof( T ) ];
+            QueueHandle_t xQueue;
+    };
+
+    template< typename T, UBaseType_t N = typedqueueDEFAULT_CHANNEL_LENGTH >
+    class Channel
+    {
+        public:
+
+            Channel() = default;
+
+            ~Channel()
+            {
+                T * pxItem;
+
+                /* Delete any items that were sent but never received. */
+                while( xPointers.receive( pxItem, 0 ) )
+                {
+                    delete pxItem;
+                }
+            }
+
+            Channel( const Channel & ) = delete;
+            Channel & operator=( const Channel & ) = delete;
+
+            /* Ownership of the item only passes to the channel if the send
+             * succeeds.  If the send fails the caller still owns the item. */
+            bool send( std::unique_ptr< T > && pxItem,
+                       TickType_t xTicksToWait = 0 )
+            {
+                T * pxRawItem = pxItem.get();
+                bool xSent = xPointers.send( pxRawItem, xTicksToWait );
+
+                if( xSent )
+                {
+                    ( void ) pxItem.release();
+                }
+
+                return xSent;
+            }
+
+            bool receive( std::unique_ptr< T > & pxItem,
+                          TickType_t xTicksToWait = portMAX_DELAY )
+            {
+                T * pxRawItem;
+                bool xReceived = xPointers.receive( pxRawItem, xTicksToWait );
+
+                if( xReceived )
+                {
+                    pxItem.reset( pxRawItem );
+                }
+
+                return xReceived;
+            }
+
+            UBaseType_t messagesWaiting() const
+            {
+                return xPointers.messagesWaiting();
+            }
+
+            QueueHandle_t handle() const
+            {
+                return xPointers.handle();
+            }
+
+        private:
+
+            Queue< T *, N > xPointers;
+    };
+}
+
+#endif /* TYPED_QUEUE_HPP */
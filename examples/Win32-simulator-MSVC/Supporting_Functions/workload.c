@@ -0,0 +1,364 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+/*
+ * Synthetic CPU load generator.  See workload.h for a description.
+ */
+
+/* Standard includes. */
+#include <math.h>
+#include <string.h>
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "benchmark_timer.h"
+#include "workload.h"
+
+/* Calibration keeps doubling the number of iterations it times until a run
+ * takes at least this long, then repeats the run workloadCALIBRATION_RUNS times
+ * and keeps the fastest rate, which is the one least disturbed by anything else
+ * that was running. */
+#define workloadCALIBRATION_MIN_NS    2000000ULL
+#define workloadCALIBRATION_RUNS      3
+
+/* The stack size of each workload task. */
+#define workloadTASK_STACK_SIZE       1000
+
+/* The state of one workload. */
+typedef struct Workload
+{
+    WorkloadParameters_t xParameters;
+    uint8_t * pucBuffer;
+    size_t xOffset;             /* The next buffer offset accessed by the sequential and strided patterns. */
+    uint32_t ulBurstRandom;     /* Generator state for burst lengths. */
+    uint32_t ulMemoryRandom;    /* Generator state for the random access pattern. */
+    uint32_t ulIterationsPerMs; /* Set by calibration. */
+    TickType_t xPeriodTicks;
+    WorkloadStats_t xStats;
+} Workload_t;
+
+/* Return the next value from a xorshift pseudo random number generator. */
+static uint32_t prvRandom( uint32_t * pulState );
+
+/* Perform ulIterations iterations of the workload's work loop. */
+static void prvDoWork( Workload_t * pxWorkload,
+                       uint32_t ulIterations );
+
+/* Measure the number of work loop iterations that execute per millisecond. */
+static uint32_t prvCalibrate( Workload_t * pxWorkload );
+
+/* Return the length of the next burst of work, in microseconds. */
+static uint32_t prvNextBurstUs( Workload_t * pxWorkload );
+
+/* The task that implements each workload. */
+static void prvWorkloadTask( void * pvParameters );
+
+/*-----------------------------------------------------------*/
+
+/* The result of the work loop is written here so the compiler cannot optimise
+ * the work away. */
+static volatile uint32_t ulWorkResult = 0;
+
+/*-----------------------------------------------------------*/
+
+WorkloadHandle_t xWorkloadCreate( const WorkloadParameters_t * pxParameters )
+{
+    Workload_t * pxWorkload;
+
+    configASSERT( pxParameters != NULL );
+    configASSERT( pxParameters->ulSeed != 0UL );
+    configASSERT( pxParameters->ulDutyCyclePercent <= 100UL );
+
+    pxWorkload = ( Workload_t * ) pvPortMalloc( sizeof( Workload_t ) );
+
+    if( pxWorkload != NULL )
+    {
+        memset( pxWorkload, 0x00, sizeof( Workload_t ) );
+        pxWorkload->xParameters = *pxParameters;
+        pxWorkload->ulBurstRandom = pxParameters->ulSeed;
+        pxWorkload->ulMemoryRandom = pxParameters->ulSeed ^ 0x5A5A5A5AUL;
+        pxWorkload->xPeriodTicks = ( TickType_t ) ( ( ( uint64_t ) pxParameters->ulPeriodUs * configTICK_RATE_HZ ) / 1000000ULL );
+
+        /* The task is periodic, so its period cannot be shorter than a tick. */
+        configASSERT( pxWorkload->xPeriodTicks > 0 );
+
+        if( pxParameters->eMemoryPattern != eWorkloadMemoryNone )
+        {
+            configASSERT( pxParameters->xMemorySize > 0 );
+            configASSERT( ( pxParameters->eMemoryPattern != eWorkloadMemoryStrided ) ||
+                          ( ( pxParameters->xMemoryStride > 0 ) && ( pxParameters->xMemoryStride < pxParameters->xMemorySize ) ) );
+
+            pxWorkload->pucBuffer = ( uint8_t * ) pvPortMalloc( pxParameters->xMemorySize );
+
+            if( pxWorkload->pucBuffer == NULL )
+            {
+                vPortFree( pxWorkload );
+                return NULL;
+            }
+
+            memset( pxWorkload->pucBuffer, 0x00, pxParameters->xMemorySize );
+        }
+
+        pxWorkload->ulIterationsPerMs = prvCalibrate( pxWorkload );
+
+        if( xTaskCreate( prvWorkloadTask, pxParameters->pcName, workloadTASK_STACK_SIZE, pxWorkload, pxParameters->uxPriority, NULL ) != pdPASS )
+        {
+            vPortFree( pxWorkload->pucBuffer );
+            vPortFree( pxWorkload );
+            pxWorkload = NULL;
+        }
+    }
+
+    return pxWorkload;
+}
+/*-----------------------------------------------------------*/
+
+void vWorkloadGetStats( WorkloadHandle_t xWorkload,
+                        WorkloadStats_t * pxStats )
+{
+    configASSERT( xWorkload != NULL );
+
+    taskENTER_CRITICAL();
+    {
+        *pxStats = xWorkload->xStats;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vWorkloadSetDutyCycle( WorkloadHandle_t xWorkload,
+                            uint32_t ulDutyCyclePercent )
+{
+    configASSERT( xWorkload != NULL );
+    configASSERT( ulDutyCyclePercent <= 100UL );
+
+    taskENTER_CRITICAL();
+    {
+        xWorkload->xParameters.ulDutyCyclePercent = ulDutyCyclePercent;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulWorkloadGetIterationsPerMs( WorkloadHandle_t xWorkload )
+{
+    configASSERT( xWorkload != NULL );
+    return xWorkload->ulIterationsPerMs;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkloadTask( void * pvParameters )
+{
+    Workload_t * pxWorkload = ( Workload_t * ) pvParameters;
+    TickType_t xLastWakeTime;
+    uint64_t ullWakeTime;
+    uint32_t ulBurstUs, ulResponseUs;
+    BaseType_t xDeadlineMissed;
+
+    xLastWakeTime = xTaskGetTickCount();
+
+    for( ; ; )
+    {
+        ullWakeTime = ullBenchmarkTimerGetNanoseconds();
+
+        /* Perform this period's burst of work. */
+        ulBurstUs = prvNextBurstUs( pxWorkload );
+        prvDoWork( pxWorkload, ( uint32_t ) ( ( ( uint64_t ) ulBurstUs * pxWorkload->ulIterationsPerMs ) / 1000ULL ) );
+
+        /* The response time is measured from when the task left the Blocked
+         * state.  The deadline is missed if the burst did not complete before
+         * the task was due to start its next period. */
+        ulResponseUs = ( uint32_t ) ( ( ullBenchmarkTimerGetNanoseconds() - ullWakeTime ) / 1000ULL );
+        xDeadlineMissed = ( ( xTaskGetTickCount() - xLastWakeTime ) >= pxWorkload->xPeriodTicks );
+
+        taskENTER_CRITICAL();
+        {
+            pxWorkload->xStats.ulActivations++;
+            pxWorkload->xStats.ullRequestedWorkUs += ulBurstUs;
+
+            if( ulResponseUs > pxWorkload->xStats.ulMaxResponseUs )
+            {
+                pxWorkload->xStats.ulMaxResponseUs = ulResponseUs;
+            }
+
+            if( xDeadlineMissed != pdFALSE )
+            {
+                pxWorkload->xStats.ulDeadlineMisses++;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        vTaskDelayUntil( &xLastWakeTime, pxWorkload->xPeriodTicks );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvDoWork( Workload_t * pxWorkload,
+                       uint32_t ulIterations )
+{
+    const WorkloadMemoryPattern_t ePattern = pxWorkload->xParameters.eMemoryPattern;
+    const size_t xSize = pxWorkload->xParameters.xMemorySize;
+    const size_t xStride = pxWorkload->xParameters.xMemoryStride;
+    uint8_t * const pucBuffer = pxWorkload->pucBuffer;
+    size_t xOffset = pxWorkload->xOffset;
+    uint32_t ulAccumulator = 0, ul;
+
+    for( ul = 0; ul < ulIterations; ul++ )
+    {
+        /* Every pattern does a little arithmetic, then all but one touch the
+         * buffer. */
+        ulAccumulator = ( ulAccumulator * 1664525UL ) + 1013904223UL;
+
+        switch( ePattern )
+        {
+            case eWorkloadMemorySequential:
+                pucBuffer[ xOffset ] += ( uint8_t ) ulAccumulator;
+                xOffset++;
+
+                if( xOffset >= xSize )
+                {
+                    xOffset = 0;
+                }
+
+                break;
+
+            case eWorkloadMemoryStrided:
+                pucBuffer[ xOffset ] += ( uint8_t ) ulAccumulator;
+                xOffset += xStride;
+
+                if( xOffset >= xSize )
+                {
+                    xOffset -= xSize;
+                }
+
+                break;
+
+            case eWorkloadMemoryRandom:
+                pucBuffer[ prvRandom( &( pxWorkload->ulMemoryRandom ) ) % xSize ] += ( uint8_t ) ulAccumulator;
+                break;
+
+            case eWorkloadMemoryNone:
+            default:
+                break;
+        }
+    }
+
+    pxWorkload->xOffset = xOffset;
+    ulWorkResult += ulAccumulator;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvCalibrate( Workload_t * pxWorkload )
+{
+    uint32_t ulIterations = 1000UL, ulRate, ulBestRate = 0UL;
+    uint64_t ullStartTime, ullElapsed;
+    BaseType_t xRun;
+
+    /* Find a number of iterations that takes long enough to time accurately. */
+    for( ; ; )
+    {
+        ullStartTime = ullBenchmarkTimerGetNanoseconds();
+        prvDoWork( pxWorkload, ulIterations );
+        ullElapsed = ullBenchmarkTimerGetNanoseconds() - ullStartTime;
+
+        if( ullElapsed >= workloadCALIBRATION_MIN_NS )
+        {
+            break;
+        }
+
+        ulIterations *= 2UL;
+    }
+
+    for( xRun = 0; xRun < workloadCALIBRATION_RUNS; xRun++ )
+    {
+        ullStartTime = ullBenchmarkTimerGetNanoseconds();
+        prvDoWork( pxWorkload, ulIterations );
+        ullElapsed = ullBenchmarkTimerGetNanoseconds() - ullStartTime;
+
+        ulRate = ( uint32_t ) ( ( ( uint64_t ) ulIterations * 1000000ULL ) / ullElapsed );
+
+        if( ulRate > ulBestRate )
+        {
+            ulBestRate = ulRate;
+        }
+    }
+
+    return ulBestRate;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvNextBurstUs( Workload_t * pxWorkload )
+{
+    const uint32_t ulPeriodUs = pxWorkload->xParameters.ulPeriodUs;
+    const uint32_t ulMeanUs = ( uint32_t ) ( ( ( uint64_t ) ulPeriodUs * pxWorkload->xParameters.ulDutyCyclePercent ) / 100ULL );
+    uint32_t ulBurstUs;
+    double dUniform;
+
+    switch( pxWorkload->xParameters.eBurstDistribution )
+    {
+        case eWorkloadBurstUniform:
+            ulBurstUs = prvRandom( &( pxWorkload->ulBurstRandom ) ) % ( ( 2UL * ulMeanUs ) + 1UL );
+            break;
+
+        case eWorkloadBurstExponential:
+            /* Inverse transform sampling, using a uniform value in (0, 1]. */
+            dUniform = ( ( double ) prvRandom( &( pxWorkload->ulBurstRandom ) ) + 1.0 ) / 4294967296.0;
+            ulBurstUs = ( uint32_t ) ( -( double ) ulMeanUs * log( dUniform ) );
+            break;
+
+        case eWorkloadBurstBimodal:
+            /* Nine in ten bursts are half the mean, one in ten is 5.5 times the
+             * mean, giving the requested mean overall. */
+            if( ( prvRandom( &( pxWorkload->ulBurstRandom ) ) % 10UL ) == 0UL )
+            {
+                ulBurstUs = ( ulMeanUs * 11UL ) / 2UL;
+            }
+            else
+            {
+                ulBurstUs = ulMeanUs / 2UL;
+            }
+
+            break;
+
+        case eWorkloadBurstFixed:
+        default:
+            ulBurstUs = ulMeanUs;
+            break;
+    }
+
+    /* A single burst can never need more than the whole period. */
+    if( ulBurstUs > ulPeriodUs )
+    {
+        ulBurstUs = ulPeriodUs;
+    }
+
+    return ulBurstUs;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( uint32_t * pulState )
+{
+    uint32_t ulState = *pulState;
+
+    ulState ^= ulState << 13;
+    ulState ^= ulState >> 17;
+    ulState ^= ulState << 5;
+    *pulState = ulState;
+
+    return ulState;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,116 @@
+/*
+ *  Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+ *
+ *  SPDX-License-Identifier: MIT-0
+ *
+ *  VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+ *
+ *  This file is part of the FreeRTOS distribution.
+ *
+ *  This contains the Windows port implementation of the examples listed in the
+ *  FreeRTOS book Mastering_the_FreeRTOS_Real_Time_Kernel.
+ *
+ */
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+/*
+ * Synthetic CPU load generator.
+ *
+ * Example001 generates load with an empty for() loop of fixed length, which
+ * takes a different amount of time on every target and bears no resemblance
+ * to real processing.  Each workload created by this module is a periodic task
+ * that, in each period, performs a burst of work whose length is drawn from a
+ * configurable distribution with a configurable mean duty cycle.  The work
+ * itself reads and writes a private buffer using a configurable access pattern,
+ * so it loads the cache and memory system as well as the CPU.
+ *
+ * The number of loop iterations that execute per millisecond is calibrated
+ * against the benchmark timer when the workload is created, so a burst of work
+ * represents a fixed amount of CPU time irrespective of how fast the target is,
+ * and irrespective of how often the task is preempted while performing it.
+ * Pseudo random numbers come from a private generator seeded from the workload
+ * parameters, so a given set of parameters always generates the same sequence
+ * of bursts.
+ *
+ * vBenchmarkTimerInit() must have been called before a workload is created.
+ */
+
+/* FreeRTOS.org includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* How the length of each burst of work is chosen.  Whatever the distribution,
+ * no burst is longer than one period. */
+typedef enum
+{
+    eWorkloadBurstFixed = 0,   /* Every burst is the mean length. */
+    eWorkloadBurstUniform,     /* Uniformly distributed between 0 and twice the mean. */
+    eWorkloadBurstExponential, /* Exponentially distributed. */
+    eWorkloadBurstBimodal      /* Mostly short bursts, with one in ten eleven times longer. */
+} WorkloadBurstDistribution_t;
+
+/* How the work accesses the workload's buffer. */
+typedef enum
+{
+    eWorkloadMemoryNone = 0, /* The work does not access memory. */
+    eWorkloadMemorySequential,
+    eWorkloadMemoryStrided,  /* Each access is xMemoryStride bytes after the last. */
+    eWorkloadMemoryRandom
+} WorkloadMemoryPattern_t;
+
+/* The parameters of one workload. */
+typedef struct WorkloadParameters
+{
+    const char * pcName;
+    UBaseType_t uxPriority;
+    uint32_t ulPeriodUs;
+    uint32_t ulDutyCyclePercent; /* Mean CPU time per period, as a percentage of the period. */
+    WorkloadBurstDistribution_t eBurstDistribution;
+    WorkloadMemoryPattern_t eMemoryPattern;
+    size_t xMemorySize;          /* Size of the buffer, ignored if eMemoryPattern is eWorkloadMemoryNone. */
+    size_t xMemoryStride;        /* Only used if eMemoryPattern is eWorkloadMemoryStrided. */
+    uint32_t ulSeed;             /* Seed for the pseudo random number generator, must not be 0. */
+} WorkloadParameters_t;
+
+/* Statistics gathered by each workload. */
+typedef struct WorkloadStats
+{
+    uint32_t ulActivations;      /* Number of bursts performed. */
+    uint32_t ulDeadlineMisses;   /* Bursts that had not completed by the start of the next period. */
+    uint32_t ulMaxResponseUs;    /* Longest time from the task leaving the Blocked state to the end of its burst. */
+    uint64_t ullRequestedWorkUs; /* Total CPU time requested by all the bursts. */
+} WorkloadStats_t;
+
+typedef struct Workload * WorkloadHandle_t;
+
+/*
+ * Calibrate and create a workload.  Calibration takes a few milliseconds, and
+ * is only accurate if nothing else runs in the meantime, so workloads should
+ * be created before the scheduler is started or from the highest priority
+ * task.  Returns NULL if there was insufficient heap memory.
+ */
+WorkloadHandle_t xWorkloadCreate( const WorkloadParameters_t * pxParameters );
+
+/*
+ * Copy out the statistics gathered by a workload so far.
+ */
+void vWorkloadGetStats( WorkloadHandle_t xWorkload,
+                        WorkloadStats_t * pxStats );
+
+/*
+ * Change the mean CPU time requested in each period, as a percentage of the
+ * period, so the load can be varied while the application runs.  Takes effect
+ * from the workload's next burst.  A workload with a duty cycle of 0 still
+ * leaves the Blocked state once per period, but performs no work.
+ */
+void vWorkloadSetDutyCycle( WorkloadHandle_t xWorkload,
+                            uint32_t ulDutyCyclePercent );
+
+/*
+ * Return the calibrated number of loop iterations per millisecond.
+ */
+uint32_t ulWorkloadGetIterationsPerMs( WorkloadHandle_t xWorkload );
+
+#endif /* WORKLOAD_H */